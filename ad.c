@@ -2,11 +2,129 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdio.h>
+#include <threads.h>
 
 #include "utils.h"
 #include "ad.h"
+#include "at.h"
+#include "gc.h"
 
-Domain *symTable=NULL;
+_Thread_local Domain *symTable=NULL;
+_Thread_local Symbol *lastVisibleGlobal=NULL;
+
+// the canonical types, indexed by their ids
+// they are stored in chunks which never move, so the types can be read without the lock (typeOf) while other threads add new ones
+// chunk k has TYPE_CHUNK0<<k types, so TYPE_CHUNKS chunks are enough for all the ids
+#define TYPE_CHUNK0 16
+#define TYPE_CHUNKS 28
+Type *typeChunks[TYPE_CHUNKS];
+int nTypes;
+
+// a hash table with the ids of the canonical types, for typeIntern
+// it uses linear probing and it is kept at most half full
+TypeId *typesHash;
+int typesHashCap;
+
+// serializes typeIntern, which is called by the threads that check the function bodies in parallel
+static mtx_t typesLock;
+
+static unsigned typeHash(Type *t) {
+    size_t h = (size_t)t->tb * 31u + (size_t)t->s;
+    h = h * 31u + (size_t)(unsigned)t->n;
+    return (unsigned)(h ^ (h >> 16));
+}
+
+static bool sameType(Type *a, Type *b) {
+    return a->tb == b->tb && a->s == b->s && a->n == b->n;
+}
+
+// the chunk of the type id: the first TYPE_CHUNK0 ids are in chunk 0, the next 2*TYPE_CHUNK0 in chunk 1, ...
+static unsigned typeChunk(TypeId id) {
+    unsigned n = (unsigned)id / TYPE_CHUNK0 + 1, k = 0;
+    while (n >>= 1) k++;
+    return k;
+}
+
+static Type *typeSlot(TypeId id) {
+    unsigned k = typeChunk(id);
+    return &typeChunks[k][id - TYPE_CHUNK0 * ((1u << k) - 1)];
+}
+
+static void hashInsert(TypeId id) {
+    unsigned i = typeHash(typeSlot(id)) & (typesHashCap - 1);
+    while (typesHash[i] >= 0) i = (i + 1) & (typesHashCap - 1);
+    typesHash[i] = id;
+}
+
+// initTypes: This function creates the types table and adds the predefined types, in the order of their ids.
+void initTypes() {
+    if (mtx_init(&typesLock, mtx_plain) != thrd_success) err("cannot create the types lock");
+    typesHashCap = 64;
+    typesHash = (TypeId*)safeAlloc(typesHashCap * sizeof(TypeId));
+    for (int i = 0; i < typesHashCap; i++) typesHash[i] = -1;
+    initTypeTables();
+    typeIntern(&(Type){TB_INT, NULL, -1});
+    typeIntern(&(Type){TB_DOUBLE, NULL, -1});
+    typeIntern(&(Type){TB_CHAR, NULL, -1});
+    typeIntern(&(Type){TB_VOID, NULL, -1});
+    typeIntern(&(Type){TB_CHAR, NULL, 0});
+}
+
+static void growTypesHash(int cap) {
+    free(typesHash);
+    typesHashCap = cap;
+    typesHash = (TypeId*)safeAlloc(typesHashCap * sizeof(TypeId));
+    for (int i = 0; i < typesHashCap; i++) typesHash[i] = -1;
+    for (TypeId i = 0; i < nTypes; i++) hashInsert(i);
+}
+
+// typeIntern: This function returns the id of the canonical type equal to t.
+// If there is no such type, it adds a copy of t to the types table.
+static TypeId internLocked(Type *t) {
+    for (unsigned i = typeHash(t) & (typesHashCap - 1); typesHash[i] >= 0; i = (i + 1) & (typesHashCap - 1)) {
+        if (sameType(typeSlot(typesHash[i]), t)) return typesHash[i];
+    }
+    TypeId id = nTypes;
+    unsigned k = typeChunk(id);
+    // a new chunk is added after the previous one is full; the old chunks remain where they are
+    if (!typeChunks[k]) typeChunks[k] = (Type*)safeAlloc(((size_t)TYPE_CHUNK0 << k) * sizeof(Type));
+    *typeSlot(id) = *t;
+    nTypes++;
+    if (nTypes * 2 > typesHashCap) {
+        growTypesHash(typesHashCap * 2);
+    } else {
+        hashInsert(id);
+    }
+    return id;
+}
+
+TypeId typeIntern(Type *t) {
+    if (t->tb != TB_STRUCT) t->s = NULL; // s is not set by typeBase for the other bases
+    mtx_lock(&typesLock);
+    TypeId id = internLocked(t);
+    mtx_unlock(&typesLock);
+    return id;
+}
+
+// resetTypes: This function removes all the types added after the predefined ones.
+// Their chunks are kept for the next types.
+void resetTypes() {
+    mtx_lock(&typesLock);
+    nTypes = TID_STRING + 1;
+    for (int i = 0; i < typesHashCap; i++) typesHash[i] = -1;
+    for (TypeId i = 0; i < nTypes; i++) hashInsert(i);
+    mtx_unlock(&typesLock);
+}
+
+// typeOf: This function returns the canonical type with the given id.
+Type *typeOf(TypeId id) {
+    return typeSlot(id);
+}
+
+// typesCount: This function returns the number of types from the types table.
+int typesCount() {
+    return nTypes;
+}
 
 // typeBaseSize: This function returns the size in bytes of a type base (e.g., int, double, char, void).
 // For structures, it calculates the total size by summing the sizes of its members.
@@ -19,7 +137,7 @@ int typeBaseSize(Type *t) {
         default: { // TB_STRUCT
             int size = 0;
             for (Symbol *m = t->s->structMembers; m; m = m->next) {
-                size += typeSize(&m->type);
+                size += typeSize(typeOf(m->type));
             }
             return size;
         }
@@ -34,19 +152,10 @@ int typeSize(Type *t) {
     return t->n * typeBaseSize(t);
 }
 
-// freeSymbols: This function frees a list of symbols from memory.
-// It iterates over the list and calls freeSymbol on each symbol.
-void freeSymbols(Symbol *list) {
-    for (Symbol *next; list; list = next) {
-        next = list->next;
-        freeSymbol(list);
-    }
-}
-
 // newSymbol: This function creates a new symbol with the given name and kind (e.g., variable, function, struct).
 // It initializes the symbol's fields and returns a pointer to the new symbol.
 Symbol *newSymbol(const char *name, SymKind kind) {
-    Symbol *s = (Symbol*)safeAlloc(sizeof(Symbol));
+    Symbol *s = (Symbol*)arenaAlloc(&symTable->arena, sizeof(Symbol));
     memset(s, 0, sizeof(Symbol)); // sets all the fields to 0/NULL
     s->name = name;
     s->kind = kind;
@@ -55,8 +164,8 @@ Symbol *newSymbol(const char *name, SymKind kind) {
 
 // dupSymbol: This function duplicates a symbol by creating a new symbol and copying the fields from the original symbol.
 // The next pointer is set to NULL to ensure it's a standalone symbol.
-Symbol *dupSymbol(Symbol *symbol) {
-    Symbol *s = (Symbol*)safeAlloc(sizeof(Symbol));
+Symbol *dupSymbol(Arena *arena, Symbol *symbol) {
+    Symbol *s = (Symbol*)arenaAlloc(arena, sizeof(Symbol));
     *s = *symbol;
     s->next = NULL;
     return s;
@@ -82,41 +191,55 @@ int symbolsLen(Symbol *list) {
     return n;
 }
 
-// freeSymbol: This function frees a single symbol from memory.
-// It handles different kinds of symbols (variables, functions, structs) and frees associated memory accordingly.
-void freeSymbol(Symbol *s) {
-    switch (s->kind) {
-        case SK_VAR:
-            if (!s->owner) free(s->varMem);
-            break;
-        case SK_FN:
-            freeSymbols(s->fn.params);
-            freeSymbols(s->fn.locals);
-            break;
-        case SK_STRUCT:
-            freeSymbols(s->structMembers);
-            break;
-    }
-    free(s);
-}
+// the domains dropped by the current thread, linked by parent, which are reused by pushDomain
+static _Thread_local Domain *freeDomains;
 
 // pushDomain: This function creates a new domain, sets it as the current symbol table (symTable),
 // and returns a pointer to the new domain. The new domain’s parent is set to the previous current domain.
+// A domain dropped before is reused if there is one, so its arena already has a chunk.
 Domain *pushDomain() {
-    Domain *d = (Domain*)safeAlloc(sizeof(Domain));
+    Domain *d = freeDomains;
+    if (d) {
+        freeDomains = d->parent;
+    } else {
+        d = (Domain*)safeAlloc(sizeof(Domain));
+        d->arena = (Arena){NULL, NULL, NULL};
+    }
     d->symbols = NULL;
     d->parent = symTable;
     symTable = d;
     return d;
 }
 
-// dropDomain: This function removes the current domain from the symbol table,
-// frees its symbols, and sets the parent domain as the current domain.
+// dropDomain: This function removes the current domain from the symbol table and releases its symbols with its arena.
+// The functions are only in the global domain, so only there the symbols are visited, to free the code and the locals of each function.
 void dropDomain() {
     Domain *d = symTable;
     symTable = d->parent;
-    freeSymbols(d->symbols);
-    free(d);
+    if (!d->parent) {
+        for (Symbol *s = d->symbols; s; s = s->next) {
+            if (s->kind == SK_FN) {
+                freeInstrs(s->fn.instr);
+                arenaFree(&s->fn.arena);
+            }
+        }
+        arenaFree(&d->arena);
+        free(d);
+        trimDomains();
+        return;
+    }
+    arenaReset(&d->arena);
+    d->parent = freeDomains;
+    freeDomains = d;
+}
+
+// trimDomains: This function frees the domains kept for reuse by the current thread.
+void trimDomains() {
+    for (Domain *next; freeDomains; freeDomains = next) {
+        next = freeDomains->parent;
+        arenaFree(&freeDomains->arena);
+        free(freeDomains);
+    }
 }
 
 // showNamedType: This function prints a type with its name.
@@ -140,19 +263,19 @@ void showNamedType(Type *t, const char *name) {
 void showSymbol(Symbol *s) {
     switch (s->kind) {
         case SK_VAR:
-            showNamedType(&s->type, s->name);
+            showNamedType(typeOf(s->type), s->name);
             if (s->owner) {
-                printf(";\t// size=%d, idx=%d\n", typeSize(&s->type), s->varIdx);
+                printf(";\t// size=%d, idx=%d\n", typeSize(typeOf(s->type)), s->varIdx);
             } else {
-                printf(";\t// size=%d, mem=%p\n", typeSize(&s->type), s->varMem);
+                printf(";\t// size=%d, mem=%p\n", typeSize(typeOf(s->type)), s->varMem);
             }
             break;
         case SK_PARAM:
-            showNamedType(&s->type, s->name);
-            printf(" /*size=%d, idx=%d*/", typeSize(&s->type), s->paramIdx);
+            showNamedType(typeOf(s->type), s->name);
+            printf(" /*size=%d, idx=%d*/", typeSize(typeOf(s->type)), s->paramIdx);
             break;
         case SK_FN:
-            showNamedType(&s->type, s->name);
+            showNamedType(typeOf(s->type), s->name);
             printf("(");
             bool next = false;
             for (Symbol *param = s->fn.params; param; param = param->next) {
@@ -173,7 +296,7 @@ void showSymbol(Symbol *s) {
                 printf("\t");
                 showSymbol(m);
             }
-            printf("};\t// size=%d\n", typeSize(&s->type));
+            printf("};\t// size=%d\n", typeSize(typeOf(s->type)));
             break;
     }
 }
@@ -190,9 +313,11 @@ void showDomain(Domain *d, const char *name) {
 
 // findSymbolInDomain: This function searches for a symbol by name within a specific domain
 // and returns a pointer to the symbol if found, or NULL if not found.
+// In the global domain, the search stops after lastVisibleGlobal, if it is set.
 Symbol *findSymbolInDomain(Domain *d, const char *name) {
     for (Symbol *s = d->symbols; s; s = s->next) {
         if (!strcmp(s->name, name)) return s;
+        if (s == lastVisibleGlobal && !d->parent) break;
     }
     return NULL;
 }
@@ -215,7 +340,7 @@ Symbol *addSymbolToDomain(Domain *d, Symbol *s) {
 
 // addExtFn: This function adds an external function to the current domain.
 // It creates a new function symbol, sets its return type and external function pointer, and adds it to the current domain.
-Symbol *addExtFn(const char *name, void (*extFnPtr)(), Type ret) {
+Symbol *addExtFn(const char *name, void (*extFnPtr)(), TypeId ret) {
     Symbol *fn = newSymbol(name, SK_FN);
     fn->fn.extFnPtr = extFnPtr;
     fn->type = ret;
@@ -224,11 +349,11 @@ Symbol *addExtFn(const char *name, void (*extFnPtr)(), Type ret) {
 }
 
 // addFnParam: This function adds a parameter to a function symbol.
-// It creates a new parameter symbol, sets its type and index, duplicates it, and adds it to the function's parameter list.
-Symbol *addFnParam(Symbol *fn, const char *name, Type type) {
+// It creates a new parameter symbol, sets its type and index, and adds it to the function's parameter list.
+Symbol *addFnParam(Symbol *fn, const char *name, TypeId type) {
     Symbol *param = newSymbol(name, SK_PARAM);
     param->type = type;
     param->paramIdx = symbolsLen(fn->fn.params);
-    addSymbolToList(&fn->fn.params, dupSymbol(param));
-    return param;
+    gcAddToFrame(fn, param);
+    return addSymbolToList(&fn->fn.params, param);
 }
@@ -1,6 +1,8 @@
 #pragma once
 
-//#include "vm.h"
+#include <stdbool.h>
+#include "vm.h"
+#include "utils.h"
 
 // the domain analysis
 
@@ -24,6 +26,38 @@ typedef struct{		// the type of a symbol
 // returns the size of type t in bytes
 int typeSize(Type *t);
 
+// the canonical types
+// each distinct type (base, struct, dimension) is stored only once in the types table
+// and it is referred by its index in that table (its id), so two types are equal only if their ids are equal
+typedef int TypeId;
+
+// the ids of the predefined types, which are always in the types table
+enum{TID_INT,TID_DOUBLE,TID_CHAR,TID_VOID,TID_STRING};	// TID_STRING is char[]
+
+// creates the types table with the predefined types
+// it must be called before any other use of the types
+void initTypes();
+// returns the id of the canonical type equal to t, adding t to the types table if it is not there
+// it can be called concurrently, while other threads read the types with typeOf
+TypeId typeIntern(Type *t);
+// removes all the types, except the predefined ones
+// it is used when all the symbols are dropped (ex: the language server checks again all the documents)
+void resetTypes();
+// returns the canonical type with the given id
+// the returned pointer remains valid for the entire program
+Type *typeOf(TypeId id);
+// the number of the types from the types table (the ids are in the range 0..nTypes-1)
+int typesCount();
+
+// the layout of a function's frame on the VM stack
+// the parameters are below the return address and the saved FP, and the locals are after the saved FP
+// the sizes are in bytes and they are multiples of align
+typedef struct{
+	int paramsSize;		// the size of all the parameters
+	int localsSize;		// the size of all the locals, including the ones from the inner domains
+	int align;		// the alignment of each variable: a variable starts in a new VM stack slot
+	}FrameLayout;
+
 typedef enum{		// symbol's kind
 	SK_VAR,SK_PARAM,SK_FN,SK_STRUCT
 	}SymKind;
@@ -31,7 +65,7 @@ typedef enum{		// symbol's kind
 struct Symbol{
 	const char *name;		// symbol's name. The symbol doesn't own this pointer, but it is allocated somewhere else (ex: in Token)
 	SymKind kind;
-	Type type;
+	TypeId type;		// a canonical type
 
 	// owner:
 	//		- NULL for global symbols
@@ -39,6 +73,10 @@ struct Symbol{
 	//		- a function for parameters/variables local to that function
 	Symbol *owner;
 	Symbol *next;		// the link to the next symbol in list
+	// for local variables and parameters: the byte offset in the locals or parameters area of the owner's frame
+	int frameOffset;
+	// for a struct parameter: its slot holds the address of the argument, which the function only reads (see elideCopies)
+	bool byRef;
 	union{		// specific data fo each kind of symbol
 		// the index in fn.locals for local vars
 		// the index in struct for struct members
@@ -52,36 +90,52 @@ struct Symbol{
 		struct{
 			Symbol *params;		// the parameters of a function
 			Symbol *locals;		// all local vars of a function, including the ones from its inner domains
+			Arena arena;		// the arena of fn.locals, so the locals can be dropped when the body is checked again
 			void(*extFnPtr)();		// !=NULL for extern functions
-			//Instr *instr;		// used if extFnPtr==NULL
+			Instr *instr;		// used if extFnPtr==NULL
+			FrameLayout frame;		// computed when the parameters and the locals are added
+			bool prototype;		// only declared, by a prototype: its definition is later or in another unit (see linkProgram)
+			// the last global symbol visible in the body: the function itself, or the last symbol before its definition if it has
+			// a prototype, because its symbol is at its prototype
+			Symbol *lastVisible;
 			}fn;
 		};
 	};
 
-// dynamically allocation of a new symbol
+// allocates a new symbol in the arena of the current domain, to which it must be added
 Symbol *newSymbol(const char *name,SymKind kind);
-// duplicates the given symbol
-Symbol *dupSymbol(Symbol *symbol);
+// duplicates the given symbol in the arena
+// the copies owned by a function or by a struct are placed in arenas which live as long as their owner:
+// the parameters and the members in the arena of the domain which contains the owner, and the locals in fn.arena
+Symbol *dupSymbol(Arena *arena,Symbol *symbol);
 // adds the symbol the the end of the list
 // list - the address of the list where to add the symbol
 Symbol *addSymbolToList(Symbol **list,Symbol *s);
 // the number of the symbols in list
 int symbolsLen(Symbol *list);
-// frees the memory of a symbol
-void freeSymbol(Symbol *s);
 
 typedef struct _Domain{
 	struct _Domain *parent;		// the parent domain
 	Symbol *symbols;		// the symbols from this domain (single linked list)
+	Arena arena;		// the symbols of the domain are allocated here and they are released together with it
 	}Domain;
 
 // the current domain (the top of the domains's stack)
-extern Domain *symTable;
+// each thread has its own stack: the threads which check the function bodies in parallel start it from the global domain
+extern _Thread_local Domain *symTable;
+// if set, the global symbols after it are not visible to findSymbol
+// it is used to check a function body after all the globals are declared, seeing only the globals defined before that function
+extern _Thread_local Symbol *lastVisibleGlobal;
 
 // adds a domain to the top of the domains's stack
 Domain *pushDomain();
 // deletes the domain from the top of the domains's stack
+// its symbols are released at once, with its arena; only the global domain can have functions, whose code is freed separately
+// the dropped inner domains are kept by the thread for reuse, with a chunk of their arenas
 void dropDomain();
+// frees the domains kept for reuse by the current thread
+// it is called when the global domain is dropped, and by the threads which end while the global domain is used
+void trimDomains();
 // shows the content of the given domain
 void showDomain(Domain *d,const char *name);
 // search a symbol with the given name in the specified domain and returns it
@@ -93,9 +147,9 @@ Symbol *findSymbol(const char *name);
 Symbol *addSymbolToDomain(Domain *d,Symbol *s);
 
 // add in ST an extern function with the given name, address and return type
-Symbol *addExtFn(const char *name,void(*extFnPtr)(),Type ret);
+Symbol *addExtFn(const char *name,void(*extFnPtr)(),TypeId ret);
 
 // add to fn a parameter with the given name and type
 // it doesn't verify for parameter redefinition
 // returns the added parameter
-Symbol *addFnParam(Symbol *fn,const char *name,Type type);
+Symbol *addFnParam(Symbol *fn,const char *name,TypeId type);
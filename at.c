@@ -1,14 +1,53 @@
 #include <string.h>
+#include <stdlib.h>
+#include <stdint.h>
 #include "at.h"
+#include "utils.h"
+
+// the rules of the type analysis depend only on the type base and on whether the type is an array, so their results
+// are precomputed for these type classes instead of the canonical types, whose number grows with the program
+// (each array dimension is a new type); the structs differ only by their identity, which is their type id
+enum{TC_INT,TC_DOUBLE,TC_CHAR,TC_VOID,TC_STRUCT,TC_ARRAY,TC_COUNT};	// TC_INT..TC_STRUCT have the values of their TB_*
+
+// scalarTab[c] - true if the class c is scalar
+// convTab[src][dst] - true if src can be converted to dst (for two structs, only if they are the same)
+// arithTab[c1][c2] - the type of c1 op c2, or -1 if c1 and c2 cannot be arithmetic operands
+// (the result is always a predefined type, so it fits in a byte)
+static bool scalarTab[TC_COUNT];
+static bool convTab[TC_COUNT][TC_COUNT];
+static int8_t arithTab[TC_COUNT][TC_COUNT];
+
+static int typeClass(TypeId id){
+	Type *t=typeOf(id);
+	return t->n>=0?TC_ARRAY:(int)t->tb;
+	}
 
 bool canBeScalar(Ret* r){
-	Type* t=&r->type;
+	return scalarTab[typeClass(r->type)];
+	}
+
+bool convTo(TypeId src,TypeId dst){
+	int cSrc=typeClass(src),cDst=typeClass(dst);
+	if(cSrc==TC_STRUCT&&cDst==TC_STRUCT)return src==dst;
+	return convTab[cSrc][cDst];
+	}
+
+bool arithTypeTo(TypeId t1,TypeId t2,TypeId *dst){
+	TypeId t=arithTab[typeClass(t1)][typeClass(t2)];
+	if(t<0)return false;
+	*dst=t;
+	return true;
+	}
+
+// the rules from which the tables are computed
+
+static bool scalarRule(Type *t){
 	if(t->n>=0)return false;
 	if(t->tb==TB_VOID)return false;
 	return true;
 	}
 
-bool convTo(Type *src,Type *dst){
+static bool convRule(Type *src,Type *dst){
 	// the pointers (arrays) can be converted one to another, but in nothing else
 	if(src->n>=0){
 		if(dst->n>=0)return true;
@@ -34,38 +73,49 @@ bool convTo(Type *src,Type *dst){
 		}
 	}
 
-bool arithTypeTo(Type *t1,Type *t2,Type *dst){
+static TypeId arithRule(Type *t1,Type *t2){
 	// there are no arithmetic operations with pointers
-	if(t1->n>=0||t2->n>=0)return false;
-	// the result of an arithmetic operation cannot be poinetr or struct
-	dst->s=NULL;
-	dst->n=-1;
+	if(t1->n>=0||t2->n>=0)return -1;
+	// the result of an arithmetic operation cannot be pointer or struct
 	switch(t1->tb){
 		case TB_INT:
 			switch(t2->tb){
 				case TB_INT:
 				case TB_CHAR:
-					dst->tb=TB_INT;return true;
-				case TB_DOUBLE:dst->tb=TB_DOUBLE;return true;
-				default:return false;
+					return TID_INT;
+				case TB_DOUBLE:return TID_DOUBLE;
+				default:return -1;
 				}
 		case TB_DOUBLE:
 			switch(t2->tb){
 				case TB_INT:
 				case TB_DOUBLE:
 				case TB_CHAR:
-					dst->tb=TB_DOUBLE;return true;
-				default:return false;
+					return TID_DOUBLE;
+				default:return -1;
 				}
 		case TB_CHAR:
 			switch(t2->tb){
-				case TB_INT:
-				case TB_DOUBLE:
-				case TB_CHAR:
-					dst->tb=t2->tb;return true;
-				default:return false;
+				case TB_INT:return TID_INT;
+				case TB_DOUBLE:return TID_DOUBLE;
+				case TB_CHAR:return TID_CHAR;
+				default:return -1;
 				}
-		default:return false;
+		default:return -1;
+		}
+	}
+
+void initTypeTables(){
+	// a type of each class; its struct is not set, so all the structs seem the same struct (see convTo)
+	Type classTypes[TC_COUNT]={
+		{TB_INT,NULL,-1},{TB_DOUBLE,NULL,-1},{TB_CHAR,NULL,-1},{TB_VOID,NULL,-1},{TB_STRUCT,NULL,-1},{TB_CHAR,NULL,0}
+		};
+	for(int c=0;c<TC_COUNT;c++){
+		scalarTab[c]=scalarRule(&classTypes[c]);
+		for(int o=0;o<TC_COUNT;o++){
+			convTab[c][o]=convRule(&classTypes[c],&classTypes[o]);
+			arithTab[c][o]=(int8_t)arithRule(&classTypes[c],&classTypes[o]);
+			}
 		}
 	}
 
@@ -6,7 +6,7 @@
 #include "ad.h"
 
 typedef struct{
-	Type type;		// the returned type
+	TypeId type;		// the returned type
 	bool lval;			// true if left-value
 	bool ct;				// true if constant
 	}Ret;
@@ -17,13 +17,18 @@ bool canBeScalar(Ret* r);
 
 // verifies if the source type can be converted to the destination type
 // if yes, returns true
-bool convTo(Type *src,Type *dst);
+bool convTo(TypeId src,TypeId dst);
 
 // sets in dst the resulted type of an arithmetic operation
 // having as operands the types t1 and t2
 // returns true if t1 and t2 can be operands for an arithmetic operation
 // ex: double + int -> double
-bool arithTypeTo(Type *t1,Type *t2,Type *dst);
+bool arithTypeTo(TypeId t1,TypeId t2,TypeId *dst);
+
+// the results of canBeScalar, convTo and arithTypeTo are precomputed for a few classes of types,
+// so each check is only a table access
+// computes these tables (called by initTypes)
+void initTypeTables();
 
 // searches a name in a list of symbols
 // if it finds it, returns the correspondent symbol, else NULL
@@ -0,0 +1,146 @@
+// gen: generates the inputs of the benchmarks (see run.sh)
+//		gen literals N		N int and double literals, 10 on each line
+//		gen program N		a program with N functions, 12 lines each
+//		gen lsp-body N		a language server session: the program with N functions, and edits inside the function bodies
+//		gen lsp-decl N		the same program, with edits of a global declaration, which check again the whole program
+// the output is written to stdout and it is always the same for the same arguments
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdbool.h>
+
+// a fixed pseudo-random sequence (xorshift64), so the inputs are the same on all the machines
+static uint64_t rndState=88172645463325252ULL;
+
+static uint32_t rnd(uint32_t n){
+	rndState^=rndState<<13;
+	rndState^=rndState>>7;
+	rndState^=rndState<<17;
+	return (uint32_t)(rndState%n);
+	}
+
+// the usual forms of the literals: ints, fractions, exponents and a few long ones which need the slow path
+static void literal(){
+	switch(rnd(8)){
+		case 0:case 1:case 2:printf("%u",rnd(100000));break;
+		case 3:printf("%u",rnd(2000000000));break;
+		case 4:printf("%u.%u",rnd(1000),rnd(100000));break;
+		case 5:printf("%u.%03ue%s%u",rnd(10),rnd(1000),rnd(2)?"-":"",rnd(20));break;
+		case 6:printf("0.%06u",rnd(1000000));break;
+		case 7:
+			if(rnd(100))printf("%u.%u",rnd(100),rnd(10));
+			else printf("%u%09u%09u.%09u",rnd(1000),rnd(1000000000),rnd(1000000000),rnd(1000000000));
+			break;
+		}
+	}
+
+static void genLiterals(int n){
+	for(int i=0;i<n;i++){
+		literal();
+		putchar(i%10==9?'\n':' ');
+		}
+	}
+
+// a growing text, for the messages of the language server, which start with their length
+typedef struct{
+	char *s;
+	size_t n,cap;
+	}Text;
+
+static void textAdd(Text *t,const char *fmt,...){
+	for(;;){
+		va_list va;
+		va_start(va,fmt);
+		int n=vsnprintf(t->s+t->n,t->cap-t->n,fmt,va);
+		va_end(va);
+		if(t->n+n<t->cap){
+			t->n+=n;
+			return;
+			}
+		t->cap=(t->n+n+1)*2;
+		t->s=(char*)realloc(t->s,t->cap);
+		if(!t->s){
+			fprintf(stderr,"gen: not enough memory\n");
+			exit(1);
+			}
+		}
+	}
+
+static void sendMessage(Text *msg){
+	printf("Content-Length: %zu\r\n\r\n%s",msg->n,msg->s);
+	msg->n=0;
+	}
+
+// the lines of the program (starting from 0, as in the language server protocol):
+// the global declaration is on line 4, and the line "k=0;" of the function i is on line 9+12*i
+#define LSP_FN_LINES 12
+#define LSP_EDITS 200
+
+// a program with n functions of LSP_FN_LINES lines, which call each other
+static void programText(Text *src,int n){
+	textAdd(src,"struct S{\n  int a;\n  double b;\n};\nint G[10];\n");
+	for(int i=0;i<n;i++){
+		textAdd(src,"double f%d(int n){\n  struct S v[%d];\n  char c[%d];\n  int k;\n  k=0;\n  while(k<n){\n",i,i%6+2,i%5+3);
+		textAdd(src,"    v[k-k/2*2].a=k+%d;\n    c[k-k/3*3]=(char)k;\n    k=k+1;\n  }\n",i);
+		if(i)textAdd(src,"  return (double)v[1].a+c[0]+f%d(n);\n}\n",i-1);
+		else textAdd(src,"  return (double)v[1].a+c[0];\n}\n");
+		}
+	textAdd(src,"void main(){ puti((int)f%d(3)); }\n",n-1);
+	}
+
+static void genProgram(int n){
+	Text src={NULL,0,0};
+	programText(&src,n);
+	fputs(src.s,stdout);
+	free(src.s);
+	}
+
+static void genLsp(int n,bool body){
+	Text src={NULL,0,0},text={NULL,0,0},msg={NULL,0,0};
+	programText(&src,n);
+	// the program is a JSON string: it has no quotes or backslashes, only its newlines are escaped
+	for(const char *p=src.s;*p;p++){
+		if(*p=='\n')textAdd(&text,"\\n");
+		else textAdd(&text,"%c",*p);
+		}
+	textAdd(&msg,"{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"initialize\",\"params\":{}}");
+	sendMessage(&msg);
+	textAdd(&msg,"{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didOpen\",\"params\":{\"textDocument\":{\"uri\":\"file:///bench.c\",\"text\":\"%s\"}}}",text.s);
+	sendMessage(&msg);
+	// each edit inserts a space: in the body of a function, after the indentation of "k=0;", or in "int G[10];"
+	for(int e=0;e<LSP_EDITS;e++){
+		int line=body?9+LSP_FN_LINES*(e*37%n):4;
+		int column=body?2:4;
+		textAdd(&msg,"{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/didChange\",\"params\":{\"textDocument\":{\"uri\":\"file:///bench.c\"},"
+			"\"contentChanges\":[{\"range\":{\"start\":{\"line\":%d,\"character\":%d},\"end\":{\"line\":%d,\"character\":%d}},\"text\":\" \"}]}}",
+			line,column,line,column);
+		sendMessage(&msg);
+		}
+	textAdd(&msg,"{\"jsonrpc\":\"2.0\",\"id\":2,\"method\":\"shutdown\"}");
+	sendMessage(&msg);
+	textAdd(&msg,"{\"jsonrpc\":\"2.0\",\"method\":\"exit\"}");
+	sendMessage(&msg);
+	free(src.s);
+	free(text.s);
+	free(msg.s);
+	}
+
+int main(int argc,char **argv){
+	if(argc!=3){
+		fprintf(stderr,"usage: gen literals|program|lsp-body|lsp-decl N\n");
+		return 1;
+		}
+	int n=atoi(argv[2]);
+	if(!strcmp(argv[1],"literals"))genLiterals(n);
+	else if(!strcmp(argv[1],"program"))genProgram(n);
+	else if(!strcmp(argv[1],"lsp-body"))genLsp(n,true);
+	else if(!strcmp(argv[1],"lsp-decl"))genLsp(n,false);
+	else{
+		fprintf(stderr,"gen: unknown input %s\n",argv[1]);
+		return 1;
+		}
+	return 0;
+	}
@@ -0,0 +1,38 @@
+// lexbench: the time of tokenize on a file, the best of several runs
+//		lexbench file [runs]
+// it uses only tokenize and loadFile, so it can be built with the lexer of any revision (see run.sh)
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "lexer.h"
+#include "utils.h"
+
+static double wallSeconds(){
+	struct timespec ts;
+	timespec_get(&ts,TIME_UTC);
+	return (double)ts.tv_sec+ts.tv_nsec*1e-9;
+	}
+
+int main(int argc,char **argv){
+	if(argc<2){
+		fprintf(stderr,"usage: lexbench file [runs]\n");
+		return 1;
+		}
+	int runs=argc>2?atoi(argv[2]):5;
+	char *src=loadFile(argv[1]);
+	double best=0;
+	int nTokens=0;
+	// the tokens of each run are kept, so the runs do not reuse the freed memory of the previous ones
+	for(int r=0;r<runs;r++){
+		double start=wallSeconds();
+		Token *tokens=tokenize(src);
+		double t=wallSeconds()-start;
+		if(!r||t<best)best=t;
+		// an old lexer appends the tokens of each run to the same list, so only the first run is counted
+		if(!r)for(Token *tk=tokens;tk;tk=tk->next)nTokens++;
+		}
+	printf("%s: %d tokens, tokenize %.2f ms (best of %d)\n",argv[1],nTokens,best*1e3,runs);
+	free(src);
+	return 0;
+	}
@@ -0,0 +1,42 @@
+// the register allocation benchmark: recursive calls, which save and restore the registers they use
+int fib(int n){
+	if(n<2)return n;
+	return fib(n-1)+fib(n-2);
+	}
+
+int ack(int m,int n){
+	if(m==0)return n+1;
+	if(n==0)return ack(m-1,1);
+	return ack(m-1,ack(m,n-1));
+	}
+
+double harmonic(int n,double acc){
+	if(n==0)return acc;
+	return harmonic(n-1,acc+1.0/n);
+	}
+
+// a loop around the recursive call: its values are live across the call
+int tree(int d){
+	int i;
+	int s;
+	if(d==0)return 1;
+	s=0;
+	i=0;
+	while(i<3){
+		s=s+tree(d-1)+i;
+		i=i+1;
+		}
+	return s;
+	}
+
+int main(){
+	puti(fib(20));
+	putc(' ');
+	puti(ack(2,300));
+	putc(' ');
+	puti(harmonic(1000,0.0)*1000);
+	putc(' ');
+	puti(tree(8));
+	putc(10);
+	return 0;
+	}
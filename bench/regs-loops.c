@@ -0,0 +1,44 @@
+// the register allocation benchmark: nested loops with several int and double values live at once
+int v[100];
+double w[100];
+
+int main(){
+	int i;
+	int j;
+	int s;
+	int t;
+	double d;
+	double e;
+	i=0;
+	while(i<100){
+		v[i]=i*7-300;
+		w[i]=i*0.5;
+		i=i+1;
+		}
+	s=0;
+	t=0;
+	d=0.0;
+	e=1.0;
+	i=0;
+	while(i<200){
+		j=0;
+		while(j<100){
+			if(v[j]>s/1000){
+				s=s+v[j]-t;
+				d=d+w[j]*e;
+				}else{
+				t=t+1;
+				e=e*1.0001;
+				}
+			j=j+1;
+			}
+		i=i+1;
+		}
+	puti(s);
+	putc(' ');
+	puti(t);
+	putc(' ');
+	puti(d);
+	putc(10);
+	return 0;
+	}
@@ -0,0 +1,56 @@
+#!/bin/sh
+# runs the benchmarks, from the repository's directory:
+#		bench/run.sh [src]
+# src is the directory with the sources of the measured compiler (default: the current one)
+# an older revision is measured with the same inputs from a checkout of it, ex:
+#		git worktree add /tmp/old <rev> && bench/run.sh /tmp/old
+# the inputs and the programs are built in $BENCH_DIR (default: /tmp/atomc-bench)
+set -e
+src=${1:-.}
+out=${BENCH_DIR:-/tmp/atomc-bench}
+cc=${CC:-gcc}
+flags="-std=c11 -O2"
+mkdir -p "$out"
+$cc $flags -o "$out/gen" bench/gen.c
+$cc $flags -I"$src" -o "$out/lexbench" bench/lexbench.c "$src/lexer.c" "$src/utils.c" -lm
+
+echo "# numeric literals: tokenize only"
+"$out/gen" literals 1600000 > "$out/literals.txt"
+"$out/lexbench" "$out/literals.txt"
+
+# the lexer: tokenize only, on generated programs of 12,000 and 144,000 lines, and on tests/testlex.c repeated 200 times
+echo "# lexer: tokenize only"
+"$out/gen" program 1000 > "$out/program1000.c"
+"$out/gen" program 12000 > "$out/program12000.c"
+for i in $(seq 200); do cat tests/testlex.c; done > "$out/testlex200.c"
+for f in program1000.c program12000.c testlex200.c; do
+	"$out/lexbench" "$out/$f"
+done
+
+# the register allocation: the executed VM instructions, counted by a VM built with -DVM_COUNT_OPS
+# the frame accesses (FPLOAD, FPSTORE) are replaced by the register accesses (RLOAD, RSTORE)
+$cc $flags -pthread -DVM_COUNT_OPS -o "$out/countops" "$src"/*.c -lm
+for p in regs-loops regs-calls; do
+	echo "# $p.c: executed instructions"
+	"$out/countops" --quiet bench/$p.c 2>&1 >/dev/null | grep -E "^(FPLOAD|FPSTORE|RLOAD|RSTORE|total)"
+done
+
+# the language server: the time from a didChange to its diagnostics, for a program with 1000 functions (12,000 lines)
+$cc $flags -pthread -o "$out/main" "$src"/*.c -lm
+for edits in body decl; do
+	echo "# language server: edits in the $edits"
+	"$out/gen" lsp-$edits 1000 > "$out/lsp-$edits.txt"
+	"$out/main" --lsp < "$out/lsp-$edits.txt" 2>&1 >/dev/null | grep -v "^// language server"
+done
+
+# the copy elision: the struct copies (PUSH_STRUCT) and the instructions executed by bench/struct-args.c, and its run time
+echo "# struct-args.c: executed instructions and run time"
+"$out/countops" --quiet bench/struct-args.c 2>&1 >/dev/null | grep -E "^(PUSH_STRUCT|COPY|total)"
+best=
+for i in 1 2 3 4 5; do
+	start=$(date +%s%N)
+	"$out/main" --quiet bench/struct-args.c > /dev/null
+	ms=$(( ($(date +%s%N) - start) / 1000000 ))
+	if [ -z "$best" ] || [ $ms -lt $best ]; then best=$ms; fi
+done
+echo "run time: $best ms (the best of 5 runs)"
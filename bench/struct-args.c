@@ -0,0 +1,41 @@
+// the copy elision benchmark: a loop which calls functions with small struct parameters
+// dot and len only read their parameters, which are passed by reference; scale writes its copy, which is kept
+struct V{ double x; double y; double z; };
+
+double dot(struct V a,struct V b){
+	return a.x*b.x+a.y*b.y+a.z*b.z;
+	}
+
+double len2(struct V a){
+	return dot(a,a);
+	}
+
+double scale(struct V a,double k){
+	a.x=a.x*k;
+	a.y=a.y*k;
+	a.z=a.z*k;
+	return a.x+a.y+a.z;
+	}
+
+int main(){
+	struct V u;
+	struct V v;
+	int i;
+	double s;
+	u.x=1.0;
+	u.y=2.0;
+	u.z=3.0;
+	v.x=0.5;
+	v.y=0.25;
+	v.z=0.125;
+	s=0.0;
+	i=0;
+	while(i<2000000){
+		s=s+dot(u,v)+len2(v)+scale(u,0.5);
+		v.x=v.x+0.000001;
+		i=i+1;
+		}
+	puti(s);
+	putc(10);
+	return 0;
+	}
@@ -0,0 +1,437 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "elide.h"
+#include "gc.h"
+#include "utils.h"
+
+// what an address from the stack points to: the values >=0 are the indexes of the struct parameters in FnInfo
+enum{TAG_OTHER=-2,TAG_FRAME=-1};
+
+// a stack slot of the analyzed code
+typedef struct{
+	int tag;
+	Instr *producer;		// the PUSH_STRUCT which pushed the slot, or NULL
+	Instr *before;		// the instruction before producer
+	int events;		// the number of the write events of the function when the slot was pushed
+	}Slot;
+
+typedef struct{
+	Symbol *fn;
+	Symbol **params;		// the struct parameters
+	int *slots;		// the slot of each struct parameter
+	bool *written;		// true if the parameter is written or its address is passed to a call
+	int nParams;
+	bool writesMemory;		// true if fn writes outside of its frame
+	Symbol **callees;
+	int nCallees,calleesCap;
+	}FnInfo;
+
+// a struct parameter whose argument was copied before a call to writer, in the same arguments list
+// the copy cannot be removed if writer can write outside of its frame
+typedef struct{
+	Symbol *writer;
+	FnInfo *callee;
+	int param;
+	}CopyBeforeCall;
+
+typedef struct{
+	FnInfo *fns;
+	int nFns;
+	Slot *stack;
+	int sp,cap;
+	int copiesRemoved;
+	// the writes of the walked function, in their order: NULL for a store, or the function called
+	// a struct argument is copied when it is pushed, so its memory must not be written from then up to its call
+	Symbol **events;
+	int nEvents,eventsCap;
+	CopyBeforeCall *copies;
+	int nCopies,copiesCap;
+	}Elide;
+
+static FnInfo *infoOf(Elide *e,Symbol *fn){
+	for(int k=0;k<e->nFns;k++){
+		if(e->fns[k].fn==fn)return &e->fns[k];
+		}
+	return NULL;
+	}
+
+static void push(Elide *e,int tag,Instr *producer,Instr *before){
+	if(e->sp==e->cap){
+		e->cap=e->cap?e->cap*2:64;
+		e->stack=(Slot*)realloc(e->stack,e->cap*sizeof(Slot));
+		if(!e->stack)err("not enough memory");
+		}
+	e->stack[e->sp++]=(Slot){tag,producer,before,e->nEvents};
+	}
+
+static void addEvent(Elide *e,Symbol *writer){
+	// the consecutive calls of the same function are a single event
+	if(e->nEvents&&writer&&e->events[e->nEvents-1]==writer)return;
+	if(e->nEvents==e->eventsCap){
+		e->eventsCap=e->eventsCap?e->eventsCap*2:64;
+		e->events=(Symbol**)realloc(e->events,e->eventsCap*sizeof(Symbol*));
+		if(!e->events)err("not enough memory");
+		}
+	e->events[e->nEvents++]=writer;
+	}
+
+static void addCopy(Elide *e,Symbol *writer,FnInfo *callee,int param){
+	if(e->nCopies==e->copiesCap){
+		e->copiesCap=e->copiesCap?e->copiesCap*2:16;
+		e->copies=(CopyBeforeCall*)realloc(e->copies,e->copiesCap*sizeof(CopyBeforeCall));
+		if(!e->copies)err("not enough memory");
+		}
+	e->copies[e->nCopies++]=(CopyBeforeCall){writer,callee,param};
+	}
+
+// the struct arguments of a call to callee, pushed from base, must not be written between their copy and the call
+// after a store their parameters keep the copy, and after a call they keep it if that function writes the memory
+static void checkCopies(Elide *e,Symbol *callee,int base){
+	FnInfo *info=infoOf(e,callee);
+	if(!info)return;
+	for(int k=0;k<info->nParams;k++){
+		Slot *s=&e->stack[base+info->params[k]->frameOffset/(int)sizeof(Val)];
+		if(!s->producer||s->producer->op!=OP_PUSH_STRUCT)continue;
+		for(int j=s->events;j<e->nEvents&&!info->written[k];j++){
+			if(e->events[j])addCopy(e,e->events[j],info,k);
+			else info->written[k]=true;
+			}
+		}
+	}
+
+// the struct parameter whose slot is slot, or TAG_FRAME for the other variables
+static int tagOfSlot(FnInfo *info,int slot){
+	for(int k=0;k<info->nParams;k++){
+		if(info->slots[k]==slot)return k;
+		}
+	return TAG_FRAME;
+	}
+
+// the memory with the given tag is written
+static void writeTo(FnInfo *info,int tag){
+	if(tag>=0)info->written[tag]=true;
+	else if(tag==TAG_OTHER)info->writesMemory=true;
+	}
+
+static void addCallee(FnInfo *info,Symbol *callee){
+	for(int k=0;k<info->nCallees;k++){
+		if(info->callees[k]==callee)return;
+		}
+	if(info->nCallees==info->calleesCap){
+		info->calleesCap=info->calleesCap?info->calleesCap*2:8;
+		info->callees=(Symbol**)realloc(info->callees,info->calleesCap*sizeof(Symbol*));
+		if(!info->callees)err("not enough memory");
+		}
+	info->callees[info->nCallees++]=callee;
+	}
+
+// the arguments of a call are on stack: the struct arguments passed by reference were pushed with PUSH_STRUCT,
+// which is removed, so only their addresses remain
+static void removeCopies(Elide *e,Symbol *callee,int base){
+	for(Symbol *p=callee->fn.params;p;p=p->next){
+		if(!p->byRef)continue;
+		Slot *s=&e->stack[base+p->frameOffset/(int)sizeof(Val)];
+		if(!s->producer||s->producer->op!=OP_PUSH_STRUCT)err("elideCopies: the argument %s of %s is not a struct copy",p->name,callee->name);
+		s->before->next=s->producer->next;
+		free(s->producer);
+		e->copiesRemoved++;
+		}
+	}
+
+static void call(Elide *e,FnInfo *info,Instr *i,bool rewrite){
+	Symbol *callee=(Symbol*)i->arg.p;
+	int base=e->sp-paramsSlots(callee);
+	for(int k=base;k<e->sp;k++){
+		// an address passed to a function can be written by it
+		if(e->stack[k].tag>=0)info->written[e->stack[k].tag]=true;
+		}
+	if(i->op==OP_CALL){
+		addCallee(info,callee);
+		if(rewrite)removeCopies(e,callee,base);
+		else checkCopies(e,callee,base);
+		addEvent(e,callee);
+		}else{
+		// the builtins write only in their array arguments
+		for(Symbol *p=callee->fn.params;p;p=p->next){
+			if(typeOf(p->type)->n>=0){
+				writeTo(info,e->stack[base+p->frameOffset/(int)sizeof(Val)].tag);
+				addEvent(e,NULL);
+				}
+			}
+		}
+	e->sp=base;
+	if(callee->type!=TID_VOID)push(e,TAG_OTHER,NULL,NULL);
+	}
+
+// simulates the effect of i on the stack of slots
+// returns false if the code is not understood
+static bool walkInstr(Elide *e,FnInfo *info,Instr *i,Instr *before,bool rewrite){
+	int pops=0,tag=TAG_OTHER;
+	switch(i->op){
+		case OP_NOP:case OP_ENTER:case OP_JMP:case OP_RET_VOID:case OP_FPSTORE:
+			return true;
+		case OP_PUSH_I:case OP_PUSH_F:case OP_PUSH_A:case OP_FPLOAD:
+			break;
+		case OP_FPADDR:
+			tag=tagOfSlot(info,i->arg.i);
+			break;
+		case OP_DROP:case OP_JF:case OP_JT:case OP_RET:
+			if(e->sp<1)return false;
+			e->sp--;
+			return true;
+		case OP_OFFSET:case OP_CHECK:
+			return e->sp>=1;
+		case OP_INDEX:
+			if(e->sp<2)return false;
+			e->sp--;
+			return true;
+		case OP_LOAD_I:case OP_LOAD_F:case OP_LOAD_C:case OP_LOAD_A:
+		case OP_CONV_I_F:case OP_CONV_F_I:case OP_CONV_I_C:case OP_NEG_I:case OP_NEG_F:case OP_NOT_I:case OP_NOT_F:
+			pops=1;
+			break;
+		case OP_STORE_I:case OP_STORE_F:case OP_STORE_C:
+			if(e->sp<2)return false;
+			writeTo(info,e->stack[e->sp-2].tag);
+			addEvent(e,NULL);
+			pops=2;
+			break;
+		case OP_COPY:
+			if(e->sp<2)return false;
+			tag=e->stack[e->sp-2].tag;
+			writeTo(info,tag);
+			addEvent(e,NULL);
+			pops=2;
+			break;
+		case OP_PUSH_STRUCT:
+			if(e->sp<1)return false;
+			e->sp--;
+			for(int k=(i->arg.i+(int)sizeof(Val)-1)/(int)sizeof(Val);k>0;k--)push(e,TAG_OTHER,i,before);
+			return true;
+		case OP_CALL:case OP_CALL_EXT:
+			if(e->sp<paramsSlots((Symbol*)i->arg.p))return false;
+			call(e,info,i,rewrite);
+			return true;
+		default:
+			if(i->op<OP_ADD_I||i->op>OP_NOTEQ_F)return false;
+			pops=2;
+			break;
+		}
+	if(e->sp<pops)return false;
+	e->sp-=pops;
+	push(e,tag,NULL,NULL);
+	return true;
+	}
+
+static bool sameSlots(Slot *a,Slot *b,int n){
+	for(int k=0;k<n;k++){
+		if(a[k].tag!=b[k].tag||a[k].producer!=b[k].producer)return false;
+		}
+	return true;
+	}
+
+// simulates fn's code, to find which struct parameters are written and if fn writes outside of its frame
+// if rewrite is true, the struct arguments passed by reference are not copied anymore
+// returns false if the code is not understood
+static bool walkFn(Elide *e,FnInfo *info,bool rewrite){
+	InstrIndex index;
+	initInstrIndex(&index,info->fn->fn.instr);
+	// the stack at the jump targets, for the forward jumps, and the stack depth at each visited instruction
+	Slot **states=(Slot**)safeAlloc(index.n*sizeof(Slot*));
+	int *depths=(int*)safeAlloc(index.n*sizeof(int));
+	for(int k=0;k<index.n;k++){
+		states[k]=NULL;
+		depths[k]=-1;
+		}
+	bool ok=true,reachable=true;
+	e->sp=0;
+	e->nEvents=0;
+	for(int k=0;k<index.n&&ok;k++){
+		Instr *i=index.instrs[k];
+		if(states[k]){
+			if(!reachable){
+				e->sp=depths[k];
+				memcpy(e->stack,states[k],e->sp*sizeof(Slot));
+				}else if(depths[k]!=e->sp||!sameSlots(states[k],e->stack,e->sp)){
+				ok=false;
+				break;
+				}
+			}else if(!reachable){
+			continue;
+			}
+		reachable=true;
+		depths[k]=e->sp;
+		if(!walkInstr(e,info,i,k?index.instrs[k-1]:NULL,rewrite)){
+			ok=false;
+			break;
+			}
+		switch(i->op){
+			case OP_JMP:case OP_JF:case OP_JT:{
+				int t=instrIndex(&index,i->arg.instr);
+				if(t<=k){
+					// the loops are entered and repeated only between statements
+					if(depths[t]!=e->sp||e->sp)ok=false;
+					}else if(states[t]){
+					if(depths[t]!=e->sp||!sameSlots(states[t],e->stack,e->sp))ok=false;
+					}else{
+					states[t]=(Slot*)safeAlloc((e->sp+1)*sizeof(Slot));
+					memcpy(states[t],e->stack,e->sp*sizeof(Slot));
+					depths[t]=e->sp;
+					}
+				if(i->op==OP_JMP)reachable=false;
+				}break;
+			case OP_RET:case OP_RET_VOID:
+				reachable=false;
+				break;
+			default:break;
+			}
+		}
+	for(int k=0;k<index.n;k++)free(states[k]);
+	free(states);
+	free(depths);
+	freeInstrIndex(&index);
+	return ok;
+	}
+
+// changes fn's frame so each parameter passed by reference takes a single slot, with the argument's address
+// its code gets the new slots of the parameters and loads the address from the slot, instead of taking the slot's address
+static void passByRef(Symbol *fn){
+	int n=symbolsLen(fn->fn.params);
+	int *oldSlots=(int*)safeAlloc((n+1)*sizeof(int));
+	int *newSlots=(int*)safeAlloc((n+1)*sizeof(int));
+	Symbol **params=(Symbol**)safeAlloc((n+1)*sizeof(Symbol*));
+	int k=0;
+	for(Symbol *p=fn->fn.params;p;p=p->next,k++){
+		params[k]=p;
+		oldSlots[k]=varSlot(p);
+		}
+	int size=0;
+	for(Symbol *p=fn->fn.params;p;p=p->next){
+		p->frameOffset=size;
+		size+=(p->byRef?1:typeSlots(p->type))*(int)sizeof(Val);
+		}
+	fn->fn.frame.paramsSize=size;
+	for(k=0;k<n;k++)newSlots[k]=varSlot(params[k]);
+	for(Instr *i=fn->fn.instr;i;i=i->next){
+		switch(i->op){
+			case OP_FPADDR:case OP_FPLOAD:case OP_FPSTORE:
+				if(i->arg.i>=0)break;
+				for(k=0;k<n&&oldSlots[k]!=i->arg.i;k++){}
+				if(k==n)err("elideCopies: %s uses the slot %d, which is not a parameter",fn->name,i->arg.i);
+				if(params[k]->byRef)i->op=OP_FPLOAD;
+				i->arg.i=newSlots[k];
+				break;
+			case OP_RET:case OP_RET_VOID:
+				i->arg.i=paramsSlots(fn);
+				break;
+			default:break;
+			}
+		}
+	free(oldSlots);
+	free(newSlots);
+	free(params);
+	}
+
+void elideCopies(Domain *d,ElideStats *stats){
+	Elide e={NULL,0,NULL,0,0,0,NULL,0,0,NULL,0,0};
+	for(Symbol *s=d->symbols;s;s=s->next){
+		if(s->kind==SK_FN&&s->fn.instr)e.nFns++;
+		}
+	e.fns=(FnInfo*)safeAlloc((e.nFns+1)*sizeof(FnInfo));
+	e.nFns=0;
+	for(Symbol *s=d->symbols;s;s=s->next){
+		if(s->kind!=SK_FN||!s->fn.instr)continue;
+		FnInfo *info=&e.fns[e.nFns++];
+		memset(info,0,sizeof(FnInfo));
+		info->fn=s;
+		int n=symbolsLen(s->fn.params);
+		info->params=(Symbol**)safeAlloc((n+1)*sizeof(Symbol*));
+		info->slots=(int*)safeAlloc((n+1)*sizeof(int));
+		info->written=(bool*)safeAlloc((n+1)*sizeof(bool));
+		for(Symbol *p=s->fn.params;p;p=p->next){
+			Type *t=typeOf(p->type);
+			if(t->tb!=TB_STRUCT||t->n>=0)continue;
+			info->params[info->nParams]=p;
+			info->slots[info->nParams]=varSlot(p);
+			info->written[info->nParams++]=false;
+			}
+		}
+	for(int k=0;k<e.nFns;k++){
+		FnInfo *info=&e.fns[k];
+		if(!walkFn(&e,info,false)){
+			for(int j=0;j<info->nParams;j++)info->written[j]=true;
+			info->writesMemory=true;
+			// the calls from fn cannot be changed, so its callees keep their parameters
+			for(Instr *i=info->fn->fn.instr;i;i=i->next){
+				FnInfo *callee=i->op==OP_CALL?infoOf(&e,(Symbol*)i->arg.p):NULL;
+				if(callee){
+					for(int j=0;j<callee->nParams;j++)callee->written[j]=true;
+					}
+				}
+			}
+		}
+	// a function writes the memory if it calls a function which writes it
+	for(bool again=true;again;){
+		again=false;
+		for(int k=0;k<e.nFns;k++){
+			FnInfo *info=&e.fns[k];
+			for(int j=0;j<info->nCallees&&!info->writesMemory;j++){
+				FnInfo *callee=infoOf(&e,info->callees[j]);
+				if(callee&&callee->writesMemory){
+					info->writesMemory=true;
+					again=true;
+					}
+				}
+			}
+		}
+	for(int k=0;k<e.nCopies;k++){
+		CopyBeforeCall *c=&e.copies[k];
+		FnInfo *writer=infoOf(&e,c->writer);
+		if(!writer||writer->writesMemory)c->callee->written[c->param]=true;
+		}
+	int byRef=0;
+	for(int k=0;k<e.nFns;k++){
+		FnInfo *info=&e.fns[k];
+		for(int j=0;j<info->nParams;j++){
+			stats->params++;
+			if(info->written[j])stats->written++;
+			else if(info->writesMemory)stats->writesMemory++;
+			else{
+				info->params[j]->byRef=true;
+				byRef++;
+				}
+			}
+		}
+	stats->byRef+=byRef;
+	if(byRef){
+		// the calls are changed first, while the parameters still have their old slots
+		for(int k=0;k<e.nFns;k++)walkFn(&e,&e.fns[k],true);
+		for(int k=0;k<e.nFns;k++){
+			FnInfo *info=&e.fns[k];
+			for(int j=0;j<info->nParams;j++){
+				if(info->params[j]->byRef){
+					passByRef(info->fn);
+					break;
+					}
+				}
+			}
+		}
+	stats->copiesRemoved+=e.copiesRemoved;
+	for(int k=0;k<e.nFns;k++){
+		free(e.fns[k].params);
+		free(e.fns[k].slots);
+		free(e.fns[k].written);
+		free(e.fns[k].callees);
+		}
+	free(e.fns);
+	free(e.stack);
+	free(e.events);
+	free(e.copies);
+	}
+
+void showElideStats(ElideStats *stats){
+	printf("// copy elision: %d of %d struct parameters passed by reference, %d copies removed from the calls\n",stats->byRef,stats->params,stats->copiesRemoved);
+	printf("//\twritten or passed to calls: %d, in functions which write the memory: %d\n",stats->written,stats->writesMemory);
+	}
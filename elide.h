@@ -0,0 +1,25 @@
+#pragma once
+
+// the copy elision of the struct parameters, on the VM code
+// a struct parameter which its function only reads is passed by a hidden reference: its slot holds the address
+// of the argument, instead of the copy made by PUSH_STRUCT at each call
+// the argument must not change while the function runs, so the function and the functions which it calls
+// must not write any memory outside of their frames
+// the argument is copied when it is pushed, so the caller must not write the memory either while it evaluates
+// the following arguments
+
+#include "ad.h"
+
+typedef struct{
+	int params;		// the struct parameters of the functions with code
+	int byRef;		// the parameters passed by reference
+	int written;		// the parameters which are written or whose address is passed to a call
+	int writesMemory;		// the parameters of the functions which can write outside of their frames
+	int copiesRemoved;		// the PUSH_STRUCT removed from the calls
+	}ElideStats;
+
+// passes by reference the read-only struct parameters of the functions with code from domain d
+// it changes the frames and the code of these functions and all their calls, so it must run before the other
+// optimizations (inlining, IR)
+void elideCopies(Domain *d,ElideStats *stats);
+void showElideStats(ElideStats *stats);
@@ -0,0 +1,197 @@
+#include <stdlib.h>
+
+#include "gc.h"
+#include "lexer.h"
+#include "utils.h"
+
+_Thread_local Symbol *gcFn;		// the function for which code is generated (each thread generates the code of its own function)
+_Thread_local Instr *gcTail;		// the last instruction of gcFn
+_Thread_local Token *gcSrcTk;
+bool gcBoundsChecks;
+
+void gcBeginFn(Symbol *fn){
+	gcFn=fn;
+	gcTail=NULL;
+	gcAdd(OP_ENTER);
+	}
+
+void gcEndFn(){
+	if(gcFn->type==TID_VOID){
+		gcAddInt(OP_RET_VOID,paramsSlots(gcFn));
+		}else{
+		// a function which ends without return returns 0
+		if(gcFn->type==TID_DOUBLE)gcAddDouble(OP_PUSH_F,0);
+		else gcAddInt(OP_PUSH_I,0);
+		gcAddInt(OP_RET,paramsSlots(gcFn));
+		}
+	gcFn->fn.instr->arg.i=gcFn->fn.frame.localsSize/(int)sizeof(Val);
+	gcFn=NULL;
+	gcTail=NULL;
+	}
+
+Instr *gcLast(){
+	return gcTail;
+	}
+
+void gcRewind(Instr *mark){
+	delInstrAfter(mark);
+	gcTail=mark;
+	}
+
+Instr *gcAdd(Opcode op){
+	if(gcTail)gcTail=insertInstr(gcTail,op);
+	else gcTail=addInstr(&gcFn->fn.instr,op);
+	if(gcSrcTk)gcTail->line=tkLine(gcSrcTk);
+	return gcTail;
+	}
+
+Instr *gcAddInt(Opcode op,int argVal){
+	Instr *i=gcAdd(op);
+	i->arg.i=argVal;
+	return i;
+	}
+
+Instr *gcAddDouble(Opcode op,double argVal){
+	Instr *i=gcAdd(op);
+	i->arg.f=argVal;
+	return i;
+	}
+
+Instr *gcAddPtr(Opcode op,void *argVal){
+	Instr *i=gcAdd(op);
+	i->arg.p=argVal;
+	return i;
+	}
+
+Instr *gcInsert(Instr *after,Opcode op){
+	Instr *i=insertInstr(after,op);
+	if(after==gcTail)gcTail=i;
+	return i;
+	}
+
+int typeSlots(TypeId t){
+	Type *type=typeOf(t);
+	if(type->n==0)return 1;		// a pointer
+	if(type->n<0&&type->tb!=TB_STRUCT)return type->tb==TB_VOID?0:1;
+	return (typeSize(type)+(int)sizeof(Val)-1)/(int)sizeof(Val);
+	}
+
+void gcAddToFrame(Symbol *fn,Symbol *s){
+	FrameLayout *frame=&fn->fn.frame;
+	int size=typeSlots(s->type)*(int)sizeof(Val);
+	frame->align=(int)sizeof(Val);
+	if(s->kind==SK_PARAM){
+		s->frameOffset=frame->paramsSize;
+		frame->paramsSize+=size;
+		}else{
+		s->frameOffset=frame->localsSize;
+		frame->localsSize+=size;
+		}
+	}
+
+int paramsSlots(Symbol *fn){
+	return fn->fn.frame.paramsSize/(int)sizeof(Val);
+	}
+
+int varSlot(Symbol *s){
+	int slot=s->frameOffset/(int)sizeof(Val);
+	// the parameters are below the return address and the saved FP
+	if(s->kind==SK_PARAM)return slot-paramsSlots(s->owner)-1;
+	return slot+1;
+	}
+
+void gcVarAddr(Symbol *s){
+	if(s->kind==SK_VAR&&!s->owner)gcAddPtr(OP_PUSH_A,s->varMem);
+	else gcAddInt(OP_FPADDR,varSlot(s));
+	}
+
+void gcRVal(Ret *r){
+	if(!r->lval)return;
+	Type *t=typeOf(r->type);
+	if(t->n>0||(t->n<0&&t->tb==TB_STRUCT))return;
+	// the scalar locals and parameters are accessed directly in their slot
+	if(gcTail->op==OP_FPADDR){
+		gcTail->op=OP_FPLOAD;
+		return;
+		}
+	if(t->n==0){
+		gcAdd(OP_LOAD_A);
+		return;
+		}
+	switch(t->tb){
+		case TB_INT:gcAdd(OP_LOAD_I);break;
+		case TB_DOUBLE:gcAdd(OP_LOAD_F);break;
+		case TB_CHAR:gcAdd(OP_LOAD_C);break;
+		default:err("gcRVal: invalid type");
+		}
+	}
+
+void gcConv(Instr *after,TypeId src,TypeId dst){
+	if(src==dst)return;
+	switch(src){
+		case TID_INT:
+			if(dst==TID_DOUBLE)gcInsert(after,OP_CONV_I_F);
+			else if(dst==TID_CHAR)gcInsert(after,OP_CONV_I_C);
+			break;
+		case TID_CHAR:
+			if(dst==TID_DOUBLE)gcInsert(after,OP_CONV_I_F);
+			break;
+		case TID_DOUBLE:
+			if(dst==TID_INT)gcInsert(after,OP_CONV_F_I);
+			else if(dst==TID_CHAR)gcInsert(gcInsert(after,OP_CONV_F_I),OP_CONV_I_C);
+			break;
+		}
+	}
+
+void gcCond(TypeId t){
+	if(t==TID_DOUBLE){
+		gcAddDouble(OP_PUSH_F,0);
+		gcAdd(OP_NOTEQ_F);
+		}
+	}
+
+void gcBool(TypeId t){
+	if(t==TID_DOUBLE)gcAddDouble(OP_PUSH_F,0);
+	else gcAddInt(OP_PUSH_I,0);
+	gcAdd(gcBinaryOp(NOTEQ,t));
+	}
+
+Opcode gcBinaryOp(int tkCode,TypeId t){
+	Opcode op;
+	switch(tkCode){
+		case ADD:op=OP_ADD_I;break;
+		case SUB:op=OP_SUB_I;break;
+		case MUL:op=OP_MUL_I;break;
+		case DIV:op=OP_DIV_I;break;
+		case LESS:op=OP_LESS_I;break;
+		case LESSEQ:op=OP_LESSEQ_I;break;
+		case GREATER:op=OP_GREATER_I;break;
+		case GREATEREQ:op=OP_GREATEREQ_I;break;
+		case EQUAL:op=OP_EQUAL_I;break;
+		case NOTEQ:op=OP_NOTEQ_I;break;
+		default:err("gcBinaryOp: invalid operator %d",tkCode);
+		}
+	return t==TID_DOUBLE?op+1:op;
+	}
+
+void gcStore(Instr *beforeDst,Instr *lastDst,TypeId dst){
+	Type *t=typeOf(dst);
+	if(t->tb==TB_STRUCT){
+		gcAddInt(OP_COPY,typeSize(t));
+		return;
+		}
+	// a scalar local or parameter is stored directly in its slot
+	if(beforeDst->next==lastDst&&lastDst->op==OP_FPADDR){
+		int slot=lastDst->arg.i;
+		beforeDst->next=lastDst->next;
+		free(lastDst);
+		gcAddInt(OP_FPSTORE,slot);
+		return;
+		}
+	switch(t->tb){
+		case TB_INT:gcAdd(OP_STORE_I);break;
+		case TB_DOUBLE:gcAdd(OP_STORE_F);break;
+		case TB_CHAR:gcAdd(OP_STORE_C);break;
+		default:err("gcStore: invalid type");
+		}
+	}
@@ -0,0 +1,59 @@
+#pragma once
+
+// code generation
+// the parser generates the code of each function in its semantic actions, using these functions
+// the code of a function is put in fn->fn.instr
+
+#include "at.h"
+#include "vm.h"
+#include "lexer.h"
+
+// the last token consumed by the parser: the generated instructions get its line
+extern _Thread_local Token *gcSrcTk;
+// the safe mode: each access to an array with a known dimension is checked with OP_CHECK
+extern bool gcBoundsChecks;
+
+// starts the generation of fn's code
+void gcBeginFn(Symbol *fn);
+// ends the code of the current function: adds the implicit return and sets the frame size
+void gcEndFn();
+
+// returns the last generated instruction
+// it is used as a mark for gcRewind and as insertion point for gcConv
+Instr *gcLast();
+// deletes all the instructions generated after mark (used when the parser backtracks)
+void gcRewind(Instr *mark);
+// adds an instruction at the end of the current function's code
+Instr *gcAdd(Opcode op);
+Instr *gcAddInt(Opcode op,int argVal);
+Instr *gcAddDouble(Opcode op,double argVal);
+Instr *gcAddPtr(Opcode op,void *argVal);
+// inserts an instruction after the given one
+Instr *gcInsert(Instr *after,Opcode op);
+
+// the number of VM stack slots used by a value of type t
+int typeSlots(TypeId t);
+// adds a local variable or a parameter at the end of its area in the frame layout of fn
+// it sets s->frameOffset and must be called before s is duplicated in fn.locals or fn.params
+void gcAddToFrame(Symbol *fn,Symbol *s);
+// the slot of a local variable (positive) or of a parameter (negative), relative to FP
+int varSlot(Symbol *s);
+// the number of slots used by all the parameters of fn
+int paramsSlots(Symbol *fn);
+
+// generates the address of a variable or parameter
+void gcVarAddr(Symbol *s);
+// if r is a left-value, replaces its address with its value
+// for arrays and structs the address is their value, so nothing is generated
+void gcRVal(Ret *r);
+// inserts after the instruction "after" the conversion of a scalar value from src to dst, if needed
+void gcConv(Instr *after,TypeId src,TypeId dst);
+// converts the scalar of type t from the stack top in an int which can be tested by JF/JT
+void gcCond(TypeId t);
+// converts the scalar of type t from the stack top in an int which is 0 or 1
+void gcBool(TypeId t);
+// returns the opcode of the binary operator tkCode (ADD, LESS, ...) for operands of type t
+Opcode gcBinaryOp(int tkCode,TypeId t);
+// stores the value from the stack top in the destination of type dst
+// the destination's address was generated by the instructions after beforeDst, up to lastDst
+void gcStore(Instr *beforeDst,Instr *lastDst,TypeId dst);
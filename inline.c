@@ -0,0 +1,142 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+#include "inline.h"
+#include "gc.h"
+#include "utils.h"
+
+// true if fn can reach target through its calls
+// the functions already in visited are not searched again
+static bool reaches(Symbol *fn,Symbol *target,Symbol ***visited,int *nVisited,int *cap){
+	for(int k=0;k<*nVisited;k++){
+		if((*visited)[k]==fn)return false;
+		}
+	if(*nVisited==*cap){
+		*cap=*cap?*cap*2:16;
+		*visited=(Symbol**)realloc(*visited,*cap*sizeof(Symbol*));
+		if(!*visited)err("not enough memory");
+		}
+	(*visited)[(*nVisited)++]=fn;
+	for(Instr *i=fn->fn.instr;i;i=i->next){
+		if(i->op!=OP_CALL)continue;
+		Symbol *callee=(Symbol*)i->arg.p;
+		if(callee==target||reaches(callee,target,visited,nVisited,cap))return true;
+		}
+	return false;
+	}
+
+static bool isRecursive(Symbol *fn){
+	Symbol **visited=NULL;
+	int nVisited=0,cap=0;
+	bool r=reaches(fn,fn,&visited,&nVisited,&cap);
+	free(visited);
+	return r;
+	}
+
+// the functions whose arguments or result take more than one slot are not inlined,
+// because their values are copied with PUSH_STRUCT or COPY
+// a struct parameter passed by reference takes a single slot, with the address of the argument
+static bool isScalarFn(Symbol *fn){
+	if(typeSlots(fn->type)>1)return false;
+	for(Symbol *p=fn->fn.params;p;p=p->next){
+		if(typeSlots(p->type)>1&&!p->byRef)return false;
+		}
+	return true;
+	}
+
+// the new slot of a slot of the inlined function
+// the parameters (FP[-nParams-1..-2]) come after base and the locals (FP[1..]) come after the parameters
+static int mapSlot(int slot,int base,int nParams){
+	if(slot<0)return base+1+slot+nParams+1;
+	return base+nParams+slot;
+	}
+
+// replaces the call with the code of callee, whose arguments are on stack
+// the arguments are stored in the new slots of the parameters, the code of callee is copied with its slots changed
+// and its returns become jumps to the end of the inlined code, where the result is on stack
+// the call instruction remains the first instruction of the inlined code, so the jumps to it are still valid
+static void inlineCall(Instr *call,Symbol *callee,int base){
+	int nParams=paramsSlots(callee);
+	InstrIndex index;
+	initInstrIndex(&index,callee->fn.instr);
+	Instr **copies=(Instr**)safeAlloc(index.n*sizeof(Instr*));
+	Instr *end=newInstr(OP_NOP);
+	end->line=call->line;
+	end->next=call->next;
+	Instr *last=call;
+	call->op=OP_NOP;
+	call->next=end;
+	for(int k=nParams-1;k>=0;k--){
+		last=insertInstr(last,OP_FPSTORE);
+		last->arg.i=base+1+k;
+		last=insertInstr(last,OP_DROP);
+		}
+	// the first instruction is ENTER
+	copies[0]=call;
+	for(int k=1;k<index.n;k++){
+		Instr *src=index.instrs[k];
+		Instr *i=insertInstr(last,src->op);
+		i->arg=src->arg;
+		i->line=src->line;		// the inlined code keeps the lines of the callee
+		switch(src->op){
+			case OP_FPADDR:case OP_FPLOAD:case OP_FPSTORE:
+				i->arg.i=mapSlot(src->arg.i,base,nParams);
+				break;
+			case OP_RET:case OP_RET_VOID:
+				i->op=OP_JMP;
+				i->arg.instr=end;
+				break;
+			default:break;
+			}
+		copies[k]=i;
+		last=i;
+		}
+	for(int k=1;k<index.n;k++){
+		Instr *src=index.instrs[k];
+		if(src->op==OP_JMP||src->op==OP_JF||src->op==OP_JT)copies[k]->arg.instr=copies[instrIndex(&index,src->arg.instr)];
+		}
+	free(copies);
+	freeInstrIndex(&index);
+	}
+
+void inlineFn(Symbol *fn,int budget,InlineStats *stats){
+	Instr *enter=fn->fn.instr;
+	if(!enter||enter->op!=OP_ENTER)err("inlineFn: %s does not start with ENTER",fn->name);
+	for(Instr *i=enter->next;i;i=i->next){
+		if(i->op!=OP_CALL)continue;
+		Symbol *callee=(Symbol*)i->arg.p;
+		stats->calls++;
+		if(!isScalarFn(callee)){
+			stats->unsupported++;
+			continue;
+			}
+		if(instrsLen(callee->fn.instr)-1>budget){
+			stats->tooBig++;
+			continue;
+			}
+		if(callee==fn||isRecursive(callee)){
+			stats->recursive++;
+			continue;
+			}
+		int base=enter->arg.i;
+		enter->arg.i+=paramsSlots(callee)+callee->fn.instr->arg.i;
+		Instr *next=i->next;
+		inlineCall(i,callee,base);
+		stats->inlined++;
+		// the inlined code is not searched again: its calls were already processed
+		while(i->next!=next)i=i->next;
+		}
+	}
+
+void inlineDomain(Domain *d,int budget,InlineStats *stats){
+	for(Symbol *s=d->symbols;s;s=s->next){
+		if(s->kind==SK_FN&&s->fn.instr)inlineFn(s,budget,stats);
+		}
+	}
+
+void showInlineStats(InlineStats *stats){
+	printf("// inlining: %d of %d calls inlined\n",stats->inlined,stats->calls);
+	printf("//\trecursive: %d, too big: %d, struct parameters or results: %d\n",stats->recursive,stats->tooBig,stats->unsupported);
+	}
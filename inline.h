@@ -0,0 +1,23 @@
+#pragma once
+
+// the inlining of the small functions in their callers, on the VM code
+
+#include "ad.h"
+
+#define INLINE_BUDGET 40		// the default maximum size of an inlined function, in VM instructions
+
+typedef struct{
+	int calls;		// the calls of the functions with code
+	int inlined;		// the inlined calls
+	int recursive;		// the calls which were not inlined because the called function is recursive
+	int tooBig;		// the calls which were not inlined because the called function is larger than the budget
+	int unsupported;		// the calls of the functions with struct parameters or results
+	}InlineStats;
+
+// replaces in fn's code the calls of the non-recursive functions with at most budget instructions with their code
+// the parameters and the locals of each inlined function get new slots in fn's frame
+void inlineFn(Symbol *fn,int budget,InlineStats *stats);
+// inlines the calls in all the functions with code from domain d
+// the functions are processed in their definition order, so the called functions are already processed
+void inlineDomain(Domain *d,int budget,InlineStats *stats);
+void showInlineStats(InlineStats *stats);
@@ -0,0 +1,1407 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "ir.h"
+#include "gc.h"
+#include "utils.h"
+
+IrInstr *irNewInstr(IrFn *f,IrKind kind,Opcode op){
+	IrInstr *i=(IrInstr*)safeAlloc(sizeof(IrInstr));
+	memset(i,0,sizeof(IrInstr));
+	i->kind=kind;
+	i->op=op;
+	i->hasValue=true;
+	i->id=f->nValues++;
+	f->usersValid=false;
+	return i;
+	}
+
+static void freeInstr(IrInstr *i){
+	free(i->ops);
+	free(i->users);
+	free(i);
+	}
+
+void irAddOperand(IrInstr *i,IrInstr *op){
+	if(i->nOps==i->opsCap){
+		i->opsCap=i->opsCap?i->opsCap*2:2;
+		i->ops=(IrInstr**)realloc(i->ops,i->opsCap*sizeof(IrInstr*));
+		if(!i->ops)err("not enough memory");
+		}
+	i->ops[i->nOps++]=op;
+	}
+
+void irInsert(IrBlock *b,IrInstr *before,IrInstr *i){
+	if(!i->line){
+		IrInstr *near=before?before:b->last;
+		if(near)i->line=near->line;
+		}
+	i->block=b;
+	i->next=before;
+	i->prev=before?before->prev:b->last;
+	if(i->prev)i->prev->next=i;
+	else b->first=i;
+	if(before)before->prev=i;
+	else b->last=i;
+	}
+
+void irUnlink(IrInstr *i){
+	IrBlock *b=i->block;
+	if(i->prev)i->prev->next=i->next;
+	else b->first=i->next;
+	if(i->next)i->next->prev=i->prev;
+	else b->last=i->prev;
+	i->prev=i->next=NULL;
+	}
+
+void irDelete(IrInstr *i){
+	irUnlink(i);
+	freeInstr(i);
+	}
+
+void irReplace(IrInstr *i,IrInstr *value){
+	i->kind=IR_COPY;
+	i->nOps=0;
+	irAddOperand(i,value);
+	}
+
+IrInstr *irResolve(IrInstr *i){
+	while(i->kind==IR_COPY)i=i->ops[0];
+	return i;
+	}
+
+static IrBlock *newBlock(IrFn *f){
+	IrBlock *b=(IrBlock*)safeAlloc(sizeof(IrBlock));
+	memset(b,0,sizeof(IrBlock));
+	b->id=f->nBlocks++;
+	return b;
+	}
+
+static void addPred(IrBlock *b,IrBlock *pred){
+	if(b->nPreds==b->predsCap){
+		b->predsCap=b->predsCap?b->predsCap*2:2;
+		b->preds=(IrBlock**)realloc(b->preds,b->predsCap*sizeof(IrBlock*));
+		if(!b->preds)err("not enough memory");
+		}
+	b->preds[b->nPreds++]=pred;
+	}
+
+void irRemovePred(IrBlock *b,int k){
+	for(IrInstr *i=b->first;i;i=i->next){
+		if(i->kind!=IR_PHI)continue;
+		memmove(i->ops+k,i->ops+k+1,(i->nOps-k-1)*sizeof(IrInstr*));
+		i->nOps--;
+		}
+	memmove(b->preds+k,b->preds+k+1,(b->nPreds-k-1)*sizeof(IrBlock*));
+	b->nPreds--;
+	}
+
+static void freeBlock(IrBlock *b){
+	for(IrInstr *i=b->first,*next;i;i=next){
+		next=i->next;
+		freeInstr(i);
+		}
+	free(b->preds);
+	free(b);
+	}
+
+void irFree(IrFn *f){
+	for(IrBlock *b=f->blocks,*next;b;b=next){
+		next=b->next;
+		freeBlock(b);
+		}
+	free(f);
+	}
+
+// depth first search from b, which sets the visited blocks in seen (by id)
+// the blocks are added to post in postorder
+static void dfs(IrBlock *b,bool *seen,IrBlock **post,int *nPost){
+	seen[b->id]=true;
+	for(int k=0;k<b->nSuccs;k++){
+		if(!seen[b->succs[k]->id])dfs(b->succs[k],seen,post,nPost);
+		}
+	post[(*nPost)++]=b;
+	}
+
+int irRemoveUnreachable(IrFn *f){
+	bool *seen=(bool*)safeAlloc(f->nBlocks*sizeof(bool));
+	IrBlock **post=(IrBlock**)safeAlloc(f->nBlocks*sizeof(IrBlock*));
+	int nPost=0,removed=0;
+	memset(seen,0,f->nBlocks*sizeof(bool));
+	dfs(f->blocks,seen,post,&nPost);
+	// first the removed blocks are unlinked from the list and from the preds of their successors, and only then freed,
+	// because a removed block can be the successor of another removed block which comes after it in the list
+	IrBlock *dead=NULL;
+	for(IrBlock **pb=&f->blocks;*pb;){
+		IrBlock *b=*pb;
+		if(seen[b->id]){
+			pb=&b->next;
+			continue;
+			}
+		for(int s=0;s<b->nSuccs;s++){
+			IrBlock *succ=b->succs[s];
+			if(!seen[succ->id])continue;		// it is also removed
+			for(int k=0;k<succ->nPreds;k++){
+				if(succ->preds[k]==b){
+					irRemovePred(succ,k);
+					break;
+					}
+				}
+			}
+		*pb=b->next;
+		b->next=dead;
+		dead=b;
+		removed++;
+		}
+	for(IrBlock *next;dead;dead=next){
+		next=dead->next;
+		freeBlock(dead);
+		}
+	free(seen);
+	free(post);
+	if(removed)f->usersValid=false;
+	return removed;
+	}
+
+int irMergeBlocks(IrFn *f){
+	int merged=0;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		while(b->last->op==OP_JMP){
+			IrBlock *s=b->succs[0];
+			if(s->nPreds!=1||s==b||s==f->blocks)break;
+			irDelete(b->last);
+			for(IrInstr *i=s->first,*next;i;i=next){
+				next=i->next;
+				if(i->kind==IR_PHI)irReplace(i,i->ops[0]);
+				irUnlink(i);
+				irInsert(b,NULL,i);
+				}
+			b->nSuccs=s->nSuccs;
+			for(int k=0;k<s->nSuccs;k++){
+				b->succs[k]=s->succs[k];
+				for(int p=0;p<s->succs[k]->nPreds;p++){
+					if(s->succs[k]->preds[p]==s)s->succs[k]->preds[p]=b;
+					}
+				}
+			IrBlock **ps=&f->blocks;
+			while(*ps!=s)ps=&(*ps)->next;
+			*ps=s->next;
+			s->first=s->last=NULL;
+			freeBlock(s);
+			merged++;
+			}
+		}
+	if(merged)f->usersValid=false;
+	return merged;
+	}
+
+static void addUser(IrInstr *value,IrInstr *user){
+	value->users[value->nUsers++]=user;
+	}
+
+void irBuildUsers(IrFn *f){
+	if(f->usersValid)return;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next)i->nUsers=0;
+		}
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next){
+			for(int k=0;k<i->nOps;k++)i->ops[k]->nUsers++;
+			}
+		}
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next){
+			free(i->users);
+			i->users=i->nUsers?(IrInstr**)safeAlloc(i->nUsers*sizeof(IrInstr*)):NULL;
+			i->nUsers=0;
+			}
+		}
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next){
+			for(int k=0;k<i->nOps;k++)addUser(i->ops[k],i);
+			}
+		}
+	f->usersValid=true;
+	}
+
+static IrBlock *intersect(IrBlock *a,IrBlock *b){
+	while(a!=b){
+		while(a->rpo>b->rpo)a=a->idom;
+		while(b->rpo>a->rpo)b=b->idom;
+		}
+	return a;
+	}
+
+void irDominators(IrFn *f){
+	bool *seen=(bool*)safeAlloc(f->nBlocks*sizeof(bool));
+	IrBlock **post=(IrBlock**)safeAlloc(f->nBlocks*sizeof(IrBlock*));
+	int nPost=0;
+	memset(seen,0,f->nBlocks*sizeof(bool));
+	dfs(f->blocks,seen,post,&nPost);
+	// puts the blocks in reverse postorder
+	for(int k=nPost-1;k>=0;k--){
+		post[k]->rpo=nPost-1-k;
+		post[k]->next=k?post[k-1]:NULL;
+		post[k]->idom=NULL;
+		}
+	f->blocks=post[nPost-1];
+	f->blocks->idom=f->blocks;
+	// Cooper, Harvey, Kennedy: "A Simple, Fast Dominance Algorithm"
+	for(bool changed=true;changed;){
+		changed=false;
+		for(IrBlock *b=f->blocks->next;b;b=b->next){
+			IrBlock *idom=NULL;
+			for(int k=0;k<b->nPreds;k++){
+				IrBlock *p=b->preds[k];
+				if(!p->idom)continue;
+				idom=idom?intersect(p,idom):p;
+				}
+			if(idom!=b->idom){
+				b->idom=idom;
+				changed=true;
+				}
+			}
+		}
+	free(seen);
+	free(post);
+	}
+
+bool irDominates(IrBlock *a,IrBlock *b){
+	for(;;){
+		if(a==b)return true;
+		if(b->idom==b)return false;
+		b=b->idom;
+		}
+	}
+
+bool irLoopBody(IrFn *f,IrBlock *h,bool *body){
+	IrBlock **work=(IrBlock**)safeAlloc(f->nBlocks*sizeof(IrBlock*));
+	int nWork=0;
+	bool isHeader=false;
+	memset(body,0,f->nBlocks*sizeof(bool));
+	body[h->id]=true;
+	for(int k=0;k<h->nPreds;k++){
+		IrBlock *p=h->preds[k];
+		if(!irDominates(h,p))continue;
+		isHeader=true;
+		if(!body[p->id]){
+			body[p->id]=true;
+			work[nWork++]=p;
+			}
+		}
+	while(nWork){
+		IrBlock *b=work[--nWork];
+		for(int k=0;k<b->nPreds;k++){
+			if(!body[b->preds[k]->id]){
+				body[b->preds[k]->id]=true;
+				work[nWork++]=b->preds[k];
+				}
+			}
+		}
+	free(work);
+	return isHeader;
+	}
+
+IrBlock *irSplitEdge(IrFn *f,IrBlock *b,int k){
+	IrBlock *succ=b->succs[k];
+	IrBlock *mid=newBlock(f);
+	IrInstr *jmp=irNewInstr(f,IR_OP,OP_JMP);
+	jmp->hasValue=false;
+	irInsert(mid,NULL,jmp);
+	addPred(mid,b);
+	mid->succs[0]=succ;
+	mid->nSuccs=1;
+	b->succs[k]=mid;
+	// the new block takes the place of b in the predecessors of succ, so the phis operands remain in order
+	for(int p=0;p<succ->nPreds;p++){
+		if(succ->preds[p]==b){
+			succ->preds[p]=mid;
+			break;
+			}
+		}
+	mid->next=b->next;
+	b->next=mid;
+	return mid;
+	}
+
+IrEffect irEffect(IrInstr *i){
+	if(i->kind!=IR_OP)return IR_PURE;
+	switch(i->op){
+		case OP_PUSH_I:case OP_PUSH_F:case OP_PUSH_A:case OP_FPADDR:case OP_INDEX:case OP_OFFSET:
+		case OP_CONV_I_F:case OP_CONV_F_I:case OP_CONV_I_C:
+		case OP_ADD_I:case OP_ADD_F:case OP_SUB_I:case OP_SUB_F:case OP_MUL_I:case OP_MUL_F:case OP_DIV_I:case OP_DIV_F:
+		case OP_LESS_I:case OP_LESS_F:case OP_LESSEQ_I:case OP_LESSEQ_F:case OP_GREATER_I:case OP_GREATER_F:
+		case OP_GREATEREQ_I:case OP_GREATEREQ_F:case OP_EQUAL_I:case OP_EQUAL_F:case OP_NOTEQ_I:case OP_NOTEQ_F:
+		case OP_NEG_I:case OP_NEG_F:case OP_NOT_I:case OP_NOT_F:
+			return IR_PURE;
+		case OP_FPLOAD:case OP_LOAD_I:case OP_LOAD_F:case OP_LOAD_C:case OP_LOAD_A:case OP_VSUM_I:case OP_VSUM_F:
+			return IR_READ;
+		case OP_CHECK:
+			return IR_CHECK;
+		default:
+			return IR_WRITE;
+		}
+	}
+
+// the construction of the SSA form, using the algorithm from
+// Braun et al.: "Simple and Efficient Construction of Static Single Assignment Form"
+// the variables are the frame slots accessed only with FPLOAD/FPSTORE and the VM stack positions at the blocks' boundaries
+typedef struct{
+	IrFn *f;
+	int nVars;
+	int stackVar0;		// the variable of the stack position 0; the next positions follow it
+	int minSlot;		// the first slot in varOfSlot
+	int *varOfSlot;		// the variable of a slot or -1
+	int *slotOfVar;
+	IrInstr **defs;		// defs[var*nBlocks+block->id]: the current definition of var in block
+	int nBlocks;
+	bool *sealed;
+	bool *filled;
+	// the incomplete phis of each block: the phis created before all the predecessors were filled
+	IrInstr ***incPhis;
+	int **incVars;
+	int *nInc;
+	}SsaBuilder;
+
+static IrInstr *readVar(SsaBuilder *sb,int var,IrBlock *b);
+
+static void writeVar(SsaBuilder *sb,int var,IrBlock *b,IrInstr *value){
+	sb->defs[var*sb->nBlocks+b->id]=value;
+	}
+
+static IrInstr *firstNonPhi(IrBlock *b){
+	IrInstr *i=b->first;
+	while(i&&i->kind==IR_PHI)i=i->next;
+	return i;
+	}
+
+static void addPhiOperands(SsaBuilder *sb,int var,IrInstr *phi){
+	for(int k=0;k<phi->block->nPreds;k++)irAddOperand(phi,readVar(sb,var,phi->block->preds[k]));
+	}
+
+static IrInstr *readVarRec(SsaBuilder *sb,int var,IrBlock *b){
+	IrInstr *value;
+	if(!sb->sealed[b->id]){
+		value=irNewInstr(sb->f,IR_PHI,OP_NOP);
+		irInsert(b,firstNonPhi(b),value);
+		int n=sb->nInc[b->id]++;
+		sb->incPhis[b->id]=(IrInstr**)realloc(sb->incPhis[b->id],(n+1)*sizeof(IrInstr*));
+		sb->incVars[b->id]=(int*)realloc(sb->incVars[b->id],(n+1)*sizeof(int));
+		if(!sb->incPhis[b->id]||!sb->incVars[b->id])err("not enough memory");
+		sb->incPhis[b->id][n]=value;
+		sb->incVars[b->id][n]=var;
+		}else if(b->nPreds==0){
+		// the entry block: the value which the variable had when the function was called
+		value=irNewInstr(sb->f,IR_INIT,OP_NOP);
+		value->arg.i=sb->slotOfVar[var];
+		irInsert(b,b->last,value);
+		}else if(b->nPreds==1){
+		value=readVar(sb,var,b->preds[0]);
+		}else{
+		value=irNewInstr(sb->f,IR_PHI,OP_NOP);
+		irInsert(b,firstNonPhi(b),value);
+		writeVar(sb,var,b,value);		// breaks the cycles
+		addPhiOperands(sb,var,value);
+		}
+	writeVar(sb,var,b,value);
+	return value;
+	}
+
+static IrInstr *readVar(SsaBuilder *sb,int var,IrBlock *b){
+	IrInstr *value=sb->defs[var*sb->nBlocks+b->id];
+	return value?value:readVarRec(sb,var,b);
+	}
+
+static void sealBlock(SsaBuilder *sb,IrBlock *b){
+	for(int k=0;k<sb->nInc[b->id];k++)addPhiOperands(sb,sb->incVars[b->id][k],sb->incPhis[b->id][k]);
+	sb->sealed[b->id]=true;
+	}
+
+static void sealFilledSuccs(SsaBuilder *sb,IrBlock *b){
+	for(int s=0;s<b->nSuccs;s++){
+		IrBlock *succ=b->succs[s];
+		if(sb->sealed[succ->id])continue;
+		int k;
+		for(k=0;k<succ->nPreds&&sb->filled[succ->preds[k]->id];k++){}
+		if(k==succ->nPreds)sealBlock(sb,succ);
+		}
+	}
+
+static bool isJump(Opcode op){
+	return op==OP_JMP||op==OP_JF||op==OP_JT;
+	}
+
+static bool endsBlock(Opcode op){
+	return isJump(op)||op==OP_RET||op==OP_RET_VOID;
+	}
+
+// the number of the values popped and pushed by a VM instruction
+static void stackEffect(Instr *i,int *pops,int *pushes){
+	*pops=*pushes=0;
+	switch(i->op){
+		case OP_PUSH_I:case OP_PUSH_F:case OP_PUSH_A:case OP_FPADDR:case OP_FPLOAD:*pushes=1;break;
+		case OP_DROP:case OP_JF:case OP_JT:case OP_RET:*pops=1;break;
+		case OP_LOAD_I:case OP_LOAD_F:case OP_LOAD_C:case OP_LOAD_A:case OP_OFFSET:case OP_CHECK:
+		case OP_CONV_I_F:case OP_CONV_F_I:case OP_CONV_I_C:case OP_NEG_I:case OP_NEG_F:case OP_NOT_I:case OP_NOT_F:
+			*pops=*pushes=1;break;
+		case OP_VSUM_I:case OP_VSUM_F:*pops=4;*pushes=1;break;
+		case OP_VCOPY:*pops=4;break;
+		case OP_CALL:case OP_CALL_EXT:{
+			Symbol *fn=(Symbol*)i->arg.p;
+			*pops=paramsSlots(fn);
+			*pushes=fn->type==TID_VOID?0:1;
+			}break;
+		default:
+			if((i->op>=OP_STORE_I&&i->op<=OP_COPY)||(i->op>=OP_ADD_I&&i->op<=OP_NOTEQ_F)||i->op==OP_INDEX){
+				*pops=2;
+				*pushes=1;
+				}
+			break;
+		}
+	}
+
+// the VM code of a basic block: code[begin..end)
+typedef struct{
+	int begin,end;
+	IrBlock *block;
+	int depthIn;		// the stack depth at the block's entry or -1 if it is not known yet
+	}VmRange;
+
+static IrInstr *newOp(IrFn *f,IrBlock *b,Instr *vm,int nOps,IrInstr **stack,int *sp){
+	IrInstr *i=irNewInstr(f,IR_OP,vm->op);
+	i->arg=vm->arg;
+	i->line=vm->line;
+	*sp-=nOps;
+	for(int k=0;k<nOps;k++)irAddOperand(i,stack[*sp+k]);
+	irInsert(b,NULL,i);
+	return i;
+	}
+
+static void addTerminator(IrFn *f,IrBlock *b,Opcode op,IrInstr *cond){
+	IrInstr *t=irNewInstr(f,IR_OP,op);
+	t->hasValue=false;
+	if(cond)irAddOperand(t,cond);
+	irInsert(b,NULL,t);
+	}
+
+// fills the IR block from its VM code
+static void fillBlock(SsaBuilder *sb,Instr **code,VmRange *r,IrInstr **stack){
+	IrFn *f=sb->f;
+	IrBlock *b=r->block;
+	int sp=r->depthIn;
+	for(int k=0;k<sp;k++)stack[k]=readVar(sb,sb->stackVar0+k,b);
+	bool ended=false;
+	for(int k=r->begin;k<r->end;k++){
+		Instr *vm=code[k];
+		int pops,pushes;
+		IrInstr *i;
+		stackEffect(vm,&pops,&pushes);
+		switch(vm->op){
+			case OP_NOP:break;
+			case OP_DROP:sp--;break;
+			case OP_FPLOAD:{
+				int var=sb->varOfSlot[vm->arg.i-sb->minSlot];
+				if(var>=0)stack[sp++]=readVar(sb,var,b);
+				else stack[sp++]=newOp(f,b,vm,0,stack,&sp);
+				}break;
+			case OP_FPSTORE:{
+				int var=sb->varOfSlot[vm->arg.i-sb->minSlot];
+				if(var>=0){
+					writeVar(sb,var,b,stack[sp-1]);
+					}else{
+					i=newOp(f,b,vm,1,stack,&sp);
+					i->hasValue=false;
+					sp++;		// the value remains on stack
+					}
+				}break;
+			case OP_STORE_I:case OP_STORE_F:case OP_STORE_C:case OP_COPY:{
+				IrInstr *v=stack[sp-1];
+				i=newOp(f,b,vm,2,stack,&sp);
+				i->hasValue=false;
+				if(vm->op==OP_COPY){
+					v=i->ops[0];		// the destination remains on stack
+					}else if(vm->op==OP_STORE_C){
+					// the value which remains on stack is the stored char
+					IrInstr *c=irNewInstr(f,IR_OP,OP_CONV_I_C);
+					irAddOperand(c,v);
+					irInsert(b,NULL,c);
+					v=c;
+					}
+				stack[sp++]=v;
+				}break;
+			case OP_JMP:
+				addTerminator(f,b,OP_JMP,NULL);
+				ended=true;
+				break;
+			case OP_JF:case OP_JT:
+				sp--;
+				// a conditional jump to the next instruction
+				if(b->succs[0]==b->succs[1])addTerminator(f,b,OP_JMP,NULL);
+				else addTerminator(f,b,OP_JT,stack[sp]);
+				ended=true;
+				break;
+			case OP_RET:
+				sp--;
+				addTerminator(f,b,OP_RET,stack[sp]);
+				b->last->arg=vm->arg;
+				ended=true;
+				break;
+			case OP_RET_VOID:
+				addTerminator(f,b,OP_RET_VOID,NULL);
+				b->last->arg=vm->arg;
+				ended=true;
+				break;
+			default:
+				i=newOp(f,b,vm,pops,stack,&sp);
+				if(pushes)stack[sp++]=i;
+				else i->hasValue=false;
+				break;
+			}
+		}
+	if(!ended)addTerminator(f,b,OP_JMP,NULL);
+	for(int k=0;k<sp;k++)writeVar(sb,sb->stackVar0+k,b,stack[k]);
+	sb->filled[b->id]=true;
+	}
+
+IrFn *irBuild(Symbol *fn){
+	InstrIndex index;
+	initInstrIndex(&index,fn->fn.instr);
+	Instr **code=index.instrs;
+	int n=index.n;
+	if(n<2||code[0]->op!=OP_ENTER)err("irBuild: %s does not start with ENTER",fn->name);
+	int minSlot=0,maxSlot=0;
+	for(int k=0;k<n;k++){
+		Instr *i=code[k];
+		// the register operations come only from irToVm
+		if(i->op==OP_PUSH_STRUCT||i->op==OP_HALT||(i->op>=OP_RLOAD_I&&i->op<=OP_RSTORE_F)){
+			freeInstrIndex(&index);
+			return NULL;
+			}
+		if((i->op==OP_CALL||i->op==OP_CALL_EXT)&&typeSlots(((Symbol*)i->arg.p)->type)>1){
+			freeInstrIndex(&index);
+			return NULL;
+			}
+		if(i->op==OP_FPADDR||i->op==OP_FPLOAD||i->op==OP_FPSTORE){
+			if(i->arg.i<minSlot)minSlot=i->arg.i;
+			if(i->arg.i>maxSlot)maxSlot=i->arg.i;
+			}
+		}
+	IrFn *f=(IrFn*)safeAlloc(sizeof(IrFn));
+	memset(f,0,sizeof(IrFn));
+	f->fn=fn;
+	f->frameSlots=code[0]->arg.i;
+
+	// the basic blocks: a block starts at a jump target or after a jump or return
+	bool *leader=(bool*)safeAlloc((n+1)*sizeof(bool));
+	memset(leader,0,(n+1)*sizeof(bool));
+	leader[1]=true;
+	for(int k=1;k<n;k++){
+		if(isJump(code[k]->op))leader[instrIndex(&index,code[k]->arg.instr)]=true;
+		if(endsBlock(code[k]->op))leader[k+1]=true;
+		}
+	int nLeaders=0;
+	for(int k=1;k<n;k++)nLeaders+=leader[k];
+	if(nLeaders>=IR_MAX_BLOCKS){
+		free(leader);
+		free(f);
+		freeInstrIndex(&index);
+		return NULL;
+		}
+	int *rangeOf=(int*)safeAlloc(n*sizeof(int));		// the range which starts at a leader
+	VmRange *ranges=(VmRange*)safeAlloc(n*sizeof(VmRange));
+	int nRanges=0;
+	IrBlock *entry=newBlock(f);
+	for(int k=1;k<n;k++){
+		if(!leader[k])continue;
+		if(nRanges)ranges[nRanges-1].end=k;
+		rangeOf[k]=nRanges;
+		ranges[nRanges].begin=k;
+		ranges[nRanges].block=newBlock(f);
+		ranges[nRanges].depthIn=-1;
+		nRanges++;
+		}
+	ranges[nRanges-1].end=n;
+	for(int r=0;r<nRanges;r++){
+		IrBlock *b=ranges[r].block;
+		Instr *last=code[ranges[r].end-1];
+		IrBlock *fallthrough=r+1<nRanges?ranges[r+1].block:NULL;
+		IrBlock *target=isJump(last->op)?ranges[rangeOf[instrIndex(&index,last->arg.instr)]].block:NULL;
+		switch(last->op){
+			case OP_JMP:b->succs[b->nSuccs++]=target;break;
+			case OP_JF:b->succs[b->nSuccs++]=fallthrough;b->succs[b->nSuccs++]=target;break;
+			case OP_JT:b->succs[b->nSuccs++]=target;b->succs[b->nSuccs++]=fallthrough;break;
+			case OP_RET:case OP_RET_VOID:break;
+			default:b->succs[b->nSuccs++]=fallthrough;break;
+			}
+		for(int s=0;s<b->nSuccs;s++){
+			if(!b->succs[s])err("irBuild: the code of %s does not end with a return",fn->name);
+			}
+		}
+	entry->succs[entry->nSuccs++]=ranges[0].block;
+	VmRange **rangeOfBlock=(VmRange**)safeAlloc(f->nBlocks*sizeof(VmRange*));
+	for(int r=0;r<nRanges;r++)rangeOfBlock[ranges[r].block->id]=&ranges[r];
+
+	// only the reachable blocks are kept, in reverse postorder
+	bool *seen=(bool*)safeAlloc(f->nBlocks*sizeof(bool));
+	IrBlock **post=(IrBlock**)safeAlloc(f->nBlocks*sizeof(IrBlock*));
+	int nPost=0;
+	memset(seen,0,f->nBlocks*sizeof(bool));
+	dfs(entry,seen,post,&nPost);
+	for(int k=nPost-1;k>=0;k--){
+		IrBlock *b=post[k];
+		b->next=k?post[k-1]:NULL;
+		for(int s=0;s<b->nSuccs;s++)addPred(b->succs[s],b);
+		}
+	f->blocks=entry;
+	for(int r=0;r<nRanges;r++){
+		if(!seen[ranges[r].block->id]){
+			freeBlock(ranges[r].block);
+			ranges[r].block=NULL;
+			}
+		}
+
+	// the stack depth at the entry of each block
+	int maxDepth=0;
+	ranges[0].depthIn=0;
+	for(IrBlock *b=entry->next;b;b=b->next){
+		VmRange *r=rangeOfBlock[b->id];
+		int depth=r->depthIn;
+		for(int k=r->begin;k<r->end;k++){
+			int pops,pushes;
+			stackEffect(code[k],&pops,&pushes);
+			depth+=pushes-pops;
+			if(depth>maxDepth)maxDepth=depth;
+			}
+		for(int s=0;s<b->nSuccs;s++){
+			VmRange *succ=rangeOfBlock[b->succs[s]->id];
+			if(succ->depthIn<0)succ->depthIn=depth;
+			else if(succ->depthIn!=depth)err("irBuild: inconsistent stack depth in %s",fn->name);
+			}
+		}
+
+	// the variables
+	SsaBuilder sb;
+	memset(&sb,0,sizeof(sb));
+	sb.f=f;
+	sb.nBlocks=f->nBlocks;
+	sb.minSlot=minSlot;
+	int nSlots=maxSlot-minSlot+1;
+	sb.varOfSlot=(int*)safeAlloc(nSlots*sizeof(int));
+	sb.slotOfVar=(int*)safeAlloc((nSlots+maxDepth)*sizeof(int));
+	for(int s=0;s<nSlots;s++)sb.varOfSlot[s]=-1;
+	for(int pass=0;pass<2;pass++){
+		for(int k=0;k<n;k++){
+			Instr *i=code[k];
+			if(i->op!=OP_FPADDR&&i->op!=OP_FPLOAD&&i->op!=OP_FPSTORE)continue;
+			int *var=&sb.varOfSlot[i->arg.i-minSlot];
+			if(pass==0&&i->op==OP_FPADDR)*var=-2;		// the address is taken
+			if(pass==1&&*var==-1){
+				sb.slotOfVar[sb.nVars]=i->arg.i;
+				*var=sb.nVars++;
+				}
+			}
+		}
+	for(int s=0;s<nSlots;s++){
+		if(sb.varOfSlot[s]==-2)sb.varOfSlot[s]=-1;
+		}
+	sb.stackVar0=sb.nVars;
+	sb.nVars+=maxDepth;
+	if((size_t)sb.nVars*sb.nBlocks>IR_MAX_DEFS){
+		free(sb.varOfSlot);
+		free(sb.slotOfVar);
+		free(seen);
+		free(post);
+		free(rangeOfBlock);
+		free(ranges);
+		free(rangeOf);
+		free(leader);
+		freeInstrIndex(&index);
+		irFree(f);
+		return NULL;
+		}
+	sb.defs=(IrInstr**)safeAlloc((size_t)(sb.nVars?sb.nVars:1)*sb.nBlocks*sizeof(IrInstr*));
+	memset(sb.defs,0,(size_t)(sb.nVars?sb.nVars:1)*sb.nBlocks*sizeof(IrInstr*));
+	sb.sealed=(bool*)safeAlloc(sb.nBlocks*sizeof(bool));
+	sb.filled=(bool*)safeAlloc(sb.nBlocks*sizeof(bool));
+	sb.incPhis=(IrInstr***)safeAlloc(sb.nBlocks*sizeof(IrInstr**));
+	sb.incVars=(int**)safeAlloc(sb.nBlocks*sizeof(int*));
+	sb.nInc=(int*)safeAlloc(sb.nBlocks*sizeof(int));
+	memset(sb.sealed,0,sb.nBlocks*sizeof(bool));
+	memset(sb.filled,0,sb.nBlocks*sizeof(bool));
+	memset(sb.incPhis,0,sb.nBlocks*sizeof(IrInstr**));
+	memset(sb.incVars,0,sb.nBlocks*sizeof(int*));
+	memset(sb.nInc,0,sb.nBlocks*sizeof(int));
+
+	// the entry block only jumps to the function's code; it holds the initial values of the variables
+	addTerminator(f,entry,OP_JMP,NULL);
+	sb.sealed[entry->id]=sb.filled[entry->id]=true;
+	sealFilledSuccs(&sb,entry);
+	IrInstr **stack=(IrInstr**)safeAlloc((maxDepth+1)*sizeof(IrInstr*));
+	for(IrBlock *b=entry->next;b;b=b->next){
+		fillBlock(&sb,code,rangeOfBlock[b->id],stack);
+		sealFilledSuccs(&sb,b);
+		}
+	for(int k=0;k<sb.nBlocks;k++){
+		free(sb.incPhis[k]);
+		free(sb.incVars[k]);
+		}
+	free(sb.varOfSlot);
+	free(sb.slotOfVar);
+	free(sb.defs);
+	free(sb.sealed);
+	free(sb.filled);
+	free(sb.incPhis);
+	free(sb.incVars);
+	free(sb.nInc);
+	free(stack);
+	free(seen);
+	free(post);
+	free(rangeOfBlock);
+	free(ranges);
+	free(rangeOf);
+	free(leader);
+	freeInstrIndex(&index);
+	return f;
+	}
+
+static void showValue(IrInstr *i){
+	printf(" v%d",irResolve(i)->id);
+	}
+
+void irDump(IrFn *f){
+	printf("%s:\n",f->fn->name);
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		printf("b%d:",b->id);
+		if(b->nPreds){
+			printf("\t\t// preds:");
+			for(int k=0;k<b->nPreds;k++)printf(" b%d",b->preds[k]->id);
+			}
+		putchar('\n');
+		for(IrInstr *i=b->first;i;i=i->next){
+			putchar('\t');
+			if(i->hasValue)printf("v%d = ",i->id);
+			switch(i->kind){
+				case IR_PHI:
+					printf("phi");
+					for(int k=0;k<i->nOps;k++)printf(" [v%d b%d]",irResolve(i->ops[k])->id,b->preds[k]->id);
+					break;
+				case IR_COPY:
+					printf("copy");
+					showValue(i->ops[0]);
+					break;
+				case IR_INIT:
+					printf("init\t%d",i->arg.i);
+					break;
+				case IR_OP:
+					printf("%s",opName(i->op));
+					showInstrArg(i->op,i->arg);
+					for(int k=0;k<i->nOps;k++)showValue(i->ops[k]);
+					for(int k=0;k<b->nSuccs&&i==b->last;k++)printf(" b%d",b->succs[k]->id);
+					break;
+				}
+			putchar('\n');
+			}
+		}
+	}
+
+// the lowering of the IR to VM code
+// the VM stack is used for the values which are used only once, by an instruction from the same block,
+// if they are in the right place on the stack when that instruction is generated
+// the constants, FPADDR and the initial values of the variables are generated again at each use
+// all the other values get registers, by linear scan; when there are not enough registers,
+// the values with the lowest spill costs are stored in frame slots
+typedef struct{
+	IrInstr *value;
+	Instr *start;		// the instruction after which the code of value starts
+	}StackEntry;
+
+// the live range of a value, from its definition to its last use
+// the holes are ignored, so a value keeps its location in the whole range
+typedef struct{
+	IrInstr *value;
+	int start,end;
+	double weight;		// the spill cost: the uses weighted by the loops depth, divided by the range's length
+	}Interval;
+
+typedef struct{
+	IrFn *f;
+	Instr *list,*tail;
+	Instr **labels;		// the first instruction of each block (by id)
+	int *slot;		// the slot of each value (by id) or 0 if it is not stored in a slot
+	int *reg;		// the register of each value (by id) plus 1 or 0 if it has no register
+	bool *isFloat;		// the values which are kept in the double registers (by id)
+	bool *onStack;		// the values which are left on the VM stack (by id)
+	Instr **store;		// the FPSTORE or RSTORE of the stored values (by id)
+	int nSlots;		// the new frame slots
+	int intSave[VM_INT_REGS];		// the slots where the used registers are saved, or 0 for the unused ones
+	int floatSave[VM_FLOAT_REGS];
+	StackEntry *stack;
+	int sp;
+	int line;		// the source line given to the emitted instructions
+	}Lowering;
+
+static Instr *emit(Lowering *l,Opcode op){
+	Instr *i=newInstr(op);
+	i->line=l->line;
+	l->tail->next=i;
+	l->tail=i;
+	return i;
+	}
+
+static Instr *emitAfter(Lowering *l,Instr *after,Opcode op){
+	Instr *i=insertInstr(after,op);
+	if(after==l->tail)l->tail=i;
+	return i;
+	}
+
+static bool isRemat(IrInstr *i){
+	if(i->kind==IR_INIT)return true;
+	return i->kind==IR_OP&&(i->op==OP_PUSH_I||i->op==OP_PUSH_F||i->op==OP_PUSH_A||i->op==OP_FPADDR);
+	}
+
+// true if the value must be kept in a register or slot
+static bool needsLocation(Lowering *l,IrInstr *i){
+	return i->kind!=IR_COPY&&i->hasValue&&!isRemat(i)&&i->nUsers&&!l->onStack[i->id];
+	}
+
+static bool isLocated(Lowering *l,IrInstr *i){
+	return l->reg[i->id]||l->slot[i->id];
+	}
+
+static bool sameLocation(Lowering *l,IrInstr *a,IrInstr *b){
+	if(l->reg[a->id])return l->reg[a->id]==l->reg[b->id]&&l->isFloat[a->id]==l->isFloat[b->id];
+	return l->slot[a->id]&&l->slot[a->id]==l->slot[b->id];
+	}
+
+// generates after the given instruction the loading of a value which is not on stack
+static Instr *emitLoad(Lowering *l,Instr *after,IrInstr *v){
+	Instr *i;
+	if(v->kind==IR_INIT){
+		i=emitAfter(l,after,OP_FPLOAD);
+		i->arg.i=v->arg.i;
+		}else if(isRemat(v)){
+		i=emitAfter(l,after,v->op);
+		i->arg=v->arg;
+		}else if(l->reg[v->id]){
+		i=emitAfter(l,after,l->isFloat[v->id]?OP_RLOAD_F:OP_RLOAD_I);
+		i->arg.i=l->reg[v->id]-1;
+		}else{
+		if(!l->slot[v->id])err("irToVm: v%d is not stored",v->id);
+		i=emitAfter(l,after,OP_FPLOAD);
+		i->arg.i=l->slot[v->id];
+		}
+	return i;
+	}
+
+// stores the value from the top of the stack in the location of v
+static Instr *emitStore(Lowering *l,IrInstr *v){
+	Instr *i;
+	if(l->reg[v->id]){
+		i=emit(l,l->isFloat[v->id]?OP_RSTORE_F:OP_RSTORE_I);
+		i->arg.i=l->reg[v->id]-1;
+		}else{
+		i=emit(l,OP_FPSTORE);
+		i->arg.i=l->slot[v->id];
+		}
+	return i;
+	}
+
+static void spill(Lowering *l,IrInstr *v){
+	l->onStack[v->id]=false;
+	l->slot[v->id]=l->f->frameSlots+ ++l->nSlots;
+	}
+
+// the registers are callee-saved: they are saved after ENTER and restored before each return
+static void emitSaves(Lowering *l){
+	for(int r=0;r<VM_INT_REGS;r++){
+		if(!l->intSave[r])continue;
+		emit(l,OP_RLOAD_I)->arg.i=r;
+		emit(l,OP_FPSTORE)->arg.i=l->intSave[r];
+		emit(l,OP_DROP);
+		}
+	for(int r=0;r<VM_FLOAT_REGS;r++){
+		if(!l->floatSave[r])continue;
+		emit(l,OP_RLOAD_F)->arg.i=r;
+		emit(l,OP_FPSTORE)->arg.i=l->floatSave[r];
+		emit(l,OP_DROP);
+		}
+	}
+
+static void emitRestores(Lowering *l){
+	for(int r=0;r<VM_INT_REGS;r++){
+		if(!l->intSave[r])continue;
+		emit(l,OP_FPLOAD)->arg.i=l->intSave[r];
+		emit(l,OP_RSTORE_I)->arg.i=r;
+		emit(l,OP_DROP);
+		}
+	for(int r=0;r<VM_FLOAT_REGS;r++){
+		if(!l->floatSave[r])continue;
+		emit(l,OP_FPLOAD)->arg.i=l->floatSave[r];
+		emit(l,OP_RSTORE_F)->arg.i=r;
+		emit(l,OP_DROP);
+		}
+	}
+
+// returns true if the instruction "needle" comes after the instruction "from"
+static bool isAfter(Instr *from,Instr *needle){
+	for(Instr *i=from->next;i;i=i->next){
+		if(i==needle)return true;
+		}
+	return false;
+	}
+
+// puts the operands of i on the stack
+// returns false if a value which should be on stack is not where i needs it; in this case that value is spilled
+static bool emitOperands(Lowering *l,IrInstr *i,Instr **start){
+	int top=l->sp-1;
+	Instr *insertAt=l->tail;		// the loads of the operands which are not on stack are inserted here
+	for(int k=i->nOps-1;k>=0;k--){
+		IrInstr *op=i->ops[k];
+		if(l->onStack[op->id]){
+			if(top<0||l->stack[top].value!=op){
+				spill(l,op);
+				return false;
+				}
+			insertAt=l->stack[top--].start;
+			continue;
+			}
+		// the value must be already stored at the place where it is loaded
+		if(op->block==i->block&&l->store[op->id]&&insertAt!=l->tail&&isAfter(insertAt,l->store[op->id])){
+			spill(l,l->stack[top+1].value);
+			return false;
+			}
+		emitLoad(l,insertAt,op);
+		}
+	l->sp=top+1;
+	*start=insertAt;
+	return true;
+	}
+
+// the copies of the phi operands for the edge from b to succ
+// all the values are pushed first and then stored, so the phis which use each other get the old values
+static void emitPhiCopies(Lowering *l,IrBlock *b,IrBlock *succ){
+	int k;
+	for(k=0;succ->preds[k]!=b;k++){}
+	int n=0;
+	for(IrInstr *i=succ->first;i&&i->kind==IR_PHI;i=i->next){
+		if(!isLocated(l,i)||sameLocation(l,i,i->ops[k]))continue;
+		emitLoad(l,l->tail,i->ops[k]);
+		n++;
+		}
+	if(!n)return;
+	for(IrInstr *i=succ->last;i;i=i->prev){
+		if(i->kind!=IR_PHI)continue;
+		if(!isLocated(l,i)||sameLocation(l,i,i->ops[k]))continue;
+		emitStore(l,i);
+		emit(l,OP_DROP);
+		}
+	}
+
+static bool needsPhiCopies(Lowering *l,IrBlock *b,IrBlock *succ){
+	int k;
+	for(k=0;succ->preds[k]!=b;k++){}
+	for(IrInstr *i=succ->first;i&&i->kind==IR_PHI;i=i->next){
+		if(isLocated(l,i)&&!sameLocation(l,i,i->ops[k]))return true;
+		}
+	return false;
+	}
+
+static void emitJump(Lowering *l,Opcode op,IrBlock *target){
+	emit(l,op)->arg.instr=l->labels[target->id];
+	}
+
+// the terminator of b, with the phi copies on each edge
+static void emitTerminator(Lowering *l,IrBlock *b){
+	IrInstr *t=b->last;
+	IrBlock *next=b->next;
+	switch(t->op){
+		case OP_RET:
+			emitRestores(l);
+			emit(l,OP_RET)->arg=t->arg;
+			break;
+		case OP_RET_VOID:
+			emitRestores(l);
+			emit(l,OP_RET_VOID)->arg=t->arg;
+			break;
+		case OP_JMP:
+			emitPhiCopies(l,b,b->succs[0]);
+			if(b->succs[0]!=next)emitJump(l,OP_JMP,b->succs[0]);
+			break;
+		case OP_JT:{
+			IrBlock *onTrue=b->succs[0],*onFalse=b->succs[1];
+			bool copiesOnTrue=needsPhiCopies(l,b,onTrue),copiesOnFalse=needsPhiCopies(l,b,onFalse);
+			// the conditional jump goes to the successor which needs no copies and, if possible, is not the next block
+			if(!copiesOnTrue&&(onFalse==next||copiesOnFalse)){
+				emitJump(l,OP_JT,onTrue);
+				emitPhiCopies(l,b,onFalse);
+				if(onFalse!=next)emitJump(l,OP_JMP,onFalse);
+				}else if(!copiesOnFalse){
+				emitJump(l,OP_JF,onFalse);
+				emitPhiCopies(l,b,onTrue);
+				if(onTrue!=next)emitJump(l,OP_JMP,onTrue);
+				}else{
+				Instr *stub=newInstr(OP_NOP);
+				emit(l,OP_JF)->arg.instr=stub;
+				emitPhiCopies(l,b,onTrue);
+				emitJump(l,OP_JMP,onTrue);
+				l->tail->next=stub;
+				l->tail=stub;
+				emitPhiCopies(l,b,onFalse);
+				if(onFalse!=next)emitJump(l,OP_JMP,onFalse);
+				}
+			}break;
+		default:err("irToVm: invalid terminator %s",opName(t->op));
+		}
+	}
+
+// generates the code of b
+// returns false if a value was spilled; in this case the code of b must be generated again
+static bool emitBlock(Lowering *l,IrBlock *b){
+	l->sp=0;
+	for(IrInstr *i=b->first;i;i=i->next){
+		if(i->kind!=IR_OP||isRemat(i))continue;
+		if(i->line)l->line=i->line;
+		Instr *start;
+		if(!emitOperands(l,i,&start))return false;
+		if(i==b->last){
+			emitTerminator(l,b);
+			break;
+			}
+		Instr *vm=emit(l,i->op);
+		vm->arg=i->arg;
+		if(!i->hasValue){
+			// the stores leave the stored value on stack
+			if(i->op==OP_FPSTORE||(i->op>=OP_STORE_I&&i->op<=OP_COPY))emit(l,OP_DROP);
+			}else if(l->onStack[i->id]){
+			l->stack[l->sp].value=i;
+			l->stack[l->sp++].start=start;
+			}else if(isLocated(l,i)){
+			l->store[i->id]=emitStore(l,i);
+			emit(l,OP_DROP);
+			}else{
+			emit(l,OP_DROP);		// the value is not used
+			}
+		}
+	if(l->sp)err("irToVm: values left on stack at the end of b%d",b->id);
+	return true;
+	}
+
+// true if the local variable or parameter from the given slot is a double
+static bool isDoubleVar(Symbol *fn,int slot){
+	for(Symbol *s=fn->fn.params;s;s=s->next){
+		if(varSlot(s)==slot)return s->type==TID_DOUBLE;
+		}
+	for(Symbol *s=fn->fn.locals;s;s=s->next){
+		if(varSlot(s)==slot)return s->type==TID_DOUBLE;
+		}
+	return false;
+	}
+
+// true if i produces a double, which can be kept in a double register
+// the phis must have isFloat already set
+static bool producesDouble(Lowering *l,IrInstr *i){
+	if(i->kind==IR_PHI)return l->isFloat[i->id];
+	if(i->kind==IR_INIT)return isDoubleVar(l->f->fn,i->arg.i);
+	switch(i->op){
+		case OP_PUSH_F:case OP_LOAD_F:case OP_CONV_I_F:
+		case OP_ADD_F:case OP_SUB_F:case OP_MUL_F:case OP_DIV_F:case OP_NEG_F:
+			return true;
+		case OP_FPLOAD:return isDoubleVar(l->f->fn,i->arg.i);
+		case OP_CALL:case OP_CALL_EXT:return ((Symbol*)i->arg.p)->type==TID_DOUBLE;
+		default:return false;
+		}
+	}
+
+// the loop nesting depth of each block (by id)
+static int *loopDepths(IrFn *f){
+	int *depth=(int*)safeAlloc(f->nBlocks*sizeof(int));
+	bool *body=(bool*)safeAlloc(f->nBlocks*sizeof(bool));
+	memset(depth,0,f->nBlocks*sizeof(int));
+	for(IrBlock *h=f->blocks;h;h=h->next){
+		if(!irLoopBody(f,h,body))continue;
+		for(IrBlock *b=f->blocks;b;b=b->next){
+			if(body[b->id])depth[b->id]++;
+			}
+		}
+	free(body);
+	return depth;
+	}
+
+// a use in a loop counts as 10 uses outside of it
+static double useWeight(int depth){
+	double w=1;
+	while(depth--)w*=10;
+	return w;
+	}
+
+static int cmpIntervals(const void *a,const void *b){
+	const Interval *x=(const Interval*)a,*y=(const Interval*)b;
+	if(x->start!=y->start)return x->start-y->start;
+	return x->value->id-y->value->id;
+	}
+
+// true if a location used until the position "end" is free when the interval cur starts
+// the operands of an instruction can share their locations with its result, because they are read before it is written,
+// but the phis are written at the end of the predecessors, where the values which are live at the block's start are still used
+static bool endsBefore(int end,Interval *cur){
+	return end<cur->start||(end==cur->start&&cur->value->kind!=IR_PHI);
+	}
+
+// a free register which avoids a phi copy: a phi gets the register of one of its operands
+// and a value used by a phi gets the register of that phi
+// returns -1 if there is no such register
+static int hintReg(Lowering *l,IrInstr *v,Interval **owner){
+	if(v->kind==IR_PHI){
+		for(int k=0;k<v->nOps;k++){
+			IrInstr *op=v->ops[k];
+			int r=l->reg[op->id]-1;
+			if(r>=0&&l->isFloat[op->id]==l->isFloat[v->id]&&!owner[r])return r;
+			}
+		}
+	for(int k=0;k<v->nUsers;k++){
+		IrInstr *u=v->users[k];
+		int r=l->reg[u->id]-1;
+		if(u->kind==IR_PHI&&r>=0&&l->isFloat[u->id]==l->isFloat[v->id]&&!owner[r])return r;
+		}
+	return -1;
+	}
+
+// the registers allocation for the values which are not kept on stack
+// the blocks are in reverse postorder, so each value is defined before its uses, except for the phis from the loop headers
+// the instructions get even positions; the phis are defined at the start of their block
+// and the values which are live at the end of a block are used after its terminator
+static void allocate(Lowering *l){
+	IrFn *f=l->f;
+	int nv=f->nValues;
+	IrInstr **values=(IrInstr**)safeAlloc(nv*sizeof(IrInstr*));
+	int *pos=(int*)safeAlloc(nv*sizeof(int));
+	int *blockStart=(int*)safeAlloc(f->nBlocks*sizeof(int));
+	int *blockEnd=(int*)safeAlloc(f->nBlocks*sizeof(int));
+	IrBlock **order=(IrBlock**)safeAlloc(f->nBlocks*sizeof(IrBlock*));
+	int nBlocks=0,p=0;
+	memset(values,0,nv*sizeof(IrInstr*));
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		order[nBlocks++]=b;
+		blockStart[b->id]=p;
+		for(IrInstr *i=b->first;i;i=i->next){
+			values[i->id]=i;
+			pos[i->id]=i->kind==IR_PHI?blockStart[b->id]:(p+=2);
+			}
+		blockEnd[b->id]=p+1;
+		p+=2;
+		}
+
+	// the values classes: the phis are doubles if all their operands are doubles
+	for(int v=0;v<nv;v++){
+		if(values[v])l->isFloat[v]=values[v]->kind==IR_PHI||producesDouble(l,values[v]);
+		}
+	for(bool changed=true;changed;){
+		changed=false;
+		for(int v=0;v<nv;v++){
+			if(!values[v]||values[v]->kind!=IR_PHI||!l->isFloat[v])continue;
+			for(int k=0;k<values[v]->nOps;k++){
+				if(!producesDouble(l,values[v]->ops[k])){
+					l->isFloat[v]=false;
+					changed=true;
+					break;
+					}
+				}
+			}
+		}
+
+	// the liveness: a phi operand is live at the end of the corresponding predecessor
+	bool *liveIn=(bool*)safeAlloc((size_t)f->nBlocks*nv*sizeof(bool));
+	bool *liveOut=(bool*)safeAlloc((size_t)f->nBlocks*nv*sizeof(bool));
+	bool *live=(bool*)safeAlloc(nv*sizeof(bool));
+	memset(liveIn,0,(size_t)f->nBlocks*nv*sizeof(bool));
+	memset(liveOut,0,(size_t)f->nBlocks*nv*sizeof(bool));
+	for(bool changed=true;changed;){
+		changed=false;
+		for(int n=nBlocks-1;n>=0;n--){
+			IrBlock *b=order[n];
+			memset(live,0,nv*sizeof(bool));
+			for(int s=0;s<b->nSuccs;s++){
+				IrBlock *succ=b->succs[s];
+				bool *in=liveIn+(size_t)succ->id*nv;
+				for(int v=0;v<nv;v++)live[v]|=in[v];
+				int k;
+				for(k=0;succ->preds[k]!=b;k++){}
+				for(IrInstr *i=succ->first;i&&i->kind==IR_PHI;i=i->next){
+					if(needsLocation(l,i->ops[k]))live[i->ops[k]->id]=true;
+					}
+				}
+			memcpy(liveOut+(size_t)b->id*nv,live,nv*sizeof(bool));
+			for(IrInstr *i=b->last;i;i=i->prev){
+				live[i->id]=false;
+				if(i->kind==IR_PHI)continue;
+				for(int k=0;k<i->nOps;k++){
+					if(needsLocation(l,i->ops[k]))live[i->ops[k]->id]=true;
+					}
+				}
+			bool *in=liveIn+(size_t)b->id*nv;
+			if(memcmp(in,live,nv*sizeof(bool))){
+				memcpy(in,live,nv*sizeof(bool));
+				changed=true;
+				}
+			}
+		}
+
+	// the intervals
+	Interval *intervals=(Interval*)safeAlloc((nv+1)*sizeof(Interval));
+	int *depth=loopDepths(f);
+	int n=0;
+	for(int v=0;v<nv;v++){
+		IrInstr *i=values[v];
+		if(!i||!needsLocation(l,i))continue;
+		Interval *iv=&intervals[n++];
+		iv->value=i;
+		iv->start=iv->end=pos[v];
+		double w=useWeight(depth[i->block->id]);
+		for(int k=0;k<i->nUsers;k++){
+			IrInstr *u=i->users[k];
+			w+=useWeight(depth[u->block->id]);
+			if(u->kind!=IR_PHI&&pos[u->id]>iv->end)iv->end=pos[u->id];
+			}
+		for(int b=0;b<nBlocks;b++){
+			int id=order[b]->id;
+			if(liveIn[(size_t)id*nv+v]&&blockStart[id]<iv->start)iv->start=blockStart[id];
+			if(liveOut[(size_t)id*nv+v]&&blockEnd[id]>iv->end)iv->end=blockEnd[id];
+			}
+		iv->weight=w/(iv->end-iv->start+1);
+		}
+	qsort(intervals,n,sizeof(Interval),cmpIntervals);
+
+	// the linear scan, separately for each registers file
+	Interval *intOwner[VM_INT_REGS]={NULL},*floatOwner[VM_FLOAT_REGS]={NULL};
+	bool intUsed[VM_INT_REGS]={false},floatUsed[VM_FLOAT_REGS]={false};
+	for(int k=0;k<n;k++){
+		Interval *cur=&intervals[k];
+		bool isFloat=l->isFloat[cur->value->id];
+		Interval **owner=isFloat?floatOwner:intOwner;
+		bool *used=isFloat?floatUsed:intUsed;
+		int nRegs=isFloat?VM_FLOAT_REGS:VM_INT_REGS;
+		for(int r=0;r<nRegs;r++){
+			if(owner[r]&&endsBefore(owner[r]->end,cur))owner[r]=NULL;
+			}
+		int r=hintReg(l,cur->value,owner);
+		for(int q=0;q<nRegs&&r<0;q++){
+			if(!owner[q])r=q;
+			}
+		if(r<0){
+			// the value with the lowest spill cost goes to a slot
+			int victim=0;
+			for(int q=1;q<nRegs;q++){
+				if(owner[q]->weight<owner[victim]->weight)victim=q;
+				}
+			if(owner[victim]->weight<cur->weight){
+				l->reg[owner[victim]->value->id]=0;
+				r=victim;
+				}
+			}
+		if(r<0)continue;
+		owner[r]=cur;
+		used[r]=true;
+		l->reg[cur->value->id]=r+1;
+		}
+
+	// the spilled values share the slots, by a second linear scan
+	int *slotEnd=(int*)safeAlloc((n+1)*sizeof(int));
+	int nSpillSlots=0;
+	for(int k=0;k<n;k++){
+		Interval *cur=&intervals[k];
+		if(l->reg[cur->value->id])continue;
+		int s;
+		for(s=0;s<nSpillSlots&&!endsBefore(slotEnd[s],cur);s++){}
+		if(s==nSpillSlots)nSpillSlots++;
+		slotEnd[s]=cur->end;
+		l->slot[cur->value->id]=f->frameSlots+1+s;
+		}
+	l->nSlots=nSpillSlots;
+	for(int r=0;r<VM_INT_REGS;r++){
+		if(intUsed[r])l->intSave[r]=f->frameSlots+ ++l->nSlots;
+		}
+	for(int r=0;r<VM_FLOAT_REGS;r++){
+		if(floatUsed[r])l->floatSave[r]=f->frameSlots+ ++l->nSlots;
+		}
+
+	free(values);
+	free(pos);
+	free(blockStart);
+	free(blockEnd);
+	free(order);
+	free(liveIn);
+	free(liveOut);
+	free(live);
+	free(intervals);
+	free(depth);
+	free(slotEnd);
+	}
+
+void irToVm(IrFn *f){
+	// the operands are resolved, so the copies are not used anymore
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next){
+			for(int k=0;k<i->nOps;k++)i->ops[k]=irResolve(i->ops[k]);
+			}
+		}
+	irRemoveUnreachable(f);
+	irDominators(f);
+	f->usersValid=false;
+	irBuildUsers(f);
+	Lowering l;
+	memset(&l,0,sizeof(l));
+	l.f=f;
+	l.labels=(Instr**)safeAlloc(f->nBlocks*sizeof(Instr*));
+	l.slot=(int*)safeAlloc(f->nValues*sizeof(int));
+	l.reg=(int*)safeAlloc(f->nValues*sizeof(int));
+	l.isFloat=(bool*)safeAlloc(f->nValues*sizeof(bool));
+	l.onStack=(bool*)safeAlloc(f->nValues*sizeof(bool));
+	l.store=(Instr**)safeAlloc(f->nValues*sizeof(Instr*));
+	l.stack=(StackEntry*)safeAlloc((f->nValues+1)*sizeof(StackEntry));
+	memset(l.slot,0,f->nValues*sizeof(int));
+	memset(l.reg,0,f->nValues*sizeof(int));
+	memset(l.isFloat,0,f->nValues*sizeof(bool));
+	memset(l.onStack,0,f->nValues*sizeof(bool));
+	memset(l.store,0,f->nValues*sizeof(Instr*));
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		l.labels[b->id]=newInstr(OP_NOP);
+		for(IrInstr *i=b->first;i;i=i->next){
+			if(i->kind!=IR_OP||!i->hasValue||isRemat(i)||i->nUsers!=1)continue;
+			IrInstr *user=i->users[0];
+			if(user->block==b&&user->kind==IR_OP)l.onStack[i->id]=true;
+			}
+		}
+	allocate(&l);
+	Instr *enter=newInstr(OP_ENTER);
+	l.line=enter->line=f->fn->fn.instr->line;
+	l.list=l.tail=enter;
+	emitSaves(&l);
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next){
+			if(i->line){
+				l.line=i->line;
+				break;
+				}
+			}
+		l.labels[b->id]->line=l.line;
+		l.tail->next=l.labels[b->id];
+		l.tail=l.labels[b->id];
+		while(!emitBlock(&l,b)){
+			// the block is generated again, with the spilled value stored
+			delInstrAfter(l.labels[b->id]);
+			l.tail=l.labels[b->id];
+			for(IrInstr *i=b->first;i;i=i->next)l.store[i->id]=NULL;
+			}
+		}
+	enter->arg.i=f->frameSlots+l.nSlots;
+	freeInstrs(f->fn->fn.instr);
+	f->fn->fn.instr=l.list;
+	free(l.labels);
+	free(l.slot);
+	free(l.reg);
+	free(l.isFloat);
+	free(l.onStack);
+	free(l.store);
+	free(l.stack);
+	}
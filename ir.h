@@ -0,0 +1,129 @@
+#pragma once
+
+// the SSA intermediate representation
+// the IR of a function is built from its VM code: the stack is simulated, so each IR instruction
+// has explicit operands, and the scalar locals and parameters whose address is never taken
+// (the slots accessed only with FPLOAD/FPSTORE) become SSA values
+// the operations keep their VM opcode, so the IR can be lowered back to VM code by irToVm
+
+#include <stdbool.h>
+
+#include "ad.h"
+#include "vm.h"
+
+typedef enum{
+	IR_OP,		// a VM operation (op and arg) with the operands in ops
+	IR_PHI,		// ops[k] is the value which comes from block->preds[k]
+	IR_COPY,		// the same value as ops[0]
+	IR_INIT		// the value of the variable from slot arg.i at the function's entry
+	}IrKind;
+
+typedef struct IrInstr IrInstr;
+typedef struct IrBlock IrBlock;
+
+struct IrInstr{
+	IrKind kind;
+	Opcode op;		// for IR_OP
+	InstrArg arg;		// the same as the VM instruction's arg, for IR_OP and IR_INIT
+	int line;		// the source line of the VM instruction, or 0 if it is not known
+	IrInstr **ops;		// the operands, in the order in which the VM pushes them
+	int nOps;
+	int opsCap;
+	bool hasValue;		// false for stores, jumps and calls of void functions
+	int id;		// the value number, used in dumps
+	IrBlock *block;
+	IrInstr *prev,*next;		// in block
+	IrInstr **users;		// set by irBuildUsers
+	int nUsers;
+	};
+
+// a basic block
+// the last instruction is the terminator: OP_JMP, OP_JT (ops[0] is the condition: succs[0] if true, else succs[1]),
+// OP_RET or OP_RET_VOID
+struct IrBlock{
+	int id;
+	IrInstr *first,*last;
+	IrBlock **preds;
+	int nPreds;
+	int predsCap;
+	IrBlock *succs[2];
+	int nSuccs;
+	IrBlock *idom;		// the immediate dominator, set by irDominators
+	int rpo;		// the position in reverse postorder, set by irDominators
+	IrBlock *next;		// in function
+	};
+
+typedef struct{
+	Symbol *fn;
+	IrBlock *blocks;		// the first block is the entry
+	int nBlocks;		// the number of created blocks, used for the blocks ids
+	int nValues;		// the number of created instructions, used for the instructions ids
+	int frameSlots;		// the slots for locals from ENTER
+	bool usersValid;		// true if the users lists are up to date
+	}IrFn;
+
+// the limits of the functions which are built in the IR
+// the recursive walks of the blocks (dfs, the SSA construction, the dominator tree) are bounded by IR_MAX_BLOCKS,
+// and the definitions of the variables in each block, which irBuild keeps in a table, by IR_MAX_DEFS
+#define IR_MAX_BLOCKS 10000
+#define IR_MAX_DEFS (1<<24)
+
+// builds the SSA form of fn's VM code
+// returns NULL if the code uses features which are not represented in the IR (struct arguments)
+// or if it is larger than the limits above; then fn keeps its VM code
+IrFn *irBuild(Symbol *fn);
+void irFree(IrFn *f);
+// replaces fn->fn.instr with the VM code generated from f
+// the SSA values which cannot stay on the VM stack get registers or, when the registers run out, frame slots
+void irToVm(IrFn *f);
+// shows the IR, one instruction per line
+void irDump(IrFn *f);
+
+// creates an instruction, which is not in any block
+IrInstr *irNewInstr(IrFn *f,IrKind kind,Opcode op);
+void irAddOperand(IrInstr *i,IrInstr *op);
+// inserts i before the instruction "before" from block b or at the end of b if before is NULL
+// if i has no line, it gets the line of its neighbour
+void irInsert(IrBlock *b,IrInstr *before,IrInstr *i);
+// removes i from its block, without freeing it
+void irUnlink(IrInstr *i);
+// removes i from its block and frees it
+// i must not be used anymore
+void irDelete(IrInstr *i);
+// makes i a copy of value, so all its users will use value (after irResolve or the copies propagation)
+void irReplace(IrInstr *i,IrInstr *value);
+// follows the chain of copies and returns the copied value
+IrInstr *irResolve(IrInstr *i);
+// removes the k-th predecessor of b, together with the corresponding phi operands
+void irRemovePred(IrBlock *b,int k);
+// removes the unreachable blocks and the edges from them
+// returns the number of removed blocks
+int irRemoveUnreachable(IrFn *f);
+// merges each block which ends with OP_JMP with its successor, if that successor has no other predecessors
+// returns the number of merged blocks
+int irMergeBlocks(IrFn *f);
+// sets users and nUsers for all the instructions
+void irBuildUsers(IrFn *f);
+// sets idom and rpo for all the blocks
+// the blocks are also put in reverse postorder
+void irDominators(IrFn *f);
+// returns true if block a dominates block b
+bool irDominates(IrBlock *a,IrBlock *b);
+// sets in body (by block id) the blocks of the natural loop with the header h: the blocks which reach
+// a back edge to h (an edge from a block dominated by h) without passing through h
+// the dominators must be up to date
+// returns false if h is not a loop header
+bool irLoopBody(IrFn *f,IrBlock *h,bool *body);
+// inserts a new block on the edge from b to b->succs[k], which only jumps to that successor
+// the dominators must be computed again
+IrBlock *irSplitEdge(IrFn *f,IrBlock *b,int k);
+
+// the effects of an instruction, for the passes which move or remove instructions
+typedef enum{
+	IR_PURE,		// it only depends on its operands
+	IR_READ,		// it reads the memory
+	IR_CHECK,		// it can stop the program, but it does not use the memory, so it is not moved or removed, but the reads can pass it
+	IR_WRITE		// it writes the memory, calls a function, can fail or ends the block
+	}IrEffect;
+
+IrEffect irEffect(IrInstr *i);
@@ -0,0 +1,1018 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <time.h>
+
+#include "irpass.h"
+#include "utils.h"
+
+static void resolveOperands(IrInstr *i){
+	for(int k=0;k<i->nOps;k++)i->ops[k]=irResolve(i->ops[k]);
+	}
+
+static bool isConst(IrInstr *i){
+	return i->kind==IR_OP&&(i->op==OP_PUSH_I||i->op==OP_PUSH_F);
+	}
+
+// the values which are generated again at each use, so it is useless to search them for equivalents
+static bool isRemat(IrInstr *i){
+	return i->kind==IR_INIT||(i->kind==IR_OP&&(i->op==OP_PUSH_I||i->op==OP_PUSH_F||i->op==OP_PUSH_A||i->op==OP_FPADDR));
+	}
+
+static int copyProp(IrFn *f){
+	for(bool again=true;again;){
+		again=false;
+		for(IrBlock *b=f->blocks;b;b=b->next){
+			for(IrInstr *i=b->first;i;i=i->next){
+				resolveOperands(i);
+				if(i->kind!=IR_PHI)continue;
+				// a phi is trivial if all its operands are the same value or the phi itself
+				IrInstr *same=NULL;
+				int k;
+				for(k=0;k<i->nOps;k++){
+					if(i->ops[k]==i||i->ops[k]==same)continue;
+					if(same)break;
+					same=i->ops[k];
+					}
+				if(k==i->nOps&&same){
+					irReplace(i,same);
+					again=true;
+					}
+				}
+			}
+		}
+	int removed=0;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first,*next;i;i=next){
+			next=i->next;
+			if(i->kind==IR_COPY){
+				irDelete(i);
+				removed++;
+				}
+			}
+		}
+	return removed;
+	}
+
+// sparse conditional constant propagation
+// Wegman, Zadeck: "Constant Propagation with Conditional Branches"
+typedef enum{LAT_TOP,LAT_CONST,LAT_BOTTOM}LatKind;
+
+typedef struct{
+	LatKind kind;
+	Opcode push;		// for LAT_CONST: OP_PUSH_I or OP_PUSH_F
+	Val v;
+	}Lattice;
+
+typedef struct{
+	Lattice *lat;		// by instruction id
+	bool *execBlock;		// by block id
+	bool **execEdge;		// by block id, for each predecessor of the block
+	IrBlock **blockWork;
+	int nBlockWork;
+	IrInstr **ssaWork;
+	int nSsaWork;
+	int ssaWorkCap;
+	}Sccp;
+
+static bool sameLattice(Lattice *a,Lattice *b){
+	if(a->kind!=b->kind)return false;
+	if(a->kind!=LAT_CONST)return true;
+	if(a->push!=b->push)return false;
+	if(a->push==OP_PUSH_I)return a->v.i==b->v.i;
+	return !memcmp(&a->v.f,&b->v.f,sizeof(double));
+	}
+
+// the lattice of a value from the constant c
+static Lattice constLattice(Opcode push,InstrArg arg){
+	Lattice l={LAT_CONST,push,{0}};
+	if(push==OP_PUSH_I)l.v.i=arg.i;
+	else l.v.f=arg.f;
+	return l;
+	}
+
+static void meet(Lattice *l,Lattice *other){
+	if(other->kind==LAT_TOP||l->kind==LAT_BOTTOM)return;
+	if(l->kind==LAT_TOP)*l=*other;
+	else if(!sameLattice(l,other))l->kind=LAT_BOTTOM;
+	}
+
+static Lattice evaluate(Sccp *s,IrInstr *i){
+	Lattice r={LAT_BOTTOM,OP_NOP,{0}};
+	switch(i->kind){
+		case IR_PHI:
+			r.kind=LAT_TOP;
+			for(int k=0;k<i->nOps;k++){
+				if(s->execEdge[i->block->id][k])meet(&r,&s->lat[i->ops[k]->id]);
+				}
+			return r;
+		case IR_COPY:return s->lat[i->ops[0]->id];
+		case IR_INIT:return r;
+		case IR_OP:{
+			if(isConst(i))return constLattice(i->op,i->arg);
+			if(irEffect(i)!=IR_PURE||i->nOps==0||i->nOps>2)return r;
+			Val args[2];
+			bool top=false;
+			for(int k=0;k<i->nOps;k++){
+				Lattice *l=&s->lat[i->ops[k]->id];
+				if(l->kind==LAT_BOTTOM)return r;
+				if(l->kind==LAT_TOP)top=true;
+				else args[k]=l->v;
+				}
+			if(top){
+				r.kind=LAT_TOP;
+				return r;
+				}
+			Val v;
+			Opcode push=vmEval(i->op,args,&v);
+			if(push!=OP_NOP){
+				r.kind=LAT_CONST;
+				r.push=push;
+				r.v=v;
+				}
+			return r;
+			}
+		}
+	return r;
+	}
+
+static void visit(Sccp *s,IrInstr *i);
+
+static void markEdge(Sccp *s,IrBlock *b,IrBlock *succ){
+	bool newEdge=false;
+	for(int k=0;k<succ->nPreds;k++){
+		if(succ->preds[k]==b&&!s->execEdge[succ->id][k]){
+			s->execEdge[succ->id][k]=true;
+			newEdge=true;
+			}
+		}
+	if(!newEdge)return;
+	if(!s->execBlock[succ->id]){
+		s->execBlock[succ->id]=true;
+		s->blockWork[s->nBlockWork++]=succ;
+		}else{
+		// only the phis depend on the edges
+		for(IrInstr *i=succ->first;i&&i->kind==IR_PHI;i=i->next)visit(s,i);
+		}
+	}
+
+static void visit(Sccp *s,IrInstr *i){
+	IrBlock *b=i->block;
+	if(i==b->last){
+		if(i->op==OP_JT){
+			Lattice *cond=&s->lat[i->ops[0]->id];
+			if(cond->kind==LAT_CONST)markEdge(s,b,b->succs[cond->v.i?0:1]);
+			else if(cond->kind==LAT_BOTTOM){
+				markEdge(s,b,b->succs[0]);
+				markEdge(s,b,b->succs[1]);
+				}
+			}else if(i->op==OP_JMP){
+			markEdge(s,b,b->succs[0]);
+			}
+		return;
+		}
+	if(!i->hasValue)return;
+	Lattice l=evaluate(s,i);
+	if(sameLattice(&l,&s->lat[i->id]))return;
+	s->lat[i->id]=l;
+	for(int k=0;k<i->nUsers;k++){
+		if(s->nSsaWork==s->ssaWorkCap){
+			s->ssaWorkCap=s->ssaWorkCap?s->ssaWorkCap*2:64;
+			s->ssaWork=(IrInstr**)realloc(s->ssaWork,s->ssaWorkCap*sizeof(IrInstr*));
+			if(!s->ssaWork)err("not enough memory");
+			}
+		s->ssaWork[s->nSsaWork++]=i->users[k];
+		}
+	}
+
+// replaces the value of i with the constant from l
+static void setConst(IrFn *f,IrInstr *i,Lattice *l){
+	IrInstr *c=i;
+	if(i->kind==IR_PHI){
+		// the phis must remain at the beginning of the block
+		IrInstr *before=i;
+		while(before->kind==IR_PHI)before=before->next;
+		c=irNewInstr(f,IR_OP,OP_NOP);
+		irInsert(i->block,before,c);
+		irReplace(i,c);
+		}
+	c->kind=IR_OP;
+	c->op=l->push;
+	c->nOps=0;
+	memset(&c->arg,0,sizeof(c->arg));
+	if(l->push==OP_PUSH_I)c->arg.i=l->v.i;
+	else c->arg.f=l->v.f;
+	}
+
+static int sccp(IrFn *f){
+	irBuildUsers(f);
+	Sccp s;
+	memset(&s,0,sizeof(s));
+	s.lat=(Lattice*)safeAlloc(f->nValues*sizeof(Lattice));
+	s.execBlock=(bool*)safeAlloc(f->nBlocks*sizeof(bool));
+	s.execEdge=(bool**)safeAlloc(f->nBlocks*sizeof(bool*));
+	s.blockWork=(IrBlock**)safeAlloc(f->nBlocks*sizeof(IrBlock*));
+	memset(s.lat,0,f->nValues*sizeof(Lattice));		// LAT_TOP
+	memset(s.execBlock,0,f->nBlocks*sizeof(bool));
+	memset(s.execEdge,0,f->nBlocks*sizeof(bool*));
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		s.execEdge[b->id]=(bool*)safeAlloc((b->nPreds+1)*sizeof(bool));
+		memset(s.execEdge[b->id],0,(b->nPreds+1)*sizeof(bool));
+		}
+	s.execBlock[f->blocks->id]=true;
+	s.blockWork[s.nBlockWork++]=f->blocks;
+	while(s.nBlockWork||s.nSsaWork){
+		if(s.nBlockWork){
+			IrBlock *b=s.blockWork[--s.nBlockWork];
+			for(IrInstr *i=b->first;i;i=i->next)visit(&s,i);
+			}else{
+			IrInstr *i=s.ssaWork[--s.nSsaWork];
+			if(s.execBlock[i->block->id])visit(&s,i);
+			}
+		}
+	int changes=0;
+	int nValues=f->nValues;		// the constants for phis are added after that
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		if(!s.execBlock[b->id])continue;
+		for(IrInstr *i=b->first;i;i=i->next){
+			if(i->id>=nValues||!i->hasValue||isConst(i))continue;
+			if(s.lat[i->id].kind==LAT_CONST){
+				setConst(f,i,&s.lat[i->id]);
+				changes++;
+				}
+			}
+		IrInstr *t=b->last;
+		if(t->op==OP_JT&&s.lat[t->ops[0]->id].kind==LAT_CONST){
+			// only one of the successors remains
+			int taken=s.lat[t->ops[0]->id].v.i?0:1;
+			IrBlock *other=b->succs[1-taken];
+			for(int k=0;k<other->nPreds;k++){
+				if(other->preds[k]==b){
+					irRemovePred(other,k);
+					break;
+					}
+				}
+			b->succs[0]=b->succs[taken];
+			b->nSuccs=1;
+			t->op=OP_JMP;
+			t->nOps=0;
+			changes++;
+			}
+		}
+	changes+=irRemoveUnreachable(f);
+	for(int k=0;k<f->nBlocks;k++)free(s.execEdge[k]);
+	changes+=irMergeBlocks(f);
+	free(s.lat);
+	free(s.execBlock);
+	free(s.execEdge);
+	free(s.blockWork);
+	free(s.ssaWork);
+	return changes;
+	}
+
+// the expressions, for CSE and GVN
+static bool isCommutative(Opcode op){
+	switch(op){
+		case OP_ADD_I:case OP_ADD_F:case OP_MUL_I:case OP_MUL_F:
+		case OP_EQUAL_I:case OP_EQUAL_F:case OP_NOTEQ_I:case OP_NOTEQ_F:
+			return true;
+		default:return false;
+		}
+	}
+
+// the constants and the other values generated at each use are compared by their op and arg,
+// so the same constant from different places is the same operand
+static unsigned operandKey(IrInstr *v){
+	if(!isRemat(v))return (unsigned)v->id*2u;
+	unsigned h=v->kind*31u+v->op;
+	unsigned char bytes[sizeof(InstrArg)];
+	memcpy(bytes,&v->arg,sizeof(InstrArg));
+	for(size_t k=0;k<sizeof(InstrArg);k++)h=h*31u+bytes[k];
+	return h*2u+1u;
+	}
+
+static bool sameOperand(IrInstr *a,IrInstr *b){
+	if(a==b)return true;
+	if(!a||!b||!isRemat(a)||!isRemat(b))return false;
+	return a->kind==b->kind&&a->op==b->op&&!memcmp(&a->arg,&b->arg,sizeof(InstrArg));
+	}
+
+// the operands of a commutative operation are compared in the order of their keys
+static void exprOperands(IrInstr *i,IrInstr **a,IrInstr **b){
+	*a=i->nOps>0?i->ops[0]:NULL;
+	*b=i->nOps>1?i->ops[1]:NULL;
+	if(i->kind==IR_OP&&isCommutative(i->op)&&operandKey(*a)>operandKey(*b)){
+		IrInstr *t=*a;
+		*a=*b;
+		*b=t;
+		}
+	}
+
+static unsigned exprHash(IrInstr *i){
+	unsigned h=i->kind*31u+i->op;
+	unsigned char bytes[sizeof(InstrArg)];
+	memcpy(bytes,&i->arg,sizeof(InstrArg));
+	for(size_t k=0;k<sizeof(InstrArg);k++)h=h*31u+bytes[k];
+	if(i->kind==IR_PHI){
+		h=h*31u+i->block->id;
+		for(int k=0;k<i->nOps;k++)h=h*31u+operandKey(i->ops[k]);
+		}else{
+		IrInstr *a,*b;
+		exprOperands(i,&a,&b);
+		if(a)h=h*31u+operandKey(a);
+		if(b)h=h*31u+operandKey(b);
+		}
+	return h^(h>>16);
+	}
+
+static bool sameExpr(IrInstr *x,IrInstr *y){
+	if(x->kind!=y->kind||x->op!=y->op||x->nOps!=y->nOps)return false;
+	if(memcmp(&x->arg,&y->arg,sizeof(InstrArg)))return false;
+	if(x->kind==IR_PHI){
+		if(x->block!=y->block)return false;
+		for(int k=0;k<x->nOps;k++){
+			if(!sameOperand(x->ops[k],y->ops[k]))return false;
+			}
+		return true;
+		}
+	IrInstr *xa,*xb,*ya,*yb;
+	exprOperands(x,&xa,&xb);
+	exprOperands(y,&ya,&yb);
+	return sameOperand(xa,ya)&&sameOperand(xb,yb);
+	}
+
+static int tableCap(IrFn *f){
+	int cap=16;
+	while(cap<f->nValues*2)cap*=2;
+	return cap;
+	}
+
+// a table entry of the local CSE
+// the entries of other blocks are considered empty and the reads from older memory epochs are not valid
+typedef struct{
+	IrInstr *instr;
+	int block;
+	int epoch;		// it is incremented at each write in the block
+	}CseEntry;
+
+static int cse(IrFn *f){
+	int cap=tableCap(f),changes=0;
+	CseEntry *table=(CseEntry*)safeAlloc(cap*sizeof(CseEntry));
+	for(int k=0;k<cap;k++)table[k].instr=NULL;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		int epoch=0;
+		for(IrInstr *i=b->first;i;i=i->next){
+			resolveOperands(i);
+			IrEffect effect=irEffect(i);
+			if(effect==IR_WRITE){
+				epoch++;
+				continue;
+				}
+			// the repeated bounds checks are removed by bce, which also knows the checks from the dominators
+			if(effect==IR_CHECK)continue;
+			if(i->kind!=IR_OP||!i->hasValue||isRemat(i))continue;
+			unsigned h=exprHash(i)&(cap-1);
+			for(;;h=(h+1)&(cap-1)){
+				CseEntry *e=&table[h];
+				if(!e->instr||e->block!=b->id){
+					*e=(CseEntry){i,b->id,epoch};
+					break;
+					}
+				if(sameExpr(e->instr,i)){
+					if(effect==IR_PURE||e->epoch==epoch){
+						irReplace(i,e->instr);
+						changes++;
+						}else{
+						*e=(CseEntry){i,b->id,epoch};
+						}
+					break;
+					}
+				}
+			}
+		}
+	free(table);
+	return changes;
+	}
+
+// the scoped hash table of the GVN
+// the entries added in a dominator subtree are removed in reverse order when the walk leaves the subtree
+typedef struct{
+	IrInstr **table;
+	int cap;
+	int *undo;		// the positions of the added entries
+	int nUndo;
+	IrBlock ***children;		// the children of each block in the dominator tree
+	int *nChildren;
+	int changes;
+	}Gvn;
+
+static void gvnBlock(Gvn *g,IrBlock *b){
+	int mark=g->nUndo;
+	for(IrInstr *i=b->first;i;i=i->next){
+		resolveOperands(i);
+		bool pure=i->kind==IR_OP&&i->hasValue&&irEffect(i)==IR_PURE&&!isRemat(i);
+		if(!pure&&i->kind!=IR_PHI)continue;
+		unsigned h=exprHash(i)&(g->cap-1);
+		for(;g->table[h];h=(h+1)&(g->cap-1)){
+			if(sameExpr(g->table[h],i))break;
+			}
+		if(g->table[h]){
+			irReplace(i,g->table[h]);
+			g->changes++;
+			}else{
+			g->table[h]=i;
+			g->undo[g->nUndo++]=h;
+			}
+		}
+	for(int k=0;k<g->nChildren[b->id];k++)gvnBlock(g,g->children[b->id][k]);
+	while(g->nUndo>mark)g->table[g->undo[--g->nUndo]]=NULL;
+	}
+
+static int gvn(IrFn *f){
+	irDominators(f);
+	Gvn g;
+	g.cap=tableCap(f);
+	g.table=(IrInstr**)safeAlloc(g.cap*sizeof(IrInstr*));
+	memset(g.table,0,g.cap*sizeof(IrInstr*));
+	g.undo=(int*)safeAlloc(f->nValues*sizeof(int));
+	g.nUndo=0;
+	g.children=(IrBlock***)safeAlloc(f->nBlocks*sizeof(IrBlock**));
+	g.nChildren=(int*)safeAlloc(f->nBlocks*sizeof(int));
+	memset(g.nChildren,0,f->nBlocks*sizeof(int));
+	for(IrBlock *b=f->blocks->next;b;b=b->next)g.nChildren[b->idom->id]++;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		g.children[b->id]=(IrBlock**)safeAlloc((g.nChildren[b->id]+1)*sizeof(IrBlock*));
+		g.nChildren[b->id]=0;
+		}
+	for(IrBlock *b=f->blocks->next;b;b=b->next)g.children[b->idom->id][g.nChildren[b->idom->id]++]=b;
+	g.changes=0;
+	gvnBlock(&g,f->blocks);
+	for(IrBlock *b=f->blocks;b;b=b->next)free(g.children[b->id]);
+	free(g.table);
+	free(g.undo);
+	free(g.children);
+	free(g.nChildren);
+	return g.changes;
+	}
+
+// bounds checks elimination
+// a check of the index v against the dimension n is removed if 0<=v<n is proven at the check:
+// - by an earlier check of v, against a dimension which is not greater, from the same block or from a dominator
+// - by the range of v: the range of its definition (constants, checks, additions of constants and the induction
+// variables of the loops), restricted by the conditions of the dominating branches (while(i<10) or if(i>=0))
+// the ranges are computed on demand, up to a limited depth of the definitions, so they are not always the tightest
+#define BCE_DEPTH 3
+
+typedef struct{
+	long long lo,hi;
+	}Range;
+
+typedef struct{
+	int *checked;		// by value id: the smallest dimension for which the value is checked on this dominator path, or 0
+	int *undo;		// pairs of (value id, old checked)
+	int nUndo;
+	IrBlock ***children;		// the children of each block in the dominator tree
+	int *nChildren;
+	int changes;
+	}Bce;
+
+static Range fullRange(){
+	return (Range){INT_MIN,INT_MAX};
+	}
+
+static Range rangeAt(IrInstr *v,IrBlock *at,int depth);
+
+// a constant operand of an addition or subtraction, as the added value
+static bool constTerm(IrInstr *i,int k,long long *c){
+	IrInstr *op=irResolve(i->ops[k]);
+	if(!isConst(op)||op->op!=OP_PUSH_I)return false;
+	*c=i->op==OP_SUB_I?-(long long)op->arg.i:op->arg.i;
+	return true;
+	}
+
+// if i is v+c or v-c, returns c in *c
+static bool isStep(IrInstr *i,IrInstr *v,long long *c){
+	if(i->kind!=IR_OP||(i->op!=OP_ADD_I&&i->op!=OP_SUB_I))return false;
+	if(irResolve(i->ops[0])==v&&constTerm(i,1,c))return true;
+	return i->op==OP_ADD_I&&irResolve(i->ops[1])==v&&constTerm(i,0,c);
+	}
+
+// the range of a phi which is an induction variable: it only changes by v=v+c, with all the steps c of the same sign
+// an increasing variable keeps the lowest initial value as lower bound, if its steps cannot overflow
+static Range phiRange(IrInstr *v,int depth){
+	Range r=fullRange();
+	bool up=true,down=true;
+	long long lo=INT_MAX,hi=INT_MIN;
+	for(int k=0;k<v->nOps;k++){
+		IrInstr *op=irResolve(v->ops[k]);
+		long long c;
+		if(op==v)continue;
+		if(isStep(op,v,&c)){
+			// the value stepped from must not overflow
+			Range before=rangeAt(v,op->block,depth+1);
+			if(c>=0)down=false;
+			if(c<=0)up=false;
+			if(before.hi+c>INT_MAX||before.lo+c<INT_MIN)up=down=false;
+			continue;
+			}
+		Range init=rangeAt(op,v->block->preds[k],depth+1);
+		if(init.lo<lo)lo=init.lo;
+		if(init.hi>hi)hi=init.hi;
+		}
+	if(lo>hi)return r;
+	if(up)r.lo=lo;
+	if(down)r.hi=hi;
+	return r;
+	}
+
+// the range of v from its definition
+static Range defRange(IrInstr *v,int depth){
+	Range r=fullRange();
+	long long c;
+	if(v->kind==IR_PHI)return phiRange(v,depth);
+	if(v->kind!=IR_OP)return r;
+	switch(v->op){
+		case OP_PUSH_I:
+			r.lo=r.hi=v->arg.i;
+			return r;
+		case OP_CHECK:
+			r.lo=0;
+			r.hi=v->arg.i-1;
+			return r;
+		case OP_ADD_I:case OP_SUB_I:{
+			IrInstr *x;
+			if(constTerm(v,1,&c))x=irResolve(v->ops[0]);
+			else if(v->op==OP_ADD_I&&constTerm(v,0,&c))x=irResolve(v->ops[1]);
+			else return r;
+			Range rx=rangeAt(x,v->block,depth+1);
+			// on overflow the result wraps, so its range is not known
+			if(rx.lo+c<INT_MIN||rx.hi+c>INT_MAX)return r;
+			r.lo=rx.lo+c;
+			r.hi=rx.hi+c;
+			return r;
+			}
+		default:
+			return r;
+		}
+	}
+
+// restricts r with the relation "v op other" (op is a comparison of ints)
+static void narrow(Range *r,Opcode op,Range other){
+	switch(op){
+		case OP_LESS_I:if(other.hi-1<r->hi)r->hi=other.hi-1;break;
+		case OP_LESSEQ_I:if(other.hi<r->hi)r->hi=other.hi;break;
+		case OP_GREATER_I:if(other.lo+1>r->lo)r->lo=other.lo+1;break;
+		case OP_GREATEREQ_I:if(other.lo>r->lo)r->lo=other.lo;break;
+		case OP_EQUAL_I:
+			if(other.hi<r->hi)r->hi=other.hi;
+			if(other.lo>r->lo)r->lo=other.lo;
+			break;
+		default:break;
+		}
+	}
+
+// the relation "other op v" written as "v op other"; negated is for the false branch
+static Opcode relation(Opcode op,bool swapped,bool negated){
+	static const Opcode swap[]={OP_GREATER_I,OP_GREATEREQ_I,OP_LESS_I,OP_LESSEQ_I,OP_EQUAL_I,OP_NOTEQ_I};
+	static const Opcode negate[]={OP_GREATEREQ_I,OP_GREATER_I,OP_LESSEQ_I,OP_LESS_I,OP_NOTEQ_I,OP_EQUAL_I};
+	static const Opcode ops[]={OP_LESS_I,OP_LESSEQ_I,OP_GREATER_I,OP_GREATEREQ_I,OP_EQUAL_I,OP_NOTEQ_I};
+	for(int pass=0;pass<2;pass++){
+		bool apply=pass==0?swapped:negated;
+		if(!apply)continue;
+		for(int k=0;k<6;k++){
+			if(ops[k]==op){
+				op=pass==0?swap[k]:negate[k];
+				break;
+				}
+			}
+		}
+	return op;
+	}
+
+static Range intersect(Range a,Range b){
+	if(b.lo>a.lo)a.lo=b.lo;
+	if(b.hi<a.hi)a.hi=b.hi;
+	return a;
+	}
+
+// the range of v when the condition cond, computed in the block p, is true or false
+// the value of && or || is a phi of the values from its operands' blocks: v is in the union of its ranges from
+// the phi's predecessors which can give that value
+static Range condRange(IrInstr *v,IrInstr *cond,bool truth,IrBlock *p,int depth){
+	Range r=fullRange();
+	if(depth>BCE_DEPTH)return r;
+	if(cond->kind==IR_PHI){
+		if(cond->block==v->block)return r;
+		long long lo=INT_MAX,hi=INT_MIN;
+		for(int k=0;k<cond->nOps;k++){
+			IrInstr *op=irResolve(cond->ops[k]);
+			IrBlock *pred=cond->block->preds[k];
+			Range rk;
+			if(isConst(op)){
+				if(op->op!=OP_PUSH_I||(op->arg.i!=0)!=truth)continue;
+				rk=rangeAt(v,pred,depth+1);
+				}else{
+				rk=intersect(rangeAt(v,pred,depth+1),condRange(v,op,truth,pred,depth+1));
+				}
+			if(rk.lo<lo)lo=rk.lo;
+			if(rk.hi>hi)hi=rk.hi;
+			}
+		if(lo<=hi){
+			r.lo=lo;
+			r.hi=hi;
+			}
+		return r;
+		}
+	if(cond->kind!=IR_OP||cond->nOps!=2)return r;
+	IrInstr *a=irResolve(cond->ops[0]),*c=irResolve(cond->ops[1]);
+	// the conversions to bool: x!=0 or x==0
+	if((cond->op==OP_NOTEQ_I||cond->op==OP_EQUAL_I)&&a!=v&&isConst(c)&&c->op==OP_PUSH_I&&c->arg.i==0){
+		return condRange(v,a,cond->op==OP_NOTEQ_I?truth:!truth,p,depth+1);
+		}
+	if((a!=v&&c!=v)||a==c)return r;
+	switch(cond->op){
+		case OP_LESS_I:case OP_LESSEQ_I:case OP_GREATER_I:case OP_GREATEREQ_I:case OP_EQUAL_I:case OP_NOTEQ_I:
+			narrow(&r,relation(cond->op,a!=v,!truth),rangeAt(a==v?c:a,p,depth+1));
+			break;
+		default:
+			break;
+		}
+	return r;
+	}
+
+// the range of v in the block at: its definition's range, restricted by the conditions of the branches which lead to at
+// a block with a single predecessor which ends with JT runs only if the condition has the value of that successor
+static Range rangeAt(IrInstr *v,IrBlock *at,int depth){
+	if(depth>BCE_DEPTH)return fullRange();
+	Range r=defRange(v,depth);
+	// the entry is its own dominator
+	for(IrBlock *b=at,*prev=NULL;b!=prev;prev=b,b=b->idom){
+		if(b->nPreds!=1)continue;
+		IrBlock *p=b->preds[0];
+		IrInstr *jt=p->last;
+		if(jt->op!=OP_JT||p->succs[0]==p->succs[1])continue;
+		r=intersect(r,condRange(v,irResolve(jt->ops[0]),b==p->succs[0],p,depth));
+		}
+	return r;
+	}
+
+static void bceCheck(Bce *e,IrInstr *i){
+	IrInstr *v=irResolve(i->ops[0]);
+	int n=i->arg.i;
+	int old=e->checked[v->id];
+	if(old&&old<=n){
+		irReplace(i,v);
+		e->changes++;
+		return;
+		}
+	Range r=rangeAt(v,i->block,0);
+	if(r.lo>=0&&r.hi<n){
+		irReplace(i,v);
+		e->changes++;
+		return;
+		}
+	e->undo[e->nUndo++]=v->id;
+	e->undo[e->nUndo++]=old;
+	e->checked[v->id]=n;
+	}
+
+static void bceBlock(Bce *e,IrBlock *b){
+	int mark=e->nUndo;
+	for(IrInstr *i=b->first;i;i=i->next){
+		resolveOperands(i);
+		if(i->kind==IR_OP&&i->op==OP_CHECK)bceCheck(e,i);
+		}
+	for(int k=0;k<e->nChildren[b->id];k++)bceBlock(e,e->children[b->id][k]);
+	while(e->nUndo>mark){
+		e->nUndo-=2;
+		e->checked[e->undo[e->nUndo]]=e->undo[e->nUndo+1];
+		}
+	}
+
+static int bce(IrFn *f){
+	irDominators(f);
+	Bce e;
+	e.checked=(int*)safeAlloc(f->nValues*sizeof(int));
+	memset(e.checked,0,f->nValues*sizeof(int));
+	e.undo=(int*)safeAlloc(2*f->nValues*sizeof(int));
+	e.nUndo=0;
+	e.children=(IrBlock***)safeAlloc(f->nBlocks*sizeof(IrBlock**));
+	e.nChildren=(int*)safeAlloc(f->nBlocks*sizeof(int));
+	memset(e.nChildren,0,f->nBlocks*sizeof(int));
+	for(IrBlock *b=f->blocks->next;b;b=b->next)e.nChildren[b->idom->id]++;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		e.children[b->id]=(IrBlock**)safeAlloc((e.nChildren[b->id]+1)*sizeof(IrBlock*));
+		e.nChildren[b->id]=0;
+		}
+	for(IrBlock *b=f->blocks->next;b;b=b->next)e.children[b->idom->id][e.nChildren[b->idom->id]++]=b;
+	e.changes=0;
+	bceBlock(&e,f->blocks);
+	for(IrBlock *b=f->blocks;b;b=b->next)free(e.children[b->id]);
+	free(e.checked);
+	free(e.undo);
+	free(e.children);
+	free(e.nChildren);
+	return e.changes;
+	}
+
+static int countChecks(IrFn *f){
+	int n=0;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next){
+			if(i->kind==IR_OP&&i->op==OP_CHECK)n++;
+			}
+		}
+	return n;
+	}
+
+// loop-invariant code motion
+// the instructions of a loop whose operands are all defined outside of it are moved to the loop's preheader,
+// the block from which the loop is entered
+// the inner loops are processed first, so the instructions moved out of them can be moved further
+static bool isInvariant(IrInstr *i,bool *body){
+	for(int k=0;k<i->nOps;k++){
+		if(!isRemat(i->ops[k])&&body[i->ops[k]->block->id])return false;
+		}
+	return true;
+	}
+
+// the instructions which can be moved before the loop
+// the loop's body may not run, so the moved instructions must not fail: a division needs a constant divisor
+// the reads are moved only from the header, which runs each time the preheader runs, and only if the loop does not write
+static bool isHoistable(IrInstr *i,IrBlock *header,bool writes){
+	if(i->kind!=IR_OP||!i->hasValue||isRemat(i)||i==i->block->last)return false;
+	switch(irEffect(i)){
+		case IR_PURE:
+			if(i->op==OP_DIV_I)return isConst(i->ops[1])&&i->ops[1]->arg.i!=0;
+			return true;
+		case IR_READ:
+			return i->block==header&&!writes;
+		default:
+			return false;
+		}
+	}
+
+// moves the invariant instructions of the loop with the given header to pre
+// if pre is NULL, it only returns 1 if there is an instruction to move
+static int hoist(IrFn *f,IrBlock *header,bool *body,IrBlock *pre,bool writes){
+	int moved=0;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		if(!body[b->id])continue;
+		for(IrInstr *i=b->first,*next;i;i=next){
+			next=i->next;
+			resolveOperands(i);
+			if(!isHoistable(i,header,writes)||!isInvariant(i,body))continue;
+			if(!pre)return 1;
+			irUnlink(i);
+			irInsert(pre,pre->last,i);
+			moved++;
+			}
+		}
+	return moved;
+	}
+
+static int licm(IrFn *f){
+	irDominators(f);
+	IrBlock **headers=(IrBlock**)safeAlloc(f->nBlocks*sizeof(IrBlock*));
+	int nHeaders=0;
+	// each loop can get a new block for its preheader
+	bool *body=(bool*)safeAlloc(2*f->nBlocks*sizeof(bool));
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		if(irLoopBody(f,b,body))headers[nHeaders++]=b;
+		}
+	int moved=0;
+	for(int n=nHeaders-1;n>=0;n--){
+		IrBlock *h=headers[n];
+		irLoopBody(f,h,body);
+		IrBlock *pre=NULL;
+		int nOutside=0;
+		for(int k=0;k<h->nPreds;k++){
+			if(!body[h->preds[k]->id]){
+				pre=h->preds[k];
+				nOutside++;
+				}
+			}
+		if(nOutside!=1)continue;
+		bool writes=false;
+		for(IrBlock *b=f->blocks;b;b=b->next){
+			if(!body[b->id])continue;
+			for(IrInstr *i=b->first;i!=b->last;i=i->next){
+				if(irEffect(i)==IR_WRITE)writes=true;
+				}
+			}
+		if(!hoist(f,h,body,NULL,writes))continue;
+		if(pre->nSuccs!=1){
+			pre=irSplitEdge(f,pre,pre->succs[0]==h?0:1);
+			irDominators(f);
+			irLoopBody(f,h,body);
+			}
+		moved+=hoist(f,h,body,pre,writes);
+		}
+	free(headers);
+	free(body);
+	return moved;
+	}
+
+// removes the instructions whose values are not used and which have no effects
+static int dce(IrFn *f){
+	bool *live=(bool*)safeAlloc(f->nValues*sizeof(bool));
+	IrInstr **work=(IrInstr**)safeAlloc(f->nValues*sizeof(IrInstr*));
+	int nWork=0,removed=0;
+	memset(live,0,f->nValues*sizeof(bool));
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next){
+			if(irEffect(i)>=IR_CHECK){
+				live[i->id]=true;
+				work[nWork++]=i;
+				}
+			}
+		}
+	while(nWork){
+		IrInstr *i=work[--nWork];
+		for(int k=0;k<i->nOps;k++){
+			if(!live[i->ops[k]->id]){
+				live[i->ops[k]->id]=true;
+				work[nWork++]=i->ops[k];
+				}
+			}
+		}
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first,*next;i;i=next){
+			next=i->next;
+			if(!live[i->id]){
+				irDelete(i);
+				removed++;
+				}
+			}
+		}
+	free(live);
+	free(work);
+	return removed;
+	}
+
+// vectorization of the counted loops: while(i<n){...; i=i+1;}, with n invariant and the body in a single block:
+// - r=r+a[i] on an int or double array becomes VSUM_I or VSUM_F
+// - d[i]=s[i] becomes VCOPY
+// the first time the body runs, the vector instruction does all the remaining iterations and i becomes n, so the loop ends
+// the old loads and additions of the body are left to dce
+bool irFastMath;
+
+static bool isLoopInvariant(IrInstr *v,IrBlock *header,IrBlock *body){
+	return isRemat(v)||(v->block!=header&&v->block!=body);
+	}
+
+// the size of the elements accessed by a load or store, or 0
+static int elemSize(Opcode op){
+	switch(op){
+		case OP_LOAD_C:case OP_STORE_C:return 1;
+		case OP_LOAD_I:case OP_STORE_I:return 4;
+		case OP_LOAD_F:case OP_STORE_F:return 8;
+		default:return 0;
+		}
+	}
+
+static int vectorizeLoop(IrFn *f,IrBlock *h){
+	IrBlock *b=h->succs[0];
+	IrInstr *jt=h->last;
+	if(jt->op!=OP_JT||h->nPreds!=2||b==h->succs[1]||b->nPreds!=1||b->nSuccs!=1||b->succs[0]!=h)return 0;
+	IrInstr *cond=jt->ops[0];
+	if(cond->kind!=IR_OP||cond->op!=OP_LESS_I||cond->block!=h)return 0;
+	IrInstr *i=cond->ops[0],*n=cond->ops[1];
+	int back=h->preds[0]==b?0:1;
+	long long c;
+	if(i->kind!=IR_PHI||i->block!=h||!isLoopInvariant(n,h,b))return 0;
+	IrInstr *step=i->ops[back];
+	if(step->block!=b||!isStep(step,i,&c)||c!=1)return 0;
+	// the header has only i, the condition, the constants and the phi of a sum
+	IrInstr *acc=NULL;
+	for(IrInstr *x=h->first;x!=jt;x=x->next){
+		if(x==i||x==cond||isRemat(x))continue;
+		if(x->kind!=IR_PHI||acc)return 0;
+		acc=x;
+		}
+	IrInstr *load=NULL,*store=NULL,*sum=NULL;
+	int nAddrs=0;
+	for(IrInstr *x=b->first;x!=b->last;x=x->next){
+		if(x==step||isRemat(x))continue;
+		if(x->kind!=IR_OP)return 0;
+		switch(x->op){
+			case OP_INDEX:
+				if(nAddrs==2||x->ops[1]!=i||!isLoopInvariant(x->ops[0],h,b))return 0;
+				nAddrs++;
+				break;
+			case OP_LOAD_I:case OP_LOAD_F:case OP_LOAD_C:
+				if(load)return 0;
+				load=x;
+				break;
+			case OP_STORE_I:case OP_STORE_F:case OP_STORE_C:
+				if(store)return 0;
+				store=x;
+				break;
+			case OP_ADD_I:case OP_ADD_F:
+				if(sum)return 0;
+				sum=x;
+				break;
+			default:
+				return 0;
+			}
+		}
+	if(!load||load->ops[0]->kind!=IR_OP||load->ops[0]->op!=OP_INDEX)return 0;
+	IrInstr *src=load->ops[0],*v;
+	int size=elemSize(load->op);
+	if(src->arg.i!=size)return 0;
+	if(acc&&sum&&!store&&nAddrs==1){
+		IrInstr *other=sum->ops[0]==acc?sum->ops[1]:sum->ops[0];
+		if(acc->ops[back]!=sum||other!=load||(sum->ops[0]!=acc&&sum->ops[1]!=acc))return 0;
+		if(sum->op==OP_ADD_I&&load->op==OP_LOAD_I)v=irNewInstr(f,IR_OP,OP_VSUM_I);
+		else if(sum->op==OP_ADD_F&&load->op==OP_LOAD_F)v=irNewInstr(f,IR_OP,OP_VSUM_F);
+		else return 0;
+		v->arg.i=sum->op==OP_ADD_F&&irFastMath;
+		irAddOperand(v,src->ops[0]);
+		irAddOperand(v,i);
+		irAddOperand(v,n);
+		irAddOperand(v,acc);
+		irInsert(b,sum,v);
+		irReplace(sum,v);
+		}else if(!acc&&!sum&&store&&nAddrs==2){
+		IrInstr *dst=store->ops[0];
+		if(store->ops[1]!=load||dst==src||dst->kind!=IR_OP||dst->op!=OP_INDEX||elemSize(store->op)!=size||dst->arg.i!=size)return 0;
+		v=irNewInstr(f,IR_OP,OP_VCOPY);
+		v->arg.i=size;
+		v->hasValue=false;
+		irAddOperand(v,dst->ops[0]);
+		irAddOperand(v,src->ops[0]);
+		irAddOperand(v,i);
+		irAddOperand(v,n);
+		irInsert(b,store,v);
+		irDelete(store);
+		}else{
+		return 0;
+		}
+	irReplace(step,n);
+	return 1;
+	}
+
+static int vectorize(IrFn *f){
+	int changes=0;
+	for(IrBlock *b=f->blocks;b;b=b->next){
+		for(IrInstr *i=b->first;i;i=i->next)resolveOperands(i);
+		}
+	for(IrBlock *b=f->blocks;b;b=b->next)changes+=vectorizeLoop(f,b);
+	return changes;
+	}
+
+static const char *passNames[IRP_COUNT]={"copy-prop","sccp","cse","gvn","bce","licm","dce","vec"};
+static int (*passFns[IRP_COUNT])(IrFn*)={copyProp,sccp,cse,gvn,bce,licm,dce,vectorize};
+
+const char *irPassName(IrPassId pass){
+	return passNames[pass];
+	}
+
+int irRunPass(IrFn *f,IrPassId pass,IrStats *stats){
+	clock_t start=clock();
+	int changes=passFns[pass](f);
+	f->usersValid=false;
+	stats->runs[pass]++;
+	stats->changes[pass]+=changes;
+	stats->seconds[pass]+=(double)(clock()-start)/CLOCKS_PER_SEC;
+	return changes;
+	}
+
+void irOptimize(IrFn *f,IrStats *stats){
+	static const IrPassId pipeline[]={IRP_COPY_PROP,IRP_SCCP,IRP_COPY_PROP,IRP_CSE,IRP_GVN,IRP_BCE,IRP_LICM,IRP_COPY_PROP,IRP_DCE,IRP_VEC};
+	// each round can make new opportunities for the others, but the number of rounds is limited
+	for(int round=0;round<8;round++){
+		int changes=0;
+		for(size_t k=0;k<sizeof(pipeline)/sizeof(pipeline[0]);k++)changes+=irRunPass(f,pipeline[k],stats);
+		if(!changes)break;
+		}
+	}
+
+void irOptimizeDomain(Domain *d,IrStats *stats,bool dump){
+	for(Symbol *s=d->symbols;s;s=s->next){
+		if(s->kind!=SK_FN||s->fn.extFnPtr||!s->fn.instr)continue;
+		IrFn *f=irBuild(s);
+		if(!f){
+			stats->skipped++;
+			continue;
+			}
+		stats->checks+=countChecks(f);
+		irOptimize(f,stats);
+		stats->checksLeft+=countChecks(f);
+		if(dump)irDump(f);
+		irToVm(f);
+		irFree(f);
+		stats->functions++;
+		}
+	}
+
+void irShowStats(IrStats *stats){
+	printf("// IR: %d functions optimized, %d skipped\n",stats->functions,stats->skipped);
+	for(int k=0;k<IRP_COUNT;k++){
+		printf("//\t%s: %d runs, %d changes, %.6f s\n",passNames[k],stats->runs[k],stats->changes[k],stats->seconds[k]);
+		}
+	if(stats->checks){
+		printf("//\tbounds checks: %d of %d eliminated\n",stats->checks-stats->checksLeft,stats->checks);
+		}
+	}
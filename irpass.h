@@ -0,0 +1,41 @@
+#pragma once
+
+// the optimization passes on the SSA IR and the pass manager which runs them
+
+#include "ir.h"
+
+typedef enum{
+	IRP_COPY_PROP,		// copies propagation and the removal of the trivial phis
+	IRP_SCCP,		// sparse conditional constant propagation
+	IRP_CSE,		// common subexpression elimination in each block, including the memory reads
+	IRP_GVN,		// global value numbering of the pure operations, over the dominator tree
+	IRP_BCE,		// bounds checks elimination
+	IRP_LICM,		// loop-invariant code motion
+	IRP_DCE,		// dead code elimination
+	IRP_VEC,		// vectorization of the sums and copies of arrays in the counted loops
+	IRP_COUNT
+	}IrPassId;
+
+typedef struct{
+	int runs[IRP_COUNT];
+	int changes[IRP_COUNT];		// the replaced or removed instructions and the folded branches
+	double seconds[IRP_COUNT];
+	int functions;		// the optimized functions
+	int skipped;		// the functions which cannot be represented in the IR
+	int checks;		// the bounds checks of the optimized functions, before the optimizations
+	int checksLeft;		// the bounds checks which remain after the optimizations
+	}IrStats;
+
+// allows the vectorizer to reassociate the additions of doubles, which changes their rounding
+extern bool irFastMath;
+
+const char *irPassName(IrPassId pass);
+// runs a pass on f and adds its statistics to stats
+// returns the number of changes
+int irRunPass(IrFn *f,IrPassId pass,IrStats *stats);
+// runs all the passes, in a loop, until nothing changes
+void irOptimize(IrFn *f,IrStats *stats);
+// builds the IR of each function with code from domain d, optimizes it and puts back the generated VM code
+// if dump is true, the IR of each function is shown after the optimizations
+void irOptimizeDomain(Domain *d,IrStats *stats,bool dump);
+void irShowStats(IrStats *stats);
@@ -0,0 +1,304 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+
+#include "json.h"
+#include "utils.h"
+
+typedef struct{
+	const char *p;		// the current position
+	const char *end;
+	}JsonParser;
+
+static void skipSpaces(JsonParser *jp){
+	while(jp->p<jp->end&&(*jp->p==' '||*jp->p=='\t'||*jp->p=='\n'||*jp->p=='\r'))jp->p++;
+	}
+
+static JsonValue *newValue(JsonKind kind){
+	JsonValue *v=(JsonValue*)safeAlloc(sizeof(JsonValue));
+	memset(v,0,sizeof(JsonValue));
+	v->kind=kind;
+	return v;
+	}
+
+static bool matchWord(JsonParser *jp,const char *word){
+	size_t n=strlen(word);
+	if((size_t)(jp->end-jp->p)<n||memcmp(jp->p,word,n))return false;
+	jp->p+=n;
+	return true;
+	}
+
+static int hexDigit(char c){
+	if(c>='0'&&c<='9')return c-'0';
+	if(c>='a'&&c<='f')return c-'a'+10;
+	if(c>='A'&&c<='F')return c-'A'+10;
+	return -1;
+	}
+
+// reads the 4 hex digits of a \u escape
+static long readHex4(JsonParser *jp){
+	if(jp->end-jp->p<4)return -1;
+	long code=0;
+	for(int i=0;i<4;i++){
+		int d=hexDigit(jp->p[i]);
+		if(d<0)return -1;
+		code=code*16+d;
+		}
+	jp->p+=4;
+	return code;
+	}
+
+// writes the code point in UTF-8 and returns the number of bytes
+static int putUtf8(char *dst,long code){
+	if(code<0x80){dst[0]=(char)code;return 1;}
+	if(code<0x800){
+		dst[0]=(char)(0xC0|(code>>6));
+		dst[1]=(char)(0x80|(code&0x3F));
+		return 2;
+		}
+	if(code<0x10000){
+		dst[0]=(char)(0xE0|(code>>12));
+		dst[1]=(char)(0x80|((code>>6)&0x3F));
+		dst[2]=(char)(0x80|(code&0x3F));
+		return 3;
+		}
+	dst[0]=(char)(0xF0|(code>>18));
+	dst[1]=(char)(0x80|((code>>12)&0x3F));
+	dst[2]=(char)(0x80|((code>>6)&0x3F));
+	dst[3]=(char)(0x80|(code&0x3F));
+	return 4;
+	}
+
+// parses a string, after its opening quote
+// the decoded string is never longer than its escaped form
+static char *parseString(JsonParser *jp){
+	const char *q=jp->p;
+	while(q<jp->end&&*q!='"'){
+		if(*q=='\\')q++;
+		q++;
+		}
+	if(q>=jp->end)return NULL;
+	char *str=(char*)safeAlloc((size_t)(q-jp->p)+1);
+	char *dst=str;
+	while(*jp->p!='"'){
+		char c=*jp->p++;
+		if(c!='\\'){*dst++=c;continue;}
+		switch(*jp->p++){
+			case '"':*dst++='"';break;
+			case '\\':*dst++='\\';break;
+			case '/':*dst++='/';break;
+			case 'b':*dst++='\b';break;
+			case 'f':*dst++='\f';break;
+			case 'n':*dst++='\n';break;
+			case 'r':*dst++='\r';break;
+			case 't':*dst++='\t';break;
+			case 'u':{
+				long code=readHex4(jp);
+				if(code<0)goto invalid;
+				// a surrogate pair encodes a code point above 0xFFFF
+				if(code>=0xD800&&code<0xDC00&&jp->end-jp->p>=6&&jp->p[0]=='\\'&&jp->p[1]=='u'){
+					jp->p+=2;
+					long low=readHex4(jp);
+					if(low<0xDC00||low>0xDFFF)goto invalid;
+					code=0x10000+((code-0xD800)<<10)+(low-0xDC00);
+					}
+				dst+=putUtf8(dst,code);
+				break;
+				}
+			default:goto invalid;
+			}
+		}
+	jp->p++;
+	*dst='\0';
+	return str;
+invalid:
+	free(str);
+	return NULL;
+	}
+
+static JsonValue *parseValue(JsonParser *jp);
+
+// parses the elements of an array or the members of an object, until the closing character
+static bool parseItems(JsonParser *jp,JsonValue *v,char close){
+	JsonValue **tail=&v->items;
+	skipSpaces(jp);
+	if(jp->p<jp->end&&*jp->p==close){jp->p++;return true;}
+	for(;;){
+		char *name=NULL;
+		if(v->kind==JSON_OBJECT){
+			skipSpaces(jp);
+			if(jp->p>=jp->end||*jp->p!='"')return false;
+			jp->p++;
+			if(!(name=parseString(jp)))return false;
+			skipSpaces(jp);
+			if(jp->p>=jp->end||*jp->p!=':'){free(name);return false;}
+			jp->p++;
+			}
+		JsonValue *item=parseValue(jp);
+		if(!item){free(name);return false;}
+		item->name=name;
+		*tail=item;
+		tail=&item->next;
+		skipSpaces(jp);
+		if(jp->p>=jp->end)return false;
+		char c=*jp->p++;
+		if(c==close)return true;
+		if(c!=',')return false;
+		}
+	}
+
+static JsonValue *parseValue(JsonParser *jp){
+	skipSpaces(jp);
+	if(jp->p>=jp->end)return NULL;
+	JsonValue *v;
+	switch(*jp->p){
+		case '{':
+		case '[':{
+			char close=*jp->p=='{'?'}':']';
+			jp->p++;
+			v=newValue(close=='}'?JSON_OBJECT:JSON_ARRAY);
+			if(!parseItems(jp,v,close)){jsonFree(v);return NULL;}
+			return v;
+			}
+		case '"':
+			jp->p++;
+			v=newValue(JSON_STRING);
+			if(!(v->str=parseString(jp))){free(v);return NULL;}
+			return v;
+		case 't':
+		case 'f':
+			v=newValue(JSON_BOOL);
+			v->b=*jp->p=='t';
+			if(!matchWord(jp,v->b?"true":"false")){free(v);return NULL;}
+			return v;
+		case 'n':
+			if(!matchWord(jp,"null"))return NULL;
+			return newValue(JSON_NULL);
+		default:{
+			// strtod needs a NUL terminated text, so the number is copied
+			char num[64];
+			size_t n=0;
+			while(jp->p+n<jp->end&&n<sizeof(num)-1&&strchr("+-.0123456789eE",jp->p[n]))n++;
+			memcpy(num,jp->p,n);
+			num[n]='\0';
+			char *after;
+			double d=strtod(num,&after);
+			if(n==0||after!=num+n)return NULL;
+			jp->p+=n;
+			v=newValue(JSON_NUMBER);
+			v->num=d;
+			return v;
+			}
+		}
+	}
+
+JsonValue *jsonParse(const char *text,size_t len){
+	JsonParser jp={text,text+len};
+	JsonValue *v=parseValue(&jp);
+	if(!v)return NULL;
+	skipSpaces(&jp);
+	if(jp.p!=jp.end){jsonFree(v);return NULL;}
+	return v;
+	}
+
+void jsonFree(JsonValue *v){
+	for(JsonValue *next;v;v=next){
+		next=v->next;
+		jsonFree(v->items);
+		free(v->str);
+		free(v->name);
+		free(v);
+		}
+	}
+
+JsonValue *jsonGet(JsonValue *obj,const char *name){
+	if(!obj||obj->kind!=JSON_OBJECT)return NULL;
+	for(JsonValue *m=obj->items;m;m=m->next){
+		if(!strcmp(m->name,name))return m;
+		}
+	return NULL;
+	}
+
+const char *jsonGetStr(JsonValue *obj,const char *name){
+	JsonValue *v=jsonGet(obj,name);
+	return v&&v->kind==JSON_STRING?v->str:NULL;
+	}
+
+double jsonGetNum(JsonValue *obj,const char *name,double def){
+	JsonValue *v=jsonGet(obj,name);
+	return v&&v->kind==JSON_NUMBER?v->num:def;
+	}
+
+static void reserve(JsonBuf *buf,size_t n){
+	if(buf->len+n+1<=buf->cap)return;
+	size_t cap=buf->cap?buf->cap:256;
+	while(buf->len+n+1>cap)cap*=2;
+	char *s=(char*)realloc(buf->s,cap);
+	if(!s)err("not enough memory");
+	buf->s=s;
+	buf->cap=cap;
+	}
+
+void jsonAppend(JsonBuf *buf,const char *fmt,...){
+	va_list va;
+	va_start(va,fmt);
+	int n=vsnprintf(NULL,0,fmt,va);
+	va_end(va);
+	reserve(buf,(size_t)n);
+	va_start(va,fmt);
+	vsnprintf(buf->s+buf->len,(size_t)n+1,fmt,va);
+	va_end(va);
+	buf->len+=(size_t)n;
+	}
+
+void jsonAppendStr(JsonBuf *buf,const char *str){
+	reserve(buf,strlen(str)*6+2);		// the longest escape is \u00XX
+	char *dst=buf->s+buf->len;
+	*dst++='"';
+	for(const unsigned char *p=(const unsigned char*)str;*p;p++){
+		switch(*p){
+			case '"':*dst++='\\';*dst++='"';break;
+			case '\\':*dst++='\\';*dst++='\\';break;
+			case '\n':*dst++='\\';*dst++='n';break;
+			case '\r':*dst++='\\';*dst++='r';break;
+			case '\t':*dst++='\\';*dst++='t';break;
+			default:
+				if(*p<0x20)dst+=sprintf(dst,"\\u%04x",*p);
+				else *dst++=(char)*p;
+			}
+		}
+	*dst++='"';
+	*dst='\0';
+	buf->len=(size_t)(dst-buf->s);
+	}
+
+void jsonAppendValue(JsonBuf *buf,JsonValue *v){
+	switch(v->kind){
+		case JSON_NULL:jsonAppend(buf,"null");break;
+		case JSON_BOOL:jsonAppend(buf,v->b?"true":"false");break;
+		case JSON_NUMBER:jsonAppend(buf,"%.17g",v->num);break;
+		case JSON_STRING:jsonAppendStr(buf,v->str);break;
+		case JSON_ARRAY:
+		case JSON_OBJECT:{
+			bool isObject=v->kind==JSON_OBJECT;
+			jsonAppend(buf,isObject?"{":"[");
+			for(JsonValue *item=v->items;item;item=item->next){
+				if(item!=v->items)jsonAppend(buf,",");
+				if(isObject){
+					jsonAppendStr(buf,item->name);
+					jsonAppend(buf,":");
+					}
+				jsonAppendValue(buf,item);
+				}
+			jsonAppend(buf,isObject?"}":"]");
+			break;
+			}
+		}
+	}
+
+void jsonBufFree(JsonBuf *buf){
+	free(buf->s);
+	buf->s=NULL;
+	buf->len=buf->cap=0;
+	}
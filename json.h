@@ -0,0 +1,45 @@
+#pragma once
+
+// a minimal JSON reader and writer, for the messages of the language server
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef enum{
+	JSON_NULL,JSON_BOOL,JSON_NUMBER,JSON_STRING,JSON_ARRAY,JSON_OBJECT
+	}JsonKind;
+
+typedef struct JsonValue{
+	JsonKind kind;
+	bool b;		// for JSON_BOOL
+	double num;		// for JSON_NUMBER
+	char *str;		// for JSON_STRING, UTF-8 and NUL terminated
+	struct JsonValue *items;		// the elements of an array or the members of an object
+	char *name;		// for the members of an object, their name
+	struct JsonValue *next;		// the next element or member
+	}JsonValue;
+
+// parses the len bytes from text
+// returns NULL if they are not a valid JSON value
+JsonValue *jsonParse(const char *text,size_t len);
+void jsonFree(JsonValue *v);
+// returns the member with the given name of obj, or NULL if obj is not an object or it does not have that member
+JsonValue *jsonGet(JsonValue *obj,const char *name);
+// the value of a member of obj, or the default value if the member does not exist or it has another kind
+const char *jsonGetStr(JsonValue *obj,const char *name);		// default NULL
+double jsonGetNum(JsonValue *obj,const char *name,double def);
+
+// a growing text buffer, in which the messages are written
+typedef struct{
+	char *s;		// NUL terminated
+	size_t len;
+	size_t cap;
+	}JsonBuf;
+
+// appends formatted text, as printf
+void jsonAppend(JsonBuf *buf,const char *fmt,...);
+// appends a JSON string with the given content, between quotes and escaped
+void jsonAppendStr(JsonBuf *buf,const char *str);
+// appends a value exactly as it was parsed (ex: the id of a request)
+void jsonAppendValue(JsonBuf *buf,JsonValue *v);
+void jsonBufFree(JsonBuf *buf);
@@ -0,0 +1,129 @@
+// generated by tools/lexgen.c from its rules: do not edit
+// 50 rules, 421 NFA states, 97 DFA states, 91 states after minimization, 46 byte classes
+
+#define DFA_STATES 91
+#define DFA_CLASSES 46
+#define DFA_START 1		// state 0 is the dead state, from which the text cannot continue a token
+
+// the class of each byte
+static const uint8_t dfaClass[256]={
+	0,1,1,1,1,1,1,1,1,2,3,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+	2,4,5,1,1,1,6,7,8,9,10,11,12,13,14,15,16,16,16,16,16,16,16,16,16,16,1,17,18,19,20,1,
+	1,21,21,21,21,22,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,21,23,1,24,1,21,
+	1,25,26,27,28,29,30,21,31,32,21,33,34,21,35,36,21,21,37,38,39,40,41,42,21,21,21,43,44,45,1,1,
+	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+	1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,
+	};
+
+// dfaNext[state*DFA_CLASSES+class] - the next state
+static const uint8_t dfaNext[DFA_STATES*DFA_CLASSES]={
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,2,2,3,4,5,6,7,8,9,10,11,12,13,14,15,16,17,18,19,20,20,21,22,20,23,24,25,26,27,20,28,20,20,20,20,29,30,20,20,31,32,33,34,35,
+	0,0,2,2,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,36,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,4,4,4,4,37,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,4,
+	0,0,0,0,0,0,38,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,39,39,39,39,39,39,40,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,39,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,41,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,42,0,15,0,0,0,0,0,43,0,0,0,0,0,0,43,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,44,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,45,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,46,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,47,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,48,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,49,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,50,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,51,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,52,20,20,20,20,53,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,54,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,55,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,56,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,57,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,58,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,59,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,41,41,0,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,41,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,60,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,61,0,61,0,0,62,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,63,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,64,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,65,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,66,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,67,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,68,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,69,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,70,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,71,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,72,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,73,0,60,0,0,0,0,0,43,0,0,0,0,0,0,43,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,62,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,62,0,0,0,0,0,74,0,0,0,0,0,0,74,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,75,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,76,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,77,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,78,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,79,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,80,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,81,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,82,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,83,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,84,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,85,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,86,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,87,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,88,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,89,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,90,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,20,0,0,0,0,20,20,0,0,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,20,0,0,0,
+	};
+
+// dfaAccept[state] - the code of the token which ends in the state, or -1 if the state does not end a token
+static const int8_t dfaAccept[DFA_STATES]={
+	-1,-1,LEX_SKIP,NOT,LEX_ERR_STRING_END,LEX_ERR_SYMBOL,LEX_ERR_CHAR_END,LPAR,
+	RPAR,MUL,ADD,COMMA,SUB,DOT,DIV,INT,
+	SEMICOLON,LESS,ASSIGN,GREATER,ID,LBRACKET,RBRACKET,ID,
+	ID,ID,ID,ID,ID,ID,ID,ID,
+	ID,LACC,LEX_ERR_SYMBOL,RACC,NOTEQ,STRING,AND,LEX_ERR_CHAR_END,
+	LEX_ERR_CHAR_EMPTY,LEX_SKIP,LEX_ERR_FRACTION,LEX_ERR_EXPONENT,LESSEQ,EQUAL,GREATEREQ,ID,
+	ID,ID,ID,ID,IF,ID,ID,ID,
+	ID,ID,OR,CHAR,DOUBLE,LEX_ERR_EXPONENT_SIGN,DOUBLE,ID,
+	ID,ID,ID,FOR,TYPE_INT,ID,ID,ID,
+	ID,LEX_ERR_DOTS,LEX_ERR_EXPONENTS,ID,TYPE_CHAR,ID,ELSE,ID,
+	ID,VOID,ID,BREAK,ID,ID,ID,WHILE,
+	TYPE_DOUBLE,RETURN,STRUCT,
+	};
@@ -2,6 +2,11 @@
 #include <ctype.h>
 #include <string.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include <float.h>
+#include <math.h>
+#include <stdarg.h>
 
 #include "lexer.h"
 #include "utils.h"
@@ -9,19 +14,306 @@
 Token *tokens; // single linked list of tokens
 Token *lastTk; // the last token in list
 
-int line = 1; // the current line in the input file
+static const char *srcBegin; // the beginning of the lexed text
+static const char *tkBegin;  // the beginning of the current token
 
-// Function to check if a character is a valid exponent character ('e' or 'E')
-int is_exponent(char c) {
-    return c == 'e' || c == 'E';
+static LineTable fileLines;
+_Thread_local LineTable *tkLines = &fileLines;
+
+_Static_assert(sizeof(Token) <= 16, "Token must have at most 16 bytes");
+
+bool parseInt(const char *begin, const char *end, int *value) {
+    int v = 0;
+    for (; begin < end; begin++) {
+        int digit = *begin - '0';
+        if (v > (INT_MAX - digit) / 10) return false;
+        v = v * 10 + digit;
+    }
+    *value = v;
+    return true;
+}
+
+// the powers of 10 which are exactly representable as double
+static const double exactPow10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+#define MAX_EXACT_MANTISSA (1ULL << 53)
+
+// the slow path of parseDouble compares the literal with the midpoints between the neighbouring doubles,
+// using exact big integers, so it does not depend on the libc and on its locale (the decimal point of strtod)
+// a literal keeps at most SLOW_MAX_DIGITS significant digits; the dropped ones only matter as a sticky nonzero digit,
+// because a midpoint between two doubles has less than 770 significant digits
+#define SLOW_MAX_DIGITS 780
+#define BIG_LIMBS 200 // 6400 bits: enough for the digits, the binary exponents and the powers of 10 of the compared values
+
+typedef struct {
+    uint32_t limbs[BIG_LIMBS]; // little endian
+    int n;
+} BigInt;
+
+static void bigMulAdd(BigInt *b, uint32_t mul, uint32_t add) {
+    uint64_t carry = add;
+    for (int i = 0; i < b->n; i++) {
+        carry += (uint64_t)b->limbs[i] * mul;
+        b->limbs[i] = (uint32_t)carry;
+        carry >>= 32;
+    }
+    if (carry) {
+        if (b->n == BIG_LIMBS) err("parseDouble: the number is too large");
+        b->limbs[b->n++] = (uint32_t)carry;
+    }
+}
+
+static void bigMulPow10(BigInt *b, int e) {
+    for (; e >= 9; e -= 9) bigMulAdd(b, 1000000000u, 0);
+    static const uint32_t pow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    if (e) bigMulAdd(b, pow10[e], 0);
+}
+
+static void bigShiftLeft(BigInt *b, int bits) {
+    if (!b->n) return;
+    int words = bits / 32, shift = bits % 32;
+    if (b->n + words + 1 > BIG_LIMBS) err("parseDouble: the number is too large");
+    b->limbs[b->n + words] = 0;
+    for (int i = b->n - 1; i >= 0; i--) {
+        uint32_t v = b->limbs[i];
+        if (shift) b->limbs[i + words + 1] |= v >> (32 - shift);
+        b->limbs[i + words] = v << shift;
+    }
+    for (int i = 0; i < words; i++) b->limbs[i] = 0;
+    b->n += words + 1;
+    while (b->n && !b->limbs[b->n - 1]) b->n--;
+}
+
+static int bigCompare(const BigInt *a, const BigInt *b) {
+    if (a->n != b->n) return a->n < b->n ? -1 : 1;
+    for (int i = a->n - 1; i >= 0; i--) {
+        if (a->limbs[i] != b->limbs[i]) return a->limbs[i] < b->limbs[i] ? -1 : 1;
+    }
+    return 0;
+}
+
+// compares digits*10^exp10 with odd*2^exp2, where odd is a positive odd integer
+static int compareWithMidpoint(const BigInt *digits, int exp10, uint64_t odd, int exp2) {
+    static _Thread_local BigInt l, r;
+    l = *digits;
+    if (exp10 > 0) bigMulPow10(&l, exp10);
+    if (exp2 < 0) bigShiftLeft(&l, -exp2);
+    r.n = 0;
+    bigMulAdd(&r, 1, (uint32_t)(odd >> 32));
+    bigShiftLeft(&r, 32);
+    bigMulAdd(&r, 1, (uint32_t)odd);
+    if (exp2 > 0) bigShiftLeft(&r, exp2);
+    if (exp10 < 0) bigMulPow10(&r, -exp10);
+    return bigCompare(&l, &r);
+}
+
+static double slowParseDouble(const char *begin, const char *end) {
+    static _Thread_local BigInt digits;
+    digits.n = 0;
+    int nDigits = 0, exp10 = 0;
+    uint64_t first = 0; // the first 19 significant digits, for the initial guess
+    bool sticky = false; // a dropped digit is not 0
+    const char *p = begin;
+    for (bool fraction = false; p < end && (isdigit(*p) || (*p == '.' && !fraction)); p++) {
+        if (*p == '.') {
+            fraction = true;
+            continue;
+        }
+        if (fraction) exp10--;
+        if (!nDigits && *p == '0') continue;
+        if (nDigits == SLOW_MAX_DIGITS) {
+            if (*p != '0') sticky = true;
+            exp10++;
+            continue;
+        }
+        bigMulAdd(&digits, 10, (uint32_t)(*p - '0'));
+        if (nDigits < 19) first = first * 10 + (uint64_t)(*p - '0');
+        nDigits++;
+    }
+    if (p < end) { // exponent
+        p++;
+        bool negative = *p == '-';
+        if (*p == '+' || *p == '-') p++;
+        int e = 0;
+        for (; p < end; p++) {
+            if (e < 100000) e = e * 10 + (*p - '0');
+        }
+        exp10 += negative ? -e : e;
+    }
+    if (!nDigits) return 0.0;
+    // the value is in [10^(nDigits-1+exp10), 10^(nDigits+exp10))
+    if (nDigits + exp10 < -325) return 0.0;
+    if (nDigits - 1 + exp10 > 308) return HUGE_VAL;
+    if (sticky) { // it makes the value greater than the kept digits, but never equal to a midpoint
+        bigMulAdd(&digits, 10, 1);
+        nDigits++;
+        exp10--;
+    }
+    // a guess within a few ulps, which is then corrected by exact comparisons
+    int firstExp = exp10 + (nDigits > 19 ? nDigits - 19 : 0);
+    double guess = (double)first * pow(10, firstExp / 2) * pow(10, firstExp - firstExp / 2);
+    if (guess > DBL_MAX) guess = DBL_MAX;
+    for (;;) {
+        // guess = m*2^e, with m < 2^53
+        int e;
+        uint64_t m;
+        if (guess < DBL_MIN) {
+            e = -1074;
+            m = (uint64_t)ldexp(guess, 1074);
+        } else {
+            double f = frexp(guess, &e);
+            m = (uint64_t)ldexp(f, 53);
+            e -= 53;
+        }
+        // above the midpoint to the next double
+        int cmp = compareWithMidpoint(&digits, exp10, 2 * m + 1, e - 1);
+        if (cmp > 0 || (cmp == 0 && (m & 1))) {
+            guess = nextafter(guess, HUGE_VAL);
+            if (cmp == 0 || guess > DBL_MAX) return guess;
+            continue;
+        }
+        if (cmp == 0 || !m) return guess;
+        // below the midpoint to the previous double, which is closer when m is a power of 2
+        cmp = m == (1ULL << 52) && e > -1074 ? compareWithMidpoint(&digits, exp10, 4 * m - 1, e - 2)
+                                              : compareWithMidpoint(&digits, exp10, 2 * m - 1, e - 1);
+        if (cmp < 0 || (cmp == 0 && (m & 1))) {
+            guess = nextafter(guess, 0.0);
+            if (cmp == 0) return guess;
+            continue;
+        }
+        return guess;
+    }
+}
+
+double parseDouble(const char *begin, const char *end) {
+    // Clinger's fast path: if the decimal mantissa and the power of 10 are both exact doubles,
+    // a single IEEE multiplication or division gives the correctly rounded result.
+    // It needs the operations to be done in double precision (not in x87 extended precision).
+#if FLT_EVAL_METHOD == 0
+    uint64_t mantissa = 0;
+    int exp10 = 0, nDigits = 0;
+    const char *p = begin;
+    for (; p < end && isdigit(*p); p++) {
+        if (mantissa == 0 && *p == '0') continue; // leading zeros are not significant
+        if (++nDigits > 19) goto slow;
+        mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+    }
+    if (p < end && *p == '.') {
+        for (p++; p < end && isdigit(*p); p++) {
+            exp10--;
+            if (mantissa == 0 && *p == '0') continue;
+            if (++nDigits > 19) goto slow;
+            mantissa = mantissa * 10 + (uint64_t)(*p - '0');
+        }
+    }
+    if (p < end) { // exponent
+        p++;
+        bool negative = *p == '-';
+        if (*p == '+' || *p == '-') p++;
+        int e = 0;
+        for (; p < end; p++) {
+            if (e > 1000) goto slow; // out of range for the fast path anyway
+            e = e * 10 + (*p - '0');
+        }
+        exp10 += negative ? -e : e;
+    }
+    if (mantissa == 0) return 0.0;
+    if (mantissa <= MAX_EXACT_MANTISSA) {
+        if (exp10 >= -22 && exp10 <= 22) {
+            return exp10 < 0 ? (double)mantissa / exactPow10[-exp10] : (double)mantissa * exactPow10[exp10];
+        }
+        // "disguised" fast path: 123e25 is 12300000e20 and the extra zeros can move into the mantissa
+        if (exp10 > 22 && exp10 <= 22 + 15) {
+            for (; exp10 > 22; exp10--) {
+                mantissa *= 10;
+                if (mantissa > MAX_EXACT_MANTISSA) goto slow;
+            }
+            return (double)mantissa * exactPow10[22];
+        }
+    }
+slow:
+#endif
+    // rare literals (more than 19 significant digits, huge exponents)
+    return slowParseDouble(begin, end);
+}
+
+// the side table with the values of the tokens which do not fit in their 32 bits
+// the freed slots are linked by nextFree and reused
+typedef union {
+    char *text;
+    double d;
+    uint32_t nextFree;
+} TkValue;
+
+static TkValue *tkValues;
+static uint32_t nTkValues, tkValuesCap;
+static uint32_t freeValues = UINT32_MAX; // the first free slot, or UINT32_MAX if there is none
+
+static uint32_t newValue(void) {
+    uint32_t idx = freeValues;
+    if (idx != UINT32_MAX) {
+        freeValues = tkValues[idx].nextFree;
+        return idx;
+    }
+    if (nTkValues == tkValuesCap) {
+        tkValuesCap = tkValuesCap ? tkValuesCap * 2 : 1024;
+        TkValue *values = realloc(tkValues, tkValuesCap * sizeof(TkValue));
+        if (!values) err("not enough memory");
+        tkValues = values;
+    }
+    return nTkValues++;
+}
+
+static void freeValue(uint32_t idx) {
+    tkValues[idx].nextFree = freeValues;
+    freeValues = idx;
+}
+
+const char *tkText(const Token *tk) {
+    return tkValues[tk->val].text;
+}
+
+double tkDouble(const Token *tk) {
+    return tkValues[tk->val].d;
+}
+
+// the tokens are allocated in blocks and the freed ones are kept for reuse, linked by next
+#define TK_BLOCK 1024
+
+typedef struct TkBlock {
+    struct TkBlock *next;
+    Token tokens[TK_BLOCK];
+} TkBlock;
+
+static TkBlock *tkBlocks;
+static Token *freeTks;
+
+static Token *allocTk(void) {
+    if (!freeTks) {
+        TkBlock *b = safeAlloc(sizeof(TkBlock));
+        b->next = tkBlocks;
+        tkBlocks = b;
+        for (int i = TK_BLOCK - 1; i >= 0; i--) {
+            b->tokens[i].next = freeTks;
+            freeTks = &b->tokens[i];
+        }
+    }
+    Token *tk = freeTks;
+    freeTks = tk->next;
+    return tk;
 }
 
 // adds a token to the end of the tokens list and returns it
-// sets its code and line
+// sets its code and its offset, from tkBegin
 Token *addTk(int code) {
-    Token *tk = safeAlloc(sizeof(Token));
+    Token *tk = allocTk();
     tk->code = code;
-    tk->line = line;
+    int pos = (int)(tkBegin - srcBegin);
+    tk->pos = (unsigned)(tkLines->byLine ? lineOfPos(tkLines, pos) : pos);
+    tk->val = 0;
     tk->next = NULL;
     if (lastTk) {
         lastTk->next = tk;
@@ -32,6 +324,59 @@ Token *addTk(int code) {
     return tk;
 }
 
+// adds an ID or STRING token, which takes the text
+static Token *addTextTk(int code, char *text) {
+    Token *tk = addTk(code);
+    tk->val = newValue();
+    tkValues[tk->val].text = text;
+    return tk;
+}
+
+void computeLines(LineTable *lines, const char *text) {
+    lines->n = 0;
+    for (const char *p = text;;) {
+        if (lines->n == lines->cap) {
+            lines->cap = lines->cap ? lines->cap * 2 : 256;
+            int *starts = realloc(lines->starts, lines->cap * sizeof(int));
+            if (!starts) err("not enough memory");
+            lines->starts = starts;
+        }
+        lines->starts[lines->n++] = (int)(p - text);
+        while (*p && *p != '\n' && *p != '\r') p++;
+        if (!*p) break;
+        if (*p == '\r' && p[1] == '\n') p++;
+        p++;
+    }
+    lines->len = lines->starts[lines->n - 1] + (int)strlen(text + lines->starts[lines->n - 1]);
+}
+
+void freeLines(LineTable *lines) {
+    free(lines->starts);
+    lines->starts = NULL;
+    lines->n = lines->cap = lines->len = 0;
+    lines->byLine = false;
+}
+
+int lineOfPos(const LineTable *lines, int pos) {
+    int lo = 0, hi = lines->n - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (lines->starts[mid] <= pos) lo = mid;
+        else hi = mid - 1;
+    }
+    return lo + 1;
+}
+
+int tkLine(const Token *tk) {
+    if (tkLines->byLine) return tk->pos;
+    return lineOfPos(tkLines, tk->pos);
+}
+
+int tkColumn(const Token *tk) {
+    if (tkLines->byLine) return 0;
+    return tk->pos - tkLines->starts[tkLine(tk) - 1] + 1;
+}
+
 char *extract(const char *begin, const char *end) {
     size_t length = end - begin;
     char *result = safeAlloc(length + 1);
@@ -40,400 +385,296 @@ char *extract(const char *begin, const char *end) {
     return result;
 }
 
+// reports an error at the beginning of the current token
+static noreturn void lexErr(const char *fmt, ...) {
+    int pos = (int)(tkBegin - srcBegin), line = lineOfPos(tkLines, pos);
+    va_list va;
+    va_start(va, fmt);
+    verr(line, pos - tkLines->starts[line - 1] + 1, fmt, va);
+}
+
+// the pseudo-codes of the DFA rules which do not make tokens (see tools/lexgen.c)
+enum {
+    LEX_SKIP = 64, // spaces and comments
+    LEX_ERR_FRACTION, LEX_ERR_DOTS, LEX_ERR_EXPONENT, LEX_ERR_EXPONENT_SIGN, LEX_ERR_EXPONENTS,
+    LEX_ERR_CHAR_EMPTY, LEX_ERR_CHAR_END, LEX_ERR_STRING_END, LEX_ERR_SYMBOL
+};
+
+#include "lexdfa.h"
+
+// scans from pch until it adds one token to the list and returns the position after that token
+// the last token is END, for which it returns the position of the ending '\0'
+// each token is the longest text accepted by the DFA: it runs until the dead state and the last accepting state gives the token
+static const char *scanTk(const char *pch) {
+    for (;;) {
+        tkBegin = pch;
+        if (!*pch) {
+            addTk(END);
+            return pch;
+        }
+        const unsigned char *p = (const unsigned char *)pch;
+        const char *end = pch;
+        int code = -1;
+        for (int state = DFA_START; (state = dfaNext[state * DFA_CLASSES + dfaClass[*p]]) != 0; p++) {
+            if (dfaAccept[state] >= 0) {
+                code = dfaAccept[state];
+                end = (const char *)p + 1;
+            }
+        }
+        const char *start = pch;
+        pch = end;
+        Token *tk;
+        switch (code) {
+            case -1: lexErr("invalid char: %c (%d)", *start, *start);
+            case LEX_SKIP: break;
+            case ID:
+                addTextTk(ID, extract(start, end));
+                return pch;
+            case STRING: // a string can continue on the next lines
+                addTextTk(STRING, extract(start + 1, end - 1));
+                return pch;
+            case CHAR:
+                addTk(CHAR)->c = start[1];
+                return pch;
+            case INT:
+                // the literals are converted in place, from the source span
+                tk = addTk(INT);
+                if (!parseInt(start, end, &tk->i))
+                    lexErr("integer constant too large: %.*s", (int)(end - start), start);
+                return pch;
+            case DOUBLE:
+                tk = addTk(DOUBLE);
+                tk->val = newValue();
+                tkValues[tk->val].d = parseDouble(start, end);
+                return pch;
+            case LEX_ERR_FRACTION: lexErr("There is no digit after '.'");
+            case LEX_ERR_DOTS: lexErr("Two '.' for double number were met");
+            case LEX_ERR_EXPONENT: lexErr("There is no digit after 'e/E'");
+            case LEX_ERR_EXPONENT_SIGN: lexErr("There is no digit after '+/-'");
+            case LEX_ERR_EXPONENTS: lexErr("Two 'e/E' for double number were met");
+            case LEX_ERR_CHAR_EMPTY: lexErr("error at \' ");
+            case LEX_ERR_CHAR_END: lexErr("expected \" not \' ");
+            case LEX_ERR_STRING_END: lexErr("missing \" ");
+            case LEX_ERR_SYMBOL: lexErr("invalid symbol: %c (%d)", *start, *start);
+            default:
+                addTk(code);
+                return pch;
+        }
+    }
+}
+
 Token *tokenize(const char *pch) {
-    const char *start;
-    Token *tk;
+    tokens = lastTk = NULL;
+    computeLines(tkLines, pch);
+    tkLines->byLine = tkLines->len > TK_MAX_POS;
+    if (tkLines->byLine && tkLines->n > TK_MAX_POS) err("the source has too many lines (more than %d)", TK_MAX_POS);
+    srcBegin = pch;
+    do {
+        pch = scanTk(pch);
+    } while (lastTk->code != END);
+    return tokens;
+}
+
+// the offset of the last char of a token, if it is after the token's offset: only a string can continue on the next lines
+static int tkLastPos(const Token *tk) {
+    if (tk->code == STRING) return tk->pos + 1 + (int)strlen(tkText(tk)); // the closing "
+    return tk->pos;
+}
+
+static bool sameTk(const Token *a, const Token *b) {
+    if (a->code != b->code) return false;
+    switch (a->code) {
+        case ID:
+        case STRING: return !strcmp(tkText(a), tkText(b));
+        case INT: return a->i == b->i;
+        case DOUBLE: return tkDouble(a) == tkDouble(b);
+        case CHAR: return a->c == b->c;
+        default: return true;
+    }
+}
+
+void lexRecover() {
+    freeTokens(tokens);
+    tokens = lastTk = NULL;
+}
+
+static void freeTk(Token *tk) {
+    if (tk->code == ID || tk->code == STRING) {
+        free(tkValues[tk->val].text);
+        freeValue(tk->val);
+    } else if (tk->code == DOUBLE) {
+        freeValue(tk->val);
+    }
+    tk->next = freeTks;
+    freeTks = tk;
+}
+
+void freeTokens(Token *list) {
+    for (Token *next; list; list = next) {
+        next = list->next;
+        freeTk(list);
+    }
+}
+
+Token *relex(Token *old, const char *text, int firstLine, int lastNewLine, int delta, RelexStats *stats) {
+    // the edit is found by the offsets of the tokens, so the tokens which keep their lines are replaced
+    if (tkLines->byLine || tkLines->len > TK_MAX_POS) {
+        Token *all = tokenize(text);
+        freeTokens(old);
+        stats->firstLine = 1;
+        stats->relexed = 0;
+        for (Token *tk = all; tk; tk = tk->next) stats->relexed++;
+        stats->reusedFrom = INT_MAX;
+        return all;
+    }
+    tokens = lastTk = NULL;
+    const int *starts = tkLines->starts;
+    // the old tokens which end before the edited lines are kept
+    // these tokens are before the edit, so their offsets are the same in the old and in the new text
+    // if a string continues into the first lexed line, the lexing starts again from the line of that string,
+    // which can also begin inside another string
+    Token *kept, *rest;
+    int startLine = firstLine;
     for (;;) {
-        switch (*pch) {
-            case ' ':
-            case '\t':
-                pch++;
-                break;
-            case '\r': // handles different kinds of newlines (Windows: \r\n, Linux: \n, MacOS, OS X: \r or \n)
-                if (pch[1] == '\n')
-                    pch++;
-                // fallthrough to \n
-            case '\n':
-                line++;
-                pch++;
-                break;
-            case '\0':
-                addTk(END);
-                return tokens;
-            case ',':
-                addTk(COMMA);
-                pch++;
-                break;
-            case '(':
-                addTk(LPAR);
-                pch++;
-                break;
-            case ')':
-                addTk(RPAR);
-                pch++;
-                break;
-            case '{':
-                addTk(LACC);
-                pch++;
-                break;
-            case '}':
-                addTk(RACC);
-                pch++;
-                break;
-            case '[':
-                addTk(LBRACKET);
-                pch++;
-                break;
-            case ']':
-                addTk(RBRACKET);
-                pch++;
-                break;
-            case ';':
-                addTk(SEMICOLON);
-                pch++;
-                break;
-            case '+':
-                addTk(ADD);
-                pch++;
-                break;
-            case '*':
-                addTk(MUL);
-                pch++;
-                break;
-            case '-':
-                addTk(SUB);
-                pch++;
-                break;
-            case '!':
-                if (pch[1] == '=') {
-                    addTk(NOTEQ);
-                    pch += 2;
-                    break;
-                } else {
-                    addTk(NOT);
-                    pch += 1;
-                    break;
-                }
-            case '|':
-                if (pch[1] == '|') {
-                    addTk(OR);
-                    pch += 2;
-                } else
-                    err("invalid symbol: %c (%d)", *pch, *pch);
-                break;
-            case '<':
-                if (pch[1] == '=') {
-                    addTk(LESSEQ);
-                    pch += 2;
-                    break;
-                } else {
-                    addTk(LESS);
-                    pch++;
-                    break;
-                }
-            case '>':
-                if (pch[1] == '=') {
-                    addTk(GREATEREQ);
-                    pch += 2;
-                    break;
-                } else {
-                    addTk(GREATER);
-                    pch++;
+        kept = NULL;
+        for (rest = old; rest->code != END && tkLastPos(rest) < starts[startLine - 1]; rest = rest->next) kept = rest;
+        if (rest->code == END || (int)rest->pos >= starts[startLine - 1]) break;
+        startLine = lineOfPos(tkLines, rest->pos);
+    }
+    // the new tokens from this offset are after the edited lines
+    int afterEdit = lastNewLine < tkLines->n ? starts[lastNewLine] : INT_MAX;
+    srcBegin = text;
+    const char *pch = text + starts[startLine - 1];
+    Token *prevNew = NULL, *join = NULL;
+    Token *prevOld = kept, *cand = rest; // cand: the first old token which is not before the last examined line
+    stats->firstLine = startLine;
+    stats->relexed = 0;
+    for (;;) {
+        pch = scanTk(pch);
+        Token *tk = lastTk;
+        stats->relexed++;
+        if (tk->code == END) break;
+        // after the edit, the old and the new tokens may join at the start of a line
+        // if no token continues into that line in both lists, the rest of the text is lexed in the same way as before
+        if ((int)tk->pos >= afterEdit) {
+            int lineStart = starts[tkLine(tk) - 1];
+            if (!prevNew || tkLastPos(prevNew) < lineStart) {
+                // after the edit, the old offsets are shifted by delta
+                int oldLineStart = lineStart - delta, oldPos = (int)tk->pos - delta;
+                for (; cand->code != END && (int)cand->pos < oldLineStart; cand = cand->next) prevOld = cand;
+                if ((int)cand->pos == oldPos && (!prevOld || tkLastPos(prevOld) < oldLineStart) && sameTk(cand, tk)) {
+                    join = cand;
                     break;
                 }
-
-            case '=':
-                if (pch[1] == '=') {
-                    addTk(EQUAL);
-                    pch += 2;
-                } else {
-                    addTk(ASSIGN);
-                    pch++;
-                }
-                break;
-            case '&':
-                if (pch[1] == '&') {
-                    addTk(AND);
-                    pch += 2;
-                } else
-                    err("invalid symbol: %c (%d)", *pch, *pch);
-                break;
-            case '/':
-                if (pch[1] == '/') {
-                    while (*pch != '\0' && *pch != '\n') {
-                        pch++;
-                    }
-                } else {
-                    addTk(DIV);
-                    pch++;
-                }
-                break;
-            case '\'':
-                pch++;
-                start = pch;
-                if (*pch == '\'') {
-                    err("error at \' ");
-                }
-                pch++;
-                char *ch = extract(start, pch);
-                tk = addTk(CHAR);
-                tk->c = *ch;
-                if (*pch != '\'') {
-                    err("expected \" not \' ");
-                }
-                pch++;
-                break;
-            case '"':
-                pch++;
-                start = pch;
-                for (;;) {
-                    if (*pch == '"') {
-                        break;
-                    }
-                    if (*pch == '\0') {
-                        err("missing \" ");
-                        break;
-                    }
-                    pch++;
-                }
-                char *text = extract(start, pch);
-                tk = addTk(STRING);
-                tk->text = text;
-                pch++;
-                break;
-            case '.':
-                addTk(DOT);
-                pch++;
-                break;
-            default:
-                if (isalpha(*pch) || *pch == '_') {
-                    for (start = pch++; isalnum(*pch) || *pch == '_'; pch++) {
-                    }
-                    char *text = extract(start, pch);
-                    if (strcmp(text, "char") == 0)
-                        addTk(TYPE_CHAR);
-                    else if (strcmp(text, "int") == 0)
-                        addTk(TYPE_INT);
-                    else if (strcmp(text, "double") == 0)
-                        addTk(TYPE_DOUBLE);
-                    else if (strcmp(text, "while") == 0)
-                        addTk(WHILE);
-                    else if (strcmp(text, "if") == 0)
-                        addTk(IF);
-                    else if (strcmp(text, "for") == 0)
-                        addTk(FOR);
-                    else if (strcmp(text, "break") == 0)
-                        addTk(BREAK);
-                    else if (strcmp(text, "else") == 0)
-                        addTk(ELSE);
-                    else if (strcmp(text, "struct") == 0)
-                        addTk(STRUCT);
-                    else if (strcmp(text, "return") == 0)
-                        addTk(RETURN);
-                    else if (strcmp(text, "void") == 0)
-                        addTk(VOID);
-                    else {
-                        tk = addTk(ID);
-                        tk->text = text;
-                    }
-                } else if (isdigit(*pch)) {
-                    start = pch;
-                    int dot_seen = 0;
-                    int exponent_seen = 0;
-
-                    while (isdigit(*pch) || *pch == '.' || is_exponent(*pch) || *pch == '+' || *pch == '-') {
-                        if (*pch == '.') {
-                            if (dot_seen) {
-                                printf("Two '.' for double number were met \n");
-                                return NULL;
-                            }
-                            if (!isdigit(*(pch + 1))) {
-                                printf("There is no digit after '.' \n");
-                                return NULL;
-                            }
-                            dot_seen = 1;
-                        }
-                        if (*pch == 'e' || *pch == 'E') {
-                            if (exponent_seen) {
-                                printf("Two 'e/E' for double number were met \n");
-                                return NULL;
-                            }
-                            if (!isdigit(*(pch + 1)) && *(pch + 1) != '+' && *(pch + 1) != '-') {
-                                printf("There is no digit after 'e/E' \n");
-                                return NULL;
-                            }
-                            // Check if there's a '+' or '-' after 'e/E'
-                            if (*(pch + 1) == '+' || *(pch + 1) == '-') {
-                                if (!isdigit(*(pch + 2))) {
-                                    printf("There is no digit after '+/-' \n");
-                                    return NULL;
-                                }
-                            }
-                            exponent_seen = 1;
-                        }
-                        pch++;
-                    }
-
-                    if (*pch == '.' && !isdigit(*(pch + 1)) && *pch == '.') {
-                        printf("No number met after '.' \n");
-                        return NULL;
-                    }
-
-                    char *text = extract(start, pch);
-					 if (dot_seen || exponent_seen) {
-							tk = addTk(DOUBLE);
-							tk->d = atof(text);
-						} else {
-							tk = addTk(INT);
-							tk->i = atoi(text);
-						}
-                } else if (isalpha(*pch) || *pch == '"' || *pch == '\'') {
-                    short intre_ghilimele = 0;
-                    pch++;
-                    for (start = pch++; isalnum(*pch) || *pch == '"' || *pch == '\''; pch++) {
-                        if (*pch == '\'') {
-                            intre_ghilimele = 1;
-                        }
-                    }
-                    if (intre_ghilimele) {
-                        char *character = extract(start, pch - 1);
-                        tk = addTk(CHAR);
-                        tk->c = *character;
-                    } else {
-                        char *text = extract(start, pch - 1);
-                        tk = addTk(STRING);
-                        tk->text = text;
-                    }
-                } else
-                    err("invalid char: %c (%d)", *pch, *pch);
+            }
         }
+        prevNew = tk;
+    }
+    // the replaced old tokens are freed
+    for (Token *next; rest != join; rest = next) {
+        next = rest->next;
+        freeTk(rest);
     }
+    if (join) {
+        // the joining token was lexed again, so it is replaced by the old one
+        freeTk(lastTk);
+        stats->relexed--;
+        if (prevNew) prevNew->next = join;
+        else tokens = join;
+        for (Token *tk = join; tk; tk = tk->next) tk->pos += delta;
+        stats->reusedFrom = tkLine(join);
+    } else {
+        stats->reusedFrom = INT_MAX;
+    }
+    Token *newTokens = tokens;
+    if (kept) {
+        kept->next = newTokens;
+        newTokens = old;
+    }
+    return newTokens;
+}
+
+// the names of the token codes, as they are printed by showTokens
+static const char *tkNames[] = {
+    [ID] = "ID", [INT] = "INT", [DOUBLE] = "DOUBLE", [STRING] = "STRING", [CHAR] = "CHAR",
+    [TYPE_CHAR] = "TYPE_CHAR", [TYPE_INT] = "TYPE_INT", [TYPE_DOUBLE] = "TYPE_DOUBLE", [STRUCT] = "STRUCT", [VOID] = "VOID",
+    [COMMA] = "COMMA", [END] = "END", [SEMICOLON] = "SEMICOLON", [RETURN] = "RETURN",
+    [ASSIGN] = "ASSIGN", [EQUAL] = "EQUAL", [LESS] = "LESS", [DIV] = "DIV", [ADD] = "ADD", [AND] = "AND", [MUL] = "MUL",
+    [FOR] = "FOR", [BREAK] = "BREAK", [SUB] = "SUB", [OR] = "OR", [NOT] = "NOT", [NOTEQ] = "NOTEQ", [LESSEQ] = "LESSEQ",
+    [GREATER] = "GREATER", [GREATEREQ] = "GREATEREQ", [LPAR] = "LPAR", [RPAR] = "RPAR", [LACC] = "LACC", [RACC] = "RACC",
+    [LBRACKET] = "LBRACKET", [RBRACKET] = "RBRACKET", [WHILE] = "WHILE", [IF] = "IF", [ELSE] = "ELSE", [DOT] = "DOT"
+};
+
+const char *tkName(int code) {
+    if (code < 0 || code >= (int)(sizeof(tkNames) / sizeof(tkNames[0])) || !tkNames[code]) return NULL;
+    return tkNames[code];
+}
+
+// showTokens writes into this buffer and flushes it with a single fwrite when it is almost full
+#define OUT_BUF_SIZE (1 << 16)
+#define OUT_MAX_ITEM 64 // the maximum size of an output item, except the texts, which are written in chunks
+
+static char outBuf[OUT_BUF_SIZE];
+static size_t outLen;
+
+static void outFlush(void) {
+    fwrite(outBuf, 1, outLen, stdout);
+    outLen = 0;
+}
+
+static void outReserve(size_t n) {
+    if (outLen + n > OUT_BUF_SIZE) outFlush();
+}
+
+static void outStr(const char *str) {
+    for (; *str; str++) {
+        if (outLen == OUT_BUF_SIZE) outFlush();
+        outBuf[outLen++] = *str;
+    }
+}
+
+static void outInt(int value) {
+    char digits[12];
+    int n = 0;
+    unsigned v = value < 0 ? 0u - (unsigned)value : (unsigned)value;
+    do {
+        digits[n++] = (char)('0' + v % 10);
+        v /= 10;
+    } while (v);
+    outReserve(OUT_MAX_ITEM);
+    if (value < 0) outBuf[outLen++] = '-';
+    while (n) outBuf[outLen++] = digits[--n];
 }
 
 void showTokens(const Token *tokens) {
-    int line_counter = 1;
     for (const Token *tk = tokens; tk; tk = tk->next) {
-        printf("%d\t", tk->line);
+        const char *name = tkName(tk->code);
+        if (!name) continue;
+        outInt(tkLine(tk));
+        outStr("\t");
+        outStr(name);
         switch (tk->code) {
-            case TYPE_INT:
-                printf("TYPE_INT\n");
-                break;
-            case TYPE_CHAR:
-                printf("TYPE_CHAR\n");
-                break;
-            case TYPE_DOUBLE:
-                printf("TYPE_DOUBLE\n");
-                break;
             case ID:
-                printf("ID:%s\n", tk->text);
-                break;
-            case LPAR:
-                printf("LPAR\n");
-                break;
-            case RPAR:
-                printf("RPAR\n");
-                break;
-            case LACC:
-                printf("LACC\n");
-                break;
-            case RACC:
-                printf("RACC\n");
-                break;
-            case LBRACKET:
-                printf("LBRACKET\n");
-                break;
-            case RBRACKET:
-                printf("RBRACKET\n");
-                break;
-            case SEMICOLON:
-                printf("SEMICOLON\n");
+            case STRING:
+                outStr(":");
+                outStr(tkText(tk));
                 break;
             case INT:
-                printf("INT:%d\n", tk->i);
+                outStr(":");
+                outInt(tk->i);
                 break;
             case DOUBLE:
-                printf("DOUBLE:%.2f\n", tk->d);
-                break;
-            case STRING:
-                printf("STRING:%s\n", tk->text);
+                outReserve(OUT_MAX_ITEM);
+                outLen += snprintf(outBuf + outLen, OUT_MAX_ITEM, ":%.2f", tkDouble(tk));
                 break;
             case CHAR:
-                printf("CHAR:%c\n", tk->c);
-                break;
-            case WHILE:
-                printf("WHILE\n");
-                break;
-            case LESS:
-                printf("LESS\n");
-                break;
-            case DIV:
-                printf("DIV\n");
-                break;
-            case ADD:
-                printf("ADD\n");
-                break;
-            case AND:
-                printf("AND\n");
-                break;
-            case MUL:
-                printf("MUL\n");
-                break;
-            case IF:
-                printf("IF\n");
-                break;
-            case ASSIGN:
-                printf("ASSIGN\n");
-                break;
-            case EQUAL:
-                printf("EQUAL\n");
-                break;
-            case RETURN:
-                printf("RETURN\n");
-                break;
-            case END:
-                printf("END\n");
-                break;
-            case ELSE:
-                printf("ELSE\n");
-                break;
-            case FOR:
-                printf("FOR\n");
-                break;
-            case BREAK:
-                printf("BREAK\n");
-                break;
-            case STRUCT:
-                printf("STRUCT\n");
-                break;
-            case VOID:
-                printf("VOID\n");
-                break;
-            case SUB:
-                printf("SUB\n");
-                break;
-            case OR:
-                printf("OR\n");
-                break;
-            case NOT:
-                printf("NOT\n");
-                break;
-            case NOTEQ:
-                printf("NOTEQ\n");
-                break;
-            case LESSEQ:
-                printf("LESSEQ\n");
-                break;
-            case GREATER:
-                printf("GREATER\n");
-                break;
-            case GREATEREQ:
-                printf("GREATEREQ\n");
-                break;
-
-            default:
+                outReserve(OUT_MAX_ITEM);
+                outBuf[outLen++] = ':';
+                outBuf[outLen++] = tk->c;
                 break;
         }
-        line_counter += 1;
+        outStr("\n");
     }
+    outFlush();
+    fflush(stdout);
 }
-
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stdint.h>
+
 enum
 {
 	ID, INT, DOUBLE, STRING, CHAR, 
@@ -8,19 +11,81 @@ enum
 	ASSIGN, EQUAL, LESS, DIV, ADD, AND, MUL,FOR ,BREAK , SUB, OR, NOT, NOTEQ, LESSEQ, GREATER, GREATEREQ, LPAR, RPAR, LACC, RACC, LBRACKET, RBRACKET, WHILE, IF, ELSE, DOT
 };
 
+// a token takes 16 bytes: the values which do not fit in 32 bits are kept in a side table
+// the tokens do not keep their line, which is found from their offset in the lines table (tkLines)
 typedef struct Token
 {
-	int code; // ID, TYPE_CHAR, ...
-	int line; // the line from the input file
+	struct Token *next; // next token in a simple linked list
+	unsigned code : 8;  // ID, TYPE_CHAR, ...
+	unsigned pos : 24;  // the offset of the token in the source text, or its line if the source is longer than TK_MAX_POS
 	union
 	{
-		char *text; // the chars for ID, STRING (dynamically allocated)
-		int i;		// the value for INT
-		char c;		// the value for CHAR
-		double d;	// the value for DOUBLE
+		int i;        // the value for INT
+		char c;       // the value for CHAR
+		uint32_t val; // for ID, STRING, DOUBLE: the index of the value in the side table
 	};
-	struct Token *next; // next token in a simple linked list
 } Token;
 
+// the maximum offset of a token
+// the tokens of a longer source keep their line in pos instead of their offset, so they do not have a column
+#define TK_MAX_POS 0xFFFFFF
+
+// the text for ID, STRING; it lives as long as its token
+const char *tkText(const Token *tk);
+// the value for DOUBLE
+double tkDouble(const Token *tk);
+
+// the offsets of the lines of a text
+typedef struct {
+    int *starts; // starts[i] is the offset of the line i+1
+    int n, cap;
+    int len;     // the length of the text
+    bool byLine; // set by tokenize if the text is longer than TK_MAX_POS: its tokens keep their line
+} LineTable;
+
+// the lines of the source whose tokens are used: tokenize computes them in this table
+// the language server sets it to the lines of the document which it lexes or checks
+// each thread has its own, so the units of a program can be parsed in parallel, each with its lines
+extern _Thread_local LineTable *tkLines;
+
+// computes the lines of a NUL terminated text; the lines end with \n, \r\n or \r
+void computeLines(LineTable *lines, const char *text);
+void freeLines(LineTable *lines);
+// the line (from 1) which contains the offset, found by binary search
+int lineOfPos(const LineTable *lines, int pos);
+// the line and the column (both from 1, the column in bytes) of a token, from tkLines
+// the column is 0 for the tokens of a source longer than TK_MAX_POS
+int tkLine(const Token *tk);
+int tkColumn(const Token *tk);
+
+// returns a new list with the tokens of the text from pch
+// the lines of the text are computed in tkLines
 Token *tokenize(const char *pch);
+
+typedef struct {
+    int firstLine;  // the first line which was lexed again
+    int relexed;    // the number of the new tokens
+    int reusedFrom; // the new line of the first old token which is used after the edit, or INT_MAX if there is none
+} RelexStats;
+
+// updates the tokens list old after an edit of its text, which replaced the lines [firstLine,lastOldLine] with [firstLine,lastNewLine]
+// text is the whole new text, tkLines has its lines and delta is the difference between the new and the old length of the text
+// only the edited lines are lexed again, starting with the first one, until the new tokens join the old ones at a line start
+// the old tokens before and after the edit are reused (the ones after it get their offsets shifted by delta) and the others are freed
+// a text longer than TK_MAX_POS, or whose old tokens keep their lines, is lexed again entirely
+// returns the updated list
+Token *relex(Token *old, const char *text, int firstLine, int lastNewLine, int delta, RelexStats *stats);
+// frees the tokens of the list
+void freeTokens(Token *list);
+// frees the new tokens of a tokenize or relex which was stopped by an error (see errTrap)
+void lexRecover();
+// converts the decimal digits from [begin,end) to an int, directly from the source text
+// returns false if the value does not fit in an int
+bool parseInt(const char *begin, const char *end, int *value);
+// converts the floating-point literal from [begin,end) (digits [.digits] [e|E [+|-] digits])
+// to the nearest double, directly from the source text
+double parseDouble(const char *begin, const char *end);
+// prints the tokens, one per line: line TAB NAME[:value]
 void showTokens(const Token *tokens);
+// returns the name of a token code (ex: "TYPE_INT"), or NULL if code is not valid
+const char *tkName(int code);
@@ -0,0 +1,774 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <threads.h>
+#include <stdatomic.h>
+
+#include "link.h"
+#include "parser.h"
+#include "gc.h"
+#include "vm.h"
+#include "utils.h"
+
+// an object starts with its header: an object with another version, other opcodes or another safe mode is not used
+#define OBJ_MAGIC 0x4a424f41		// "AOBJ"
+#define OBJ_VERSION 2
+
+static double wallSeconds(){
+	struct timespec ts;
+	timespec_get(&ts,TIME_UTC);
+	return (double)ts.tv_sec+ts.tv_nsec*1e-9;
+	}
+
+// FNV-1a
+static uint64_t hashBytes(const char *p,size_t n){
+	uint64_t h=14695981039346656037ull;
+	for(size_t i=0;i<n;i++){
+		h^=(unsigned char)p[i];
+		h*=1099511628211ull;
+		}
+	return h;
+	}
+
+// a hash table from names to symbols, with linear probing
+// it is kept at most half full
+typedef struct{
+	const char *name;		// NULL for a free slot
+	Symbol *s;
+	int unit;		// the index of the unit of s, or -1 for the builtins of the program
+	}LinkSym;
+
+typedef struct{
+	LinkSym *slots;
+	int n,cap;
+	}SymMap;
+
+static void mapInit(SymMap *m,int cap){
+	m->n=0;
+	m->cap=cap;
+	m->slots=(LinkSym*)safeAlloc(cap*sizeof(LinkSym));
+	memset(m->slots,0,cap*sizeof(LinkSym));
+	}
+
+// returns the slot of name, which is free if name is not in m
+static LinkSym *mapFind(SymMap *m,const char *name){
+	unsigned i=(unsigned)hashBytes(name,strlen(name))&(m->cap-1);
+	while(m->slots[i].name&&strcmp(m->slots[i].name,name))i=(i+1)&(m->cap-1);
+	return &m->slots[i];
+	}
+
+// adds s or replaces the symbol with its name
+static void mapAdd(SymMap *m,Symbol *s,int unit){
+	if((m->n+1)*2>m->cap){
+		SymMap old=*m;
+		mapInit(m,old.cap*2);
+		for(int k=0;k<old.cap;k++){
+			if(old.slots[k].name)*mapFind(m,old.slots[k].name)=old.slots[k];
+			}
+		m->n=old.n;
+		free(old.slots);
+		}
+	LinkSym *e=mapFind(m,s->name);
+	if(!e->name)m->n++;
+	*e=(LinkSym){s->name,s,unit};
+	}
+
+// the object file of a unit, which is built or decoded in memory and written or read at once
+// the values are in the host's binary format: the objects are used only on the machine which made them
+typedef struct{
+	const char *path;
+	char *buf;
+	size_t len;		// the size of the object
+	size_t cap;		// the allocated size of buf, while the object is built
+	size_t pos;		// the position of the next value, while the object is decoded
+	Arena *arena;		// the names and the strings which are decoded are allocated here
+	}Obj;
+
+// returns the path of the object of the source file path, replacing its .c extension
+static char *objPathOf(const char *path){
+	size_t n=strlen(path);
+	if(n>2&&!strcmp(path+n-2,".c"))n-=2;
+	char *obj=(char*)safeAlloc(n+sizeof(LINK_OBJ_EXT));
+	memcpy(obj,path,n);
+	strcpy(obj+n,LINK_OBJ_EXT);
+	return obj;
+	}
+
+static void putBytes(Obj *o,const void *p,size_t n){
+	if(o->len+n>o->cap){
+		while(o->len+n>o->cap)o->cap=o->cap?o->cap*2:4096;
+		o->buf=(char*)realloc(o->buf,o->cap);
+		if(!o->buf)err("not enough memory");
+		}
+	memcpy(o->buf+o->len,p,n);
+	o->len+=n;
+	}
+
+static void putInt(Obj *o,int v){
+	putBytes(o,&v,sizeof(v));
+	}
+
+static void putStr(Obj *o,const char *s){
+	int n=(int)strlen(s);
+	putInt(o,n);
+	putBytes(o,s,n);
+	}
+
+// the structs are written by name, which is resolved in the unit when the object is read
+static void putType(Obj *o,TypeId id){
+	Type *t=typeOf(id);
+	putInt(o,t->tb);
+	putInt(o,t->n);
+	if(t->tb==TB_STRUCT)putStr(o,t->s->name);
+	}
+
+static noreturn void objCorrupted(Obj *o){
+	err("the object %s is corrupted (delete it to compile its unit again)",o->path);
+	}
+
+static void getBytes(Obj *o,void *p,size_t n){
+	if(n>o->len-o->pos)objCorrupted(o);
+	memcpy(p,o->buf+o->pos,n);
+	o->pos+=n;
+	}
+
+static int getInt(Obj *o){
+	int v;
+	getBytes(o,&v,sizeof(v));
+	return v;
+	}
+
+// reads the count of the items which follow, each one of at least itemSize bytes
+// a count which cannot fit in the rest of the object is not used to allocate memory
+static int getCount(Obj *o,size_t itemSize){
+	int n=getInt(o);
+	if(n<0||(size_t)n>(o->len-o->pos)/itemSize)objCorrupted(o);
+	return n;
+	}
+
+static char *getStr(Obj *o){
+	int n=getCount(o,1);
+	char *s=(char*)arenaAlloc(o->arena,n+1);
+	getBytes(o,s,n);
+	s[n]='\0';
+	return s;
+	}
+
+// returns the symbol of the given kind with the given name, from the symbols of the unit which is read
+static Symbol *getRef(Obj *o,SymMap *names,SymKind kind){
+	LinkSym *e=mapFind(names,getStr(o));
+	if(!e->name||e->s->kind!=kind)objCorrupted(o);
+	return e->s;
+	}
+
+static TypeId getType(Obj *o,SymMap *names){
+	Type t;
+	t.tb=(TypeBase)getInt(o);
+	t.n=getInt(o);
+	t.s=NULL;
+	if(t.tb<TB_INT||t.tb>TB_STRUCT)objCorrupted(o);
+	if(t.tb==TB_STRUCT)t.s=getRef(o,names,SK_STRUCT);
+	return typeIntern(&t);
+	}
+
+// the global variables of a unit, sorted by their memory, to find the variable of a PUSH_A
+static int cmpVarMem(const void *a,const void *b){
+	const char *x=(const char*)(*(Symbol**)a)->varMem,*y=(const char*)(*(Symbol**)b)->varMem;
+	return x<y?-1:x>y;
+	}
+
+static void putSymbol(Obj *o,Symbol *s){
+	putInt(o,s->kind);
+	putStr(o,s->name);
+	switch(s->kind){
+		case SK_STRUCT:
+			putInt(o,symbolsLen(s->structMembers));
+			for(Symbol *m=s->structMembers;m;m=m->next){
+				putStr(o,m->name);
+				putType(o,m->type);
+				putInt(o,m->varIdx);
+				}
+			break;
+		case SK_VAR:
+			putType(o,s->type);
+			break;
+		case SK_FN:
+			putType(o,s->type);
+			putInt(o,s->fn.prototype);
+			putInt(o,s->fn.frame.paramsSize);
+			putInt(o,s->fn.frame.localsSize);
+			putInt(o,s->fn.frame.align);
+			putInt(o,symbolsLen(s->fn.params));
+			for(Symbol *p=s->fn.params;p;p=p->next){
+				putStr(o,p->name);
+				putType(o,p->type);
+				putInt(o,p->frameOffset);
+				}
+			putInt(o,symbolsLen(s->fn.locals));
+			for(Symbol *v=s->fn.locals;v;v=v->next){
+				putStr(o,v->name);
+				putType(o,v->type);
+				putInt(o,v->frameOffset);
+				putInt(o,v->varIdx);
+				}
+			break;
+		default:
+			err("putSymbol: invalid global symbol %s",s->name);
+		}
+	}
+
+// reads a symbol written by putSymbol and adds it to the current domain, which is the unit's global domain
+static Symbol *getSymbol(Obj *o,SymMap *names){
+	int kind=getInt(o);
+	Symbol *s=newSymbol(getStr(o),(SymKind)kind);
+	switch(kind){
+		case SK_STRUCT:{
+			s->type=typeIntern(&(Type){TB_STRUCT,s,-1});
+			int n=getCount(o,4*sizeof(int));
+			for(int k=0;k<n;k++){
+				Symbol m={.name=getStr(o),.kind=SK_VAR,.owner=s};
+				m.type=getType(o,names);
+				m.varIdx=getInt(o);
+				addSymbolToList(&s->structMembers,dupSymbol(o->arena,&m));
+				}
+			}break;
+		case SK_VAR:
+			s->type=getType(o,names);
+			s->varMem=vmAllocGlobal(typeSize(typeOf(s->type)));
+			break;
+		case SK_FN:{
+			s->type=getType(o,names);
+			s->fn.prototype=getInt(o);
+			s->fn.frame.paramsSize=getInt(o);
+			s->fn.frame.localsSize=getInt(o);
+			s->fn.frame.align=getInt(o);
+			int n=getCount(o,4*sizeof(int));
+			for(int k=0;k<n;k++){
+				Symbol p={.name=getStr(o),.kind=SK_PARAM,.owner=s};
+				p.type=getType(o,names);
+				p.frameOffset=getInt(o);
+				p.paramIdx=k;
+				addSymbolToList(&s->fn.params,dupSymbol(o->arena,&p));
+				}
+			n=getCount(o,5*sizeof(int));
+			for(int k=0;k<n;k++){
+				Symbol v={.name=getStr(o),.kind=SK_VAR,.owner=s};
+				v.type=getType(o,names);
+				v.frameOffset=getInt(o);
+				v.varIdx=getInt(o);
+				addSymbolToList(&s->fn.locals,dupSymbol(&s->fn.arena,&v));
+				}
+			}break;
+		default:
+			objCorrupted(o);
+		}
+	mapAdd(names,s,0);
+	return s;
+	}
+
+// the code refers to the functions and to the global variables by name, and the jumps are by index
+static void putCode(Obj *o,Symbol *fn,Symbol **vars,int nVars){
+	InstrIndex index;
+	initInstrIndex(&index,fn->fn.instr);
+	putInt(o,index.n);
+	for(int k=0;k<index.n;k++){
+		Instr *i=index.instrs[k];
+		putInt(o,i->op);
+		putInt(o,i->line);
+		switch(i->op){
+			case OP_JMP:case OP_JF:case OP_JT:
+				putInt(o,instrIndex(&index,i->arg.instr));
+				break;
+			case OP_CALL:case OP_CALL_EXT:
+				putStr(o,((Symbol*)i->arg.p)->name);
+				break;
+			case OP_PUSH_A:{
+				// the address of a global variable, or a string constant
+				Symbol key={.varMem=i->arg.p},*pKey=&key;
+				Symbol **var=(Symbol**)bsearch(&pKey,vars,nVars,sizeof(Symbol*),cmpVarMem);
+				putInt(o,var!=NULL);
+				putStr(o,var?(*var)->name:(const char*)i->arg.p);
+				}break;
+			default:
+				putBytes(o,&i->arg,sizeof(InstrArg));
+			}
+		}
+	freeInstrIndex(&index);
+	}
+
+static void getCode(Obj *o,Symbol *fn,SymMap *names){
+	// each instruction has at least its opcode and its line
+	int n=getCount(o,2*sizeof(int));
+	if(!n)objCorrupted(o);
+	// the jumps can go forward, so all the instructions are allocated first
+	Instr **instrs=(Instr**)safeAlloc(n*sizeof(Instr*));
+	for(int k=0;k<n;k++)instrs[k]=newInstr(OP_NOP);
+	for(int k=0;k<n;k++){
+		Instr *i=instrs[k];
+		int op=getInt(o);
+		if(op<0||op>=OP_COUNT)objCorrupted(o);
+		i->op=(Opcode)op;
+		i->line=getInt(o);
+		switch(i->op){
+			case OP_JMP:case OP_JF:case OP_JT:{
+				int target=getInt(o);
+				if(target<0||target>=n)objCorrupted(o);
+				i->arg.instr=instrs[target];
+				}break;
+			case OP_CALL:case OP_CALL_EXT:
+				i->arg.p=getRef(o,names,SK_FN);
+				break;
+			case OP_PUSH_A:
+				i->arg.p=getInt(o)?getRef(o,names,SK_VAR)->varMem:getStr(o);
+				break;
+			default:
+				getBytes(o,&i->arg,sizeof(InstrArg));
+			}
+		if(k)instrs[k-1]->next=i;
+		}
+	fn->fn.instr=instrs[0];
+	free(instrs);
+	}
+
+static bool hasCode(Symbol *s){
+	return s->kind==SK_FN&&!s->fn.extFnPtr&&!s->fn.prototype;
+	}
+
+// writes the unit's symbols, without the builtins, and their code in its object
+// the object is written in a temporary file, which replaces the old object only when it is complete
+static void saveObject(Unit *u){
+	char *path=objPathOf(u->path);
+	Obj o={.path=path};
+	putInt(&o,OBJ_MAGIC);
+	putInt(&o,OBJ_VERSION);
+	putInt(&o,OP_COUNT);
+	putInt(&o,gcBoundsChecks);
+	putBytes(&o,&u->hash,sizeof(u->hash));
+	// the checksum of the rest of the object, which is written after the rest is built
+	size_t sumPos=o.len;
+	uint64_t sum=0;
+	putBytes(&o,&sum,sizeof(sum));
+	int n=0,nVars=0;
+	for(Symbol *s=u->domain->symbols;s;s=s->next){
+		if(s->kind==SK_FN&&s->fn.extFnPtr)continue;
+		n++;
+		if(s->kind==SK_VAR)nVars++;
+		}
+	Symbol **vars=(Symbol**)safeAlloc((nVars+1)*sizeof(Symbol*));
+	nVars=0;
+	for(Symbol *s=u->domain->symbols;s;s=s->next){
+		if(s->kind==SK_VAR)vars[nVars++]=s;
+		}
+	qsort(vars,nVars,sizeof(Symbol*),cmpVarMem);
+	putInt(&o,n);
+	for(Symbol *s=u->domain->symbols;s;s=s->next){
+		if(!(s->kind==SK_FN&&s->fn.extFnPtr))putSymbol(&o,s);
+		}
+	// the code is after all the symbols, because a function can call the functions defined after its prototype
+	for(Symbol *s=u->domain->symbols;s;s=s->next){
+		if(hasCode(s))putCode(&o,s,vars,nVars);
+		}
+	free(vars);
+	sum=hashBytes(o.buf+sumPos+sizeof(sum),o.len-sumPos-sizeof(sum));
+	memcpy(o.buf+sumPos,&sum,sizeof(sum));
+	char *tmp=(char*)safeAlloc(strlen(path)+5);
+	sprintf(tmp,"%s.tmp",path);
+	FILE *f=fopen(tmp,"wb");
+	if(!f)err("cannot write %s",tmp);
+	bool written=fwrite(o.buf,1,o.len,f)==o.len;
+	if(fclose(f)||!written)err("cannot write %s",tmp);
+	free(o.buf);
+#ifdef _WIN32
+	remove(path);
+#endif
+	if(rename(tmp,path))err("cannot write %s",path);
+	free(tmp);
+	free(path);
+	}
+
+// loads the unit from its object in a new global domain
+// returns false if there is no object, or if it was made from another source or by another compiler
+static bool loadObject(Unit *u){
+	char *path=objPathOf(u->path);
+	FILE *f=fopen(path,"rb");
+	if(!f){
+		free(path);
+		return false;
+		}
+	Obj o={.path=path};
+	if(!fseek(f,0,SEEK_END)){
+		long size=ftell(f);
+		if(size>0&&!fseek(f,0,SEEK_SET)){
+			o.buf=(char*)safeAlloc(size);
+			o.len=fread(o.buf,1,size,f);
+			}
+		}
+	fclose(f);
+	int header[4];
+	uint64_t hash,sum;
+	bool current=o.len>=sizeof(header)+sizeof(hash)+sizeof(sum);
+	if(current){
+		getBytes(&o,header,sizeof(header));
+		getBytes(&o,&hash,sizeof(hash));
+		current=header[0]==OBJ_MAGIC&&header[1]==OBJ_VERSION&&header[2]==OP_COUNT&&header[3]==gcBoundsChecks&&hash==u->hash;
+		}
+	if(!current){
+		free(o.buf);
+		free(path);
+		return false;
+		}
+	// the values of the object (frame offsets, slots, sizes) are used by the VM without other checks,
+	// so a changed byte must be found before the object is decoded
+	getBytes(&o,&sum,sizeof(sum));
+	if(sum!=hashBytes(o.buf+o.pos,o.len-o.pos))objCorrupted(&o);
+	Domain *saved=symTable;
+	symTable=NULL;
+	u->domain=pushDomain();
+	vmInit();
+	o.arena=&u->domain->arena;
+	SymMap names;
+	mapInit(&names,64);
+	Symbol **tail=&u->domain->symbols;
+	for(Symbol *s=u->domain->symbols;s;s=s->next){
+		mapAdd(&names,s,0);
+		tail=&s->next;
+		}
+	Symbol **first=tail;
+	int n=getCount(&o,2*sizeof(int));
+	for(int k=0;k<n;k++){
+		*tail=getSymbol(&o,&names);
+		tail=&(*tail)->next;
+		}
+	for(Symbol *s=*first;s;s=s->next){
+		if(hasCode(s))getCode(&o,s,&names);
+		}
+	free(names.slots);
+	free(o.buf);
+	free(path);
+	symTable=saved;
+	u->loaded=true;
+	return true;
+	}
+
+// lexes the unit
+// the lexer's tables are shared, so the units are lexed by a single thread, before they are compiled
+static void lexUnit(Unit *u){
+	LineTable *saved=tkLines;
+	tkLines=&u->lines;
+	errFile=u->path;
+	u->tokens=tokenize(u->src);
+	errFile=NULL;
+	tkLines=saved;
+	}
+
+// compiles the unit in its own global domain
+// with nThreads>1 its function bodies are parsed in parallel
+static void compileUnit(Unit *u,int nThreads){
+	Domain *saved=symTable;
+	LineTable *savedLines=tkLines;
+	symTable=NULL;
+	tkLines=&u->lines;
+	errFile=u->path;
+	u->domain=pushDomain();
+	vmInit();
+	if(nThreads>1){
+		parseDeclarations(u->tokens);
+		parseBodiesParallel(nThreads);
+		}else{
+		parse(u->tokens);
+		}
+	errFile=NULL;
+	tkLines=savedLines;
+	symTable=saved;
+	}
+
+// the work shared by the threads which compile the units
+typedef struct{
+	Unit **units;
+	int n;
+	bool incremental;
+	atomic_int next;		// the index of the next unit to be compiled
+	}UnitsWork;
+
+static int unitsWorker(void *arg){
+	UnitsWork *work=(UnitsWork*)arg;
+	for(;;){
+		int k=atomic_fetch_add(&work->next,1);
+		if(k>=work->n)break;
+		compileUnit(work->units[k],1);
+		if(work->incremental)saveObject(work->units[k]);
+		}
+	parseThreadExit();
+	return 0;
+	}
+
+static void compileUnits(Unit **units,int n,int nThreads,bool incremental){
+	if(n==1){
+		compileUnit(units[0],nThreads);
+		if(incremental)saveObject(units[0]);
+		return;
+		}
+	if(nThreads>n)nThreads=n;
+	if(nThreads<1)nThreads=1;
+	UnitsWork work={units,n,incremental,0};
+	// the calling thread is one of the workers, so all the units are compiled even if no thread can be created
+	thrd_t *threads=(thrd_t*)safeAlloc(nThreads*sizeof(thrd_t));
+	int nStarted=0;
+	for(;nStarted<nThreads-1;nStarted++){
+		if(thrd_create(&threads[nStarted],unitsWorker,&work)!=thrd_success)break;
+		}
+	unitsWorker(&work);
+	for(int i=0;i<nStarted;i++)thrd_join(threads[i],NULL);
+	free(threads);
+	}
+
+// the global variables declared in several units are a single variable: the first declaration
+// in the code, the memory of the other declarations is replaced with the memory of the first one
+typedef struct{
+	void *mem;
+	void *to;
+	}VarReloc;
+
+static int cmpReloc(const void *a,const void *b){
+	const char *x=(const char*)((VarReloc*)a)->mem,*y=(const char*)((VarReloc*)b)->mem;
+	return x<y?-1:x>y;
+	}
+
+typedef struct{
+	Unit *units;
+	SymMap map;		// the symbols of the program, and the functions which are only declared yet
+	VarReloc *relocs;
+	int nRelocs,relocsCap;
+	LinkStats *stats;
+	}Linker;
+
+static const char *kindName(SymKind kind){
+	switch(kind){
+		case SK_VAR:return "variable";
+		case SK_PARAM:return "parameter";
+		case SK_FN:return "function";
+		default:return "struct";
+		}
+	}
+
+// true if a and b are the same type in two units
+// each unit has its own structs, so they are compared by name; the structs with the same name are checked to be the same
+static bool sameLinkType(TypeId a,TypeId b){
+	Type *x=typeOf(a),*y=typeOf(b);
+	if(x->tb!=y->tb||x->n!=y->n)return false;
+	return x->tb!=TB_STRUCT||!strcmp(x->s->name,y->s->name);
+	}
+
+static bool sameMembers(Symbol *a,Symbol *b){
+	for(;a&&b;a=a->next,b=b->next){
+		if(strcmp(a->name,b->name)||!sameLinkType(a->type,b->type))return false;
+		}
+	return !a&&!b;
+	}
+
+// the parameters can have other names, as in C
+static bool sameSignature(Symbol *a,Symbol *b){
+	if(!sameLinkType(a->type,b->type))return false;
+	Symbol *x=a->fn.params,*y=b->fn.params;
+	for(;x&&y;x=x->next,y=y->next){
+		if(!sameLinkType(x->type,y->type))return false;
+		}
+	return !x&&!y;
+	}
+
+// adds the global symbol s of the unit k to the program, or checks it against the symbol with the same name from the other units
+// returns true if s is moved in the program's domain, or false if it remains in the unit's domain
+static bool linkSymbol(Linker *l,int k,Symbol *s){
+	if(s->kind==SK_FN&&s->fn.extFnPtr)return false;		// the program has its own builtins
+	LinkSym *e=mapFind(&l->map,s->name);
+	if(!e->name){
+		mapAdd(&l->map,s,k);
+		return !(s->kind==SK_FN&&s->fn.prototype);
+		}
+	Symbol *prev=e->s;
+	const char *prevPath=e->unit>=0?l->units[e->unit].path:"the builtins";
+	if(prev->kind!=s->kind)err("%s is a %s, but in %s it is a %s",s->name,kindName(s->kind),prevPath,kindName(prev->kind));
+	l->stats->shared++;
+	switch(s->kind){
+		case SK_STRUCT:
+			if(!sameMembers(prev->structMembers,s->structMembers))err("the struct %s has other members in %s",s->name,prevPath);
+			return false;
+		case SK_VAR:
+			if(!sameLinkType(prev->type,s->type))err("the variable %s has another type in %s",s->name,prevPath);
+			if(l->nRelocs==l->relocsCap){
+				l->relocsCap=l->relocsCap?l->relocsCap*2:16;
+				l->relocs=(VarReloc*)realloc(l->relocs,l->relocsCap*sizeof(VarReloc));
+				if(!l->relocs)err("not enough memory");
+				}
+			l->relocs[l->nRelocs++]=(VarReloc){s->varMem,prev->varMem};
+			return false;
+		default:
+			if(!sameSignature(prev,s))err("the function %s has another signature in %s",s->name,prevPath);
+			if(s->fn.prototype)return false;
+			if(!prev->fn.prototype)err("the function %s is also defined in %s",s->name,prevPath);
+			// the definition replaces the prototypes
+			mapAdd(&l->map,s,k);
+			return true;
+		}
+	}
+
+// changes the calls of fn's code to the functions of the program, and the repeated global variables to their first declaration
+static void relocate(Linker *l,Symbol *fn){
+	for(Instr *i=fn->fn.instr;i;i=i->next){
+		switch(i->op){
+			case OP_CALL:case OP_CALL_EXT:{
+				Symbol *callee=(Symbol*)i->arg.p;
+				Symbol *def=mapFind(&l->map,callee->name)->s;
+				if(!def||def->fn.prototype)err("the function %s is called from %s, but it is not defined in any unit",callee->name,fn->name);
+				if(def!=callee){
+					i->arg.p=def;
+					l->stats->relocated++;
+					}
+				}break;
+			case OP_PUSH_A:{
+				if(!l->nRelocs)break;
+				VarReloc key={i->arg.p,NULL};
+				VarReloc *r=(VarReloc*)bsearch(&key,l->relocs,l->nRelocs,sizeof(VarReloc),cmpReloc);
+				if(r){
+					i->arg.p=r->to;
+					l->stats->relocated++;
+					}
+				}break;
+			default:break;
+			}
+		}
+	}
+
+// the lines of the units which were linked last, for the errors of the running program
+static const Unit *linkedUnits;
+static int nLinkedUnits;
+static void (*unlinkedLineName)(int line,char *buf,size_t size);		// vmLineName before linkedUnits
+
+static void unitLineName(int line,char *buf,size_t size){
+	const Unit *u=&linkedUnits[unitOfLine(linkedUnits,nLinkedUnits,line)];
+	snprintf(buf,size,"%s, line %d",u->path,line-u->firstLine);
+	}
+
+int unitOfLine(const Unit *units,int nUnits,int line){
+	int lo=0,hi=nUnits-1;
+	while(lo<hi){
+		int mid=(lo+hi+1)/2;
+		if(units[mid].firstLine<line)lo=mid;
+		else hi=mid-1;
+		}
+	return lo;
+	}
+
+// numbers the lines of fn's code in the program, after the lines of the previous units
+static void numberLines(Symbol *fn,int firstLine){
+	if(!firstLine)return;
+	for(Instr *i=fn->fn.instr;i;i=i->next){
+		if(i->line)i->line+=firstLine;
+		}
+	}
+
+// moves the symbols of the units in the current domain, in the units' order, and resolves the references between them
+static void linkUnits(Unit *units,int nUnits,LinkStats *stats){
+	Linker l={units,{NULL,0,0},NULL,0,0,stats};
+	mapInit(&l.map,64);
+	Symbol **tail=&symTable->symbols;
+	for(Symbol *s=symTable->symbols;s;s=s->next){
+		mapAdd(&l.map,s,-1);
+		tail=&s->next;
+		}
+	Symbol **first=tail;
+	for(int k=0;k<nUnits;k++){
+		errFile=units[k].path;
+		Symbol **kept=&units[k].domain->symbols;
+		for(Symbol *s=*kept,*next;s;s=next){
+			next=s->next;
+			s->next=NULL;
+			if(linkSymbol(&l,k,s)){
+				*tail=s;
+				tail=&s->next;
+				stats->symbols++;
+				}else{
+				*kept=s;
+				kept=&s->next;
+				}
+			}
+		*kept=NULL;
+		}
+	if(l.nRelocs)qsort(l.relocs,l.nRelocs,sizeof(VarReloc),cmpReloc);
+	for(Symbol *s=*first;s;s=s->next){
+		if(s->kind!=SK_FN)continue;
+		Unit *u=&units[mapFind(&l.map,s->name)->unit];
+		errFile=u->path;
+		relocate(&l,s);
+		numberLines(s,u->firstLine);
+		}
+	errFile=NULL;
+	free(l.map.slots);
+	free(l.relocs);
+	}
+
+Unit *linkProgram(const char **paths,int nPaths,int nThreads,bool incremental,LinkStats *stats){
+	if(symTable->parent)err("linkProgram: the current domain must be the global one");
+	double start=wallSeconds();
+	Unit *units=(Unit*)safeAlloc(nPaths*sizeof(Unit));
+	Unit **stale=(Unit**)safeAlloc(nPaths*sizeof(Unit*));
+	int nStale=0;
+	for(int k=0,firstLine=0;k<nPaths;k++){
+		Unit *u=&units[k];
+		*u=(Unit){.path=paths[k],.firstLine=firstLine};
+		u->src=loadFile(u->path);
+		// the lines end as in computeLines: \n, \r\n or \r
+		for(const char *p=u->src;*p;p++)firstLine+=*p=='\n'||(*p=='\r'&&p[1]!='\n');
+		firstLine++;
+		u->hash=hashBytes(u->src,strlen(u->src));
+		if(incremental&&loadObject(u)){
+			stats->loaded++;
+			continue;
+			}
+		lexUnit(u);
+		stale[nStale++]=u;
+		}
+	compileUnits(stale,nStale,nThreads,incremental);
+	free(stale);
+	stats->units+=nPaths;
+	stats->compiled+=nStale;
+	double compiled=wallSeconds();
+	stats->compileSeconds+=compiled-start;
+	linkUnits(units,nPaths,stats);
+	stats->linkSeconds+=wallSeconds()-compiled;
+	if(nPaths>1){
+		if(!linkedUnits)unlinkedLineName=vmLineName;
+		linkedUnits=units;
+		nLinkedUnits=nPaths;
+		vmLineName=unitLineName;
+		}
+	return units;
+	}
+
+void freeUnits(Unit *units,int nUnits){
+	if(units==linkedUnits){
+		linkedUnits=NULL;
+		vmLineName=unlinkedLineName;
+		}
+	Domain *saved=symTable;
+	for(int k=0;k<nUnits;k++){
+		Unit *u=&units[k];
+		if(u->domain){
+			symTable=u->domain;
+			dropDomain();
+			}
+		freeTokens(u->tokens);
+		freeLines(&u->lines);
+		free(u->src);
+		}
+	symTable=saved;
+	free(units);
+	}
+
+void showLinkStats(LinkStats *stats){
+	printf("// linking: %d units, %d compiled and %d loaded from their objects, in %.6f s\n",
+		stats->units,stats->compiled,stats->loaded,stats->compileSeconds);
+	printf("//\tsymbols: %d, shared declarations: %d, relocated instructions: %d, in %.6f s\n",
+		stats->symbols,stats->shared,stats->relocated,stats->linkSeconds);
+	}
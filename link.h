@@ -0,0 +1,57 @@
+#pragma once
+
+// the separate compilation of the units of a program and their linking
+// each unit (a source file) is compiled alone, in its own global domain, so the units can be compiled in parallel
+// a unit declares what it uses from the other units: the functions by their prototypes (int f(int a);),
+// the structs and the global variables by the same definitions as in the other units
+// the linker puts the symbols of all the units in one global domain, checks that the shared declarations have the same types
+// and resolves the references between the units
+// a compiled unit can be saved in its object file (its symbols and its VM code), which is loaded instead of compiling
+// the unit again, while its source does not change
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "lexer.h"
+#include "ad.h"
+
+// the object of the unit x.c is x.ao
+#define LINK_OBJ_EXT ".ao"
+
+typedef struct{
+	const char *path;		// the source file
+	char *src;
+	uint64_t hash;		// the hash of src, which is kept in the object to find if it is up to date
+	LineTable lines;
+	Token *tokens;		// the tokens of a compiled unit, whose texts are used by the code (the strings)
+	Domain *domain;		// the unit's global domain, with its builtins and the symbols which were not moved in the program
+	bool loaded;		// loaded from its object, instead of being compiled
+	// the lines of the program's code are numbered across the units, so each line of each unit has its own number:
+	// the line n of this unit is the line firstLine+n of the program (0 for the first unit)
+	// the objects keep the lines of their unit, which are numbered again by each link
+	int firstLine;
+	}Unit;
+
+typedef struct{
+	int units;
+	int compiled;		// the units compiled from their sources
+	int loaded;		// the units loaded from their objects, because their sources did not change
+	int symbols;		// the symbols of the program, without the builtins
+	int shared;		// the declarations of the symbols which are defined or declared in other units too
+	int relocated;		// the instructions changed to refer to the symbols of the program
+	double compileSeconds;		// the wall time to load or compile the units
+	double linkSeconds;
+	}LinkStats;
+
+// compiles the units from the given files with nThreads threads and links them in the current domain,
+// which must be the global one, with the builtins (vmInit)
+// each thread compiles whole units; a single unit is compiled with all the threads (parseBodiesParallel)
+// if incremental is true, each compiled unit is saved in its object, and a unit whose object has the hash of its source
+// is loaded from the object
+// returns the nPaths units, which must be freed with freeUnits after the current domain is dropped
+Unit *linkProgram(const char **paths,int nPaths,int nThreads,bool incremental,LinkStats *stats);
+// the index of the unit which has the given line of the program (see Unit.firstLine)
+int unitOfLine(const Unit *units,int nUnits,int line);
+// frees the units and the symbols which they keep
+void freeUnits(Unit *units,int nUnits);
+void showLinkStats(LinkStats *stats);
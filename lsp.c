@@ -0,0 +1,503 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <limits.h>
+#include <setjmp.h>
+#include <time.h>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#endif
+
+#include "lsp.h"
+#include "json.h"
+#include "lexer.h"
+#include "parser.h"
+#include "ad.h"
+#include "vm.h"
+#include "utils.h"
+
+typedef struct{
+	int line;		// the line of the error (from 1, as in the tokens), or 0 if it is not known
+	int column;		// the column of the error (from 1, in bytes), or 0 if it is not known
+	char *msg;
+	Symbol *fn;		// the function whose body has the error, or NULL for the errors outside the bodies
+	}Diagnostic;
+
+// a function body, as it was checked the last time
+typedef struct{
+	Symbol *fn;
+	Token *lacc;		// the { which begins the body
+	Token *after;		// the token after the } which ends the body
+	int laccLine,raccLine,afterLine;
+	}Body;
+
+typedef struct Document{
+	char *uri;
+	char *text;		// NUL terminated
+	size_t len,cap;
+	LineTable lines;
+	Token *tokens;		// NULL if the text could not be lexed
+	Domain *globals;		// the global domain of the document, or NULL if it was not checked
+	Body *bodies;		// in their definition order
+	int nBodies,bodiesCap;
+	Diagnostic *diags;
+	int nDiags,diagsCap;
+	struct Document *next;
+	}Document;
+
+static Document *docs;
+
+static double nowMs(){
+	struct timespec ts;
+	timespec_get(&ts,TIME_UTC);
+	return (double)ts.tv_sec*1e3+(double)ts.tv_nsec/1e6;
+	}
+
+// grows an array to hold at least n elements
+static void *grow(void *arr,int *cap,int n,size_t elemSize){
+	if(n<=*cap)return arr;
+	int newCap=*cap?*cap:16;
+	while(newCap<n)newCap*=2;
+	arr=realloc(arr,(size_t)newCap*elemSize);
+	if(!arr)err("not enough memory");
+	*cap=newCap;
+	return arr;
+	}
+
+// the index of the line which contains the offset
+static int lineOf(Document *doc,size_t offset){
+	return lineOfPos(&doc->lines,(int)offset)-1;
+	}
+
+// the offset of the end of the line's content, before its line break
+static size_t lineEnd(Document *doc,int line){
+	size_t i=(size_t)doc->lines.starts[line];
+	while(i<doc->len&&doc->text[i]!='\n'&&doc->text[i]!='\r')i++;
+	return i;
+	}
+
+// the LSP positions count the characters in UTF-16 code units
+// the characters outside the BMP take 4 bytes in UTF-8 and 2 units in UTF-16
+static size_t offsetOf(Document *doc,int line,int character){
+	if(line<0)return 0;
+	if(line>=doc->lines.n)return doc->len;
+	size_t i=(size_t)doc->lines.starts[line],end=lineEnd(doc,line);
+	for(int units=0;i<end&&units<character;){
+		unsigned char c=(unsigned char)doc->text[i];
+		int n=c<0x80?1:c<0xE0?2:c<0xF0?3:4;
+		units+=n==4?2:1;
+		for(i++;i<end&&--n>0;i++){}
+		}
+	return i;
+	}
+
+static int utf16Len(const char *begin,const char *end){
+	int units=0;
+	for(const unsigned char *p=(const unsigned char*)begin;p<(const unsigned char*)end;p++){
+		if((*p&0xC0)!=0x80)units+=*p>=0xF0?2:1;
+		}
+	return units;
+	}
+
+static void addDiag(Document *doc,int line,int column,const char *msg,Symbol *fn){
+	doc->diags=(Diagnostic*)grow(doc->diags,&doc->diagsCap,doc->nDiags+1,sizeof(Diagnostic));
+	char *copy=(char*)safeAlloc(strlen(msg)+1);
+	strcpy(copy,msg);
+	doc->diags[doc->nDiags++]=(Diagnostic){line,column,copy,fn};
+	}
+
+// removes the diagnostics of fn (all of them if fn is NULL)
+static void removeDiags(Document *doc,Symbol *fn){
+	int n=0;
+	for(int i=0;i<doc->nDiags;i++){
+		if(!fn||doc->diags[i].fn==fn)free(doc->diags[i].msg);
+		else doc->diags[n++]=doc->diags[i];
+		}
+	doc->nDiags=n;
+	}
+
+static void dropGlobals(Document *doc){
+	if(!doc->globals)return;
+	symTable=doc->globals;
+	dropDomain();
+	doc->globals=NULL;
+	doc->nBodies=0;
+	}
+
+typedef enum{CHECK_DECLARATIONS,CHECK_BODY,RECHECK_BODY}CheckKind;
+
+// runs a check of the document in its global domain
+// an error becomes a diagnostic of fn and the domains of the interrupted check are dropped
+static bool runCheck(Document *doc,CheckKind kind,Symbol *fn,Token *body){
+	jmp_buf trap;
+	symTable=doc->globals;
+	errTrap=&trap;
+	if(setjmp(trap)){
+		errTrap=NULL;
+		parseRecover();
+		while(symTable!=doc->globals)dropDomain();
+		addDiag(doc,errLine,errColumn,errMsg,fn);
+		return false;
+		}
+	switch(kind){
+		case CHECK_DECLARATIONS:parseDeclarations(doc->tokens);break;
+		case CHECK_BODY:parseFnBody(fn);break;
+		case RECHECK_BODY:reparseFnBody(fn,body);break;
+		}
+	errTrap=NULL;
+	return true;
+	}
+
+static bool lexDocument(Document *doc){
+	jmp_buf trap;
+	errTrap=&trap;
+	if(setjmp(trap)){
+		errTrap=NULL;
+		lexRecover();
+		addDiag(doc,errLine,errColumn,errMsg,NULL);
+		return false;
+		}
+	doc->tokens=tokenize(doc->text);
+	errTrap=NULL;
+	return true;
+	}
+
+// the } which matches lacc
+static Token *matchBrace(Token *lacc){
+	int depth=0;
+	for(Token *tk=lacc;tk->code!=END;tk=tk->next){
+		if(tk->code==LACC)depth++;
+		else if(tk->code==RACC&&--depth==0)return tk;
+		}
+	return NULL;
+	}
+
+// lexes (if needed) and checks all the document, in a new global domain
+// the declarations are checked first, and then each body: an error in a body does not stop the checking of the other bodies
+static void checkDocumentNow(Document *doc){
+	tkLines=&doc->lines;
+	removeDiags(doc,NULL);
+	dropGlobals(doc);
+	if(!doc->tokens&&!lexDocument(doc))return;
+	symTable=NULL;
+	doc->globals=pushDomain();
+	vmInit();
+	runCheck(doc,CHECK_DECLARATIONS,NULL,NULL);
+	for(Symbol *fn=doc->globals->symbols;fn;fn=fn->next){
+		if(fn->kind!=SK_FN)continue;
+		Token *lacc=lazyBodyOf(fn);
+		if(!lacc)continue;
+		Token *racc=matchBrace(lacc);
+		doc->bodies=(Body*)grow(doc->bodies,&doc->bodiesCap,doc->nBodies+1,sizeof(Body));
+		doc->bodies[doc->nBodies++]=(Body){fn,lacc,racc->next,tkLine(lacc),tkLine(racc),tkLine(racc->next)};
+		runCheck(doc,CHECK_BODY,fn,NULL);
+		}
+	symTable=NULL;
+	}
+
+// the symbols of the checked documents are dropped when they are checked again, but their global variables and types remain
+// when these become too many, everything is dropped and all the documents are checked again
+static void checkDocument(Document *doc){
+	if(vmGlobalsSize()>LSP_MAX_GLOBALS||typesCount()>LSP_MAX_TYPES){
+		for(Document *d=docs;d;d=d->next)dropGlobals(d);
+		vmFreeGlobals();
+		resetTypes();
+		for(Document *d=docs;d;d=d->next){
+			if(d!=doc)checkDocumentNow(d);
+			}
+		}
+	checkDocumentNow(doc);
+	}
+
+static void shiftLine(int *line,int lastOldLine,int delta){
+	if(*line>lastOldLine)*line+=delta;
+	}
+
+// applies an edit which replaces [start,end) with text
+// returns true if only a function body was checked again
+static bool applyEdit(Document *doc,size_t start,size_t end,const char *text,LspStats *stats){
+	int oldNLines=doc->lines.n;
+	int firstLine=lineOf(doc,start)+1,lastOldLine=lineOf(doc,end)+1;
+	size_t n=strlen(text);
+	if(doc->len-(end-start)+n+1>doc->cap){
+		doc->cap=(doc->len-(end-start)+n+1)*2;
+		doc->text=(char*)realloc(doc->text,doc->cap);
+		if(!doc->text)err("not enough memory");
+		}
+	memmove(doc->text+start+n,doc->text+end,doc->len-end+1);
+	memcpy(doc->text+start,text,n);
+	doc->len=doc->len-(end-start)+n;
+	computeLines(&doc->lines,doc->text);
+	// an inserted \n after a \r joins the two in a single line break, so the edit can begin on the previous line
+	int newFirstLine=lineOf(doc,start)+1;
+	if(newFirstLine<firstLine)firstLine=newFirstLine;
+	int delta=doc->lines.n-oldNLines,lastNewLine=lastOldLine+delta;
+	if(!doc->tokens||lastNewLine<firstLine){
+		if(doc->tokens){
+			freeTokens(doc->tokens);
+			doc->tokens=NULL;
+			}
+		checkDocument(doc);
+		return false;
+		}
+	// the body which contains all the edited lines, without its first and last lines
+	Body *body=NULL;
+	for(int i=0;i<doc->nBodies;i++){
+		if(doc->bodies[i].laccLine<firstLine&&lastOldLine<doc->bodies[i].raccLine)body=&doc->bodies[i];
+		}
+	jmp_buf trap;
+	RelexStats rs;
+	errTrap=&trap;
+	if(setjmp(trap)){
+		errTrap=NULL;
+		lexRecover();
+		freeTokens(doc->tokens);
+		doc->tokens=NULL;
+		dropGlobals(doc);
+		removeDiags(doc,NULL);
+		addDiag(doc,errLine,errColumn,errMsg,NULL);
+		return false;
+		}
+	tkLines=&doc->lines;
+	doc->tokens=relex(doc->tokens,doc->text,firstLine,lastNewLine,(int)n-(int)(end-start),&rs);
+	errTrap=NULL;
+	stats->relexed+=rs.relexed;
+	// the body can be checked alone if its { and the token after its } were not lexed again, and they still delimit it
+	// reusedFrom is a new line, and the body ends after the edit, so its lines are shifted
+	if(!body||body->laccLine>=rs.firstLine||body->afterLine+delta<rs.reusedFrom||!doc->globals){
+		checkDocument(doc);
+		return false;
+		}
+	Token *racc=matchBrace(body->lacc);
+	if(!racc||racc->next!=body->after){
+		checkDocument(doc);
+		return false;
+		}
+	for(int i=0;i<doc->nBodies;i++){
+		Body *b=&doc->bodies[i];
+		shiftLine(&b->laccLine,lastOldLine,delta);
+		shiftLine(&b->raccLine,lastOldLine,delta);
+		shiftLine(&b->afterLine,lastOldLine,delta);
+		}
+	removeDiags(doc,body->fn);
+	for(int i=0;i<doc->nDiags;i++)shiftLine(&doc->diags[i].line,lastOldLine,delta);
+	runCheck(doc,RECHECK_BODY,body->fn,body->lacc);
+	symTable=NULL;
+	return true;
+	}
+
+static Document *findDocument(const char *uri){
+	for(Document *doc=docs;doc;doc=doc->next){
+		if(!strcmp(doc->uri,uri))return doc;
+		}
+	return NULL;
+	}
+
+static void setText(Document *doc,const char *text){
+	doc->len=strlen(text);
+	if(doc->len+1>doc->cap){
+		doc->cap=doc->len+1;
+		free(doc->text);
+		doc->text=(char*)safeAlloc(doc->cap);
+		}
+	memcpy(doc->text,text,doc->len+1);
+	computeLines(&doc->lines,doc->text);
+	if(doc->tokens){
+		freeTokens(doc->tokens);
+		doc->tokens=NULL;
+		}
+	}
+
+static void closeDocument(Document *doc){
+	Document **p=&docs;
+	while(*p!=doc)p=&(*p)->next;
+	*p=doc->next;
+	dropGlobals(doc);
+	removeDiags(doc,NULL);
+	freeTokens(doc->tokens);
+	free(doc->diags);
+	free(doc->bodies);
+	freeLines(&doc->lines);
+	free(doc->text);
+	free(doc->uri);
+	free(doc);
+	}
+
+static void sendMessage(FILE *out,JsonBuf *msg){
+	fprintf(out,"Content-Length: %zu\r\n\r\n",msg->len);
+	fwrite(msg->s,1,msg->len,out);
+	fflush(out);
+	}
+
+static void publishDiagnostics(FILE *out,const char *uri,Document *doc){
+	JsonBuf msg={0};
+	jsonAppend(&msg,"{\"jsonrpc\":\"2.0\",\"method\":\"textDocument/publishDiagnostics\",\"params\":{\"uri\":");
+	jsonAppendStr(&msg,uri);
+	jsonAppend(&msg,",\"diagnostics\":[");
+	for(int i=0;doc&&i<doc->nDiags;i++){
+		Diagnostic *d=&doc->diags[i];
+		int line=d->line>0?d->line-1:0;
+		if(line>=doc->lines.n)line=doc->lines.n-1;
+		// the range is from the error's column to the end of the line
+		const char *begin=doc->text+doc->lines.starts[line],*end=doc->text+lineEnd(doc,line);
+		const char *errPos=d->column>0&&d->column-1<end-begin?begin+d->column-1:begin;
+		int first=utf16Len(begin,errPos),len=utf16Len(begin,end);
+		jsonAppend(&msg,"%s{\"range\":{\"start\":{\"line\":%d,\"character\":%d},\"end\":{\"line\":%d,\"character\":%d}},"
+			"\"severity\":1,\"source\":\"atomc\",\"message\":",i?",":"",line,first,line,len);
+		jsonAppendStr(&msg,d->msg);
+		jsonAppend(&msg,"}");
+		}
+	jsonAppend(&msg,"]}}");
+	sendMessage(out,&msg);
+	jsonBufFree(&msg);
+	}
+
+static void reply(FILE *out,JsonValue *id,const char *result){
+	JsonBuf msg={0};
+	jsonAppend(&msg,"{\"jsonrpc\":\"2.0\",\"id\":");
+	jsonAppendValue(&msg,id);
+	jsonAppend(&msg,",\"result\":%s}",result);
+	sendMessage(out,&msg);
+	jsonBufFree(&msg);
+	}
+
+static void replyError(FILE *out,JsonValue *id,int code,const char *message){
+	JsonBuf msg={0};
+	jsonAppend(&msg,"{\"jsonrpc\":\"2.0\",\"id\":");
+	if(id)jsonAppendValue(&msg,id);
+	else jsonAppend(&msg,"null");
+	jsonAppend(&msg,",\"error\":{\"code\":%d,\"message\":",code);
+	jsonAppendStr(&msg,message);
+	jsonAppend(&msg,"}}");
+	sendMessage(out,&msg);
+	jsonBufFree(&msg);
+	}
+
+static void didChange(FILE *out,JsonValue *params,LspStats *stats,double received){
+	const char *uri=jsonGetStr(jsonGet(params,"textDocument"),"uri");
+	Document *doc=uri?findDocument(uri):NULL;
+	JsonValue *changes=jsonGet(params,"contentChanges");
+	if(!doc||!changes||changes->kind!=JSON_ARRAY)return;
+	for(JsonValue *change=changes->items;change;change=change->next){
+		const char *text=jsonGetStr(change,"text");
+		if(!text)continue;
+		stats->changes++;
+		JsonValue *range=jsonGet(change,"range");
+		if(!range){
+			setText(doc,text);
+			checkDocument(doc);
+			stats->fullChecks++;
+			continue;
+			}
+		JsonValue *start=jsonGet(range,"start"),*end=jsonGet(range,"end");
+		size_t startOffset=offsetOf(doc,(int)jsonGetNum(start,"line",0),(int)jsonGetNum(start,"character",0));
+		size_t endOffset=offsetOf(doc,(int)jsonGetNum(end,"line",0),(int)jsonGetNum(end,"character",0));
+		if(endOffset<startOffset)endOffset=startOffset;
+		if(applyEdit(doc,startOffset,endOffset,text,stats))stats->bodyChecks++;
+		else stats->fullChecks++;
+		}
+	publishDiagnostics(out,uri,doc);
+	double ms=nowMs()-received;
+	stats->totalMs+=ms;
+	if(ms>stats->maxMs)stats->maxMs=ms;
+	stats->nLatencies++;
+	}
+
+static void didOpen(FILE *out,JsonValue *params){
+	JsonValue *item=jsonGet(params,"textDocument");
+	const char *uri=jsonGetStr(item,"uri"),*text=jsonGetStr(item,"text");
+	if(!uri||!text)return;
+	Document *doc=findDocument(uri);
+	if(!doc){
+		doc=(Document*)safeAlloc(sizeof(Document));
+		memset(doc,0,sizeof(Document));
+		doc->uri=(char*)safeAlloc(strlen(uri)+1);
+		strcpy(doc->uri,uri);
+		doc->next=docs;
+		docs=doc;
+		}
+	setText(doc,text);
+	checkDocument(doc);
+	publishDiagnostics(out,uri,doc);
+	}
+
+static void didClose(FILE *out,JsonValue *params){
+	const char *uri=jsonGetStr(jsonGet(params,"textDocument"),"uri");
+	Document *doc=uri?findDocument(uri):NULL;
+	if(!doc)return;
+	closeDocument(doc);
+	publishDiagnostics(out,uri,NULL);
+	}
+
+// reads the headers of a message, until an empty line, and then its content
+// returns NULL at the end of the input
+static char *readMessage(FILE *in,size_t *len){
+	char header[256];
+	long length=-1;
+	for(;;){
+		if(!fgets(header,sizeof(header),in))return NULL;
+		if(!strcmp(header,"\r\n")||!strcmp(header,"\n"))break;
+		if(!strncmp(header,"Content-Length:",15))length=strtol(header+15,NULL,10);
+		}
+	if(length<0)length=0;
+	char *content=(char*)safeAlloc((size_t)length+1);
+	if(fread(content,1,(size_t)length,in)!=(size_t)length){
+		free(content);
+		return NULL;
+		}
+	content[length]='\0';
+	*len=(size_t)length;
+	return content;
+	}
+
+int lspServe(FILE *in,FILE *out,LspStats *stats){
+#ifdef _WIN32
+	_setmode(_fileno(in),_O_BINARY);
+	_setmode(_fileno(out),_O_BINARY);
+#endif
+	bool shutdown=false;
+	size_t len;
+	for(char *content;(content=readMessage(in,&len));free(content)){
+		double received=nowMs();
+		JsonValue *msg=jsonParse(content,len);
+		if(!msg){
+			replyError(out,NULL,-32700,"parse error");
+			continue;
+			}
+		const char *method=jsonGetStr(msg,"method");
+		JsonValue *id=jsonGet(msg,"id"),*params=jsonGet(msg,"params");
+		if(!method){}		// a response from the client
+		else if(!strcmp(method,"initialize")){
+			reply(out,id,"{\"capabilities\":{\"textDocumentSync\":{\"openClose\":true,\"change\":2}},"
+				"\"serverInfo\":{\"name\":\"atomc\"}}");
+			}
+		else if(!strcmp(method,"shutdown")){
+			shutdown=true;
+			reply(out,id,"null");
+			}
+		else if(!strcmp(method,"exit")){
+			jsonFree(msg);
+			free(content);
+			break;
+			}
+		else if(!strcmp(method,"textDocument/didOpen"))didOpen(out,params);
+		else if(!strcmp(method,"textDocument/didChange"))didChange(out,params,stats,received);
+		else if(!strcmp(method,"textDocument/didClose"))didClose(out,params);
+		else if(id)replyError(out,id,-32601,"method not found");
+		jsonFree(msg);
+		}
+	while(docs)closeDocument(docs);
+	return shutdown?0:1;
+	}
+
+void showLspStats(LspStats *stats){
+	fprintf(stderr,"// language server: %d edits, %d function bodies checked again, %d documents checked again\n",
+		stats->changes,stats->bodyChecks,stats->fullChecks);
+	if(stats->changes)fprintf(stderr,"//\t%.1f tokens lexed again per edit\n",(double)stats->relexed/stats->changes);
+	if(stats->nLatencies){
+		fprintf(stderr,"//\tdidChange to diagnostics: %.3f ms average, %.3f ms max\n",
+			stats->totalMs/stats->nLatencies,stats->maxMs);
+		}
+	}
@@ -0,0 +1,27 @@
+#pragma once
+
+// the language server: it checks the documents opened in an editor and reports their errors as diagnostics
+// it reads and writes JSON-RPC messages with the LSP headers (Content-Length), on its input and output streams
+// the documents are synchronized incrementally: after an edit only the edited lines are lexed again,
+// and if the edit is inside a function body, only that body is checked again
+
+#include <stdio.h>
+
+// when the stale types or global variables of the dropped symbols exceed these limits, all the documents are checked again from scratch
+#define LSP_MAX_TYPES 4096
+#define LSP_MAX_GLOBALS (32*1024*1024)		// bytes
+
+typedef struct{
+	int changes;		// the edits received with didChange
+	int bodyChecks;		// the edits after which only the edited function body was checked again
+	int fullChecks;		// the edits after which the whole document was checked again
+	long relexed;		// the tokens lexed again after the edits
+	double totalMs,maxMs;		// the time from receiving a didChange until its diagnostics are sent
+	int nLatencies;		// the didChange notifications, for the average latency
+	}LspStats;
+
+// serves the messages from in and writes the replies and the diagnostics to out, until the exit notification
+// returns the exit code of the server: 0 if shutdown was requested before exit, else 1
+int lspServe(FILE *in,FILE *out,LspStats *stats);
+// shows the stats to stderr, because the output is used for the messages
+void showLspStats(LspStats *stats);
@@ -1,20 +1,143 @@
 #include <stdio.h>
+#include <string.h>
 #include "utils.h"
 #include "stdlib.h"
 #include "lexer.h"
 #include "parser.h"
 #include "ad.h"
+#include "vm.h"
+#include "opt.h"
+#include "irpass.h"
+#include "inline.h"
+#include "elide.h"
+#include "link.h"
+#include "lsp.h"
+#include "prof.h"
+#include "gc.h"
+#include "tkstream.h"
 
+static bool hasExt(const char *path, const char *ext) {
+    size_t n = strlen(path), nExt = strlen(ext);
+    return n > nExt && !strcmp(path + n - nExt, ext);
+}
+
+// prints the tokens of a unit: x.c is lexed, and x.tks is read from its token stream
+// if save is true, the tokens of x.c are also saved in its token stream
+static void showUnitTokens(const char *path, bool save) {
+    if (hasExt(path, TK_STREAM_EXT)) {
+        TkStream s;
+        openTkStream(&s, path);
+        showTkStream(&s);
+        closeTkStream(&s);
+        return;
+    }
+    char *src = loadFile(path);
+    Token *tokens = tokenize(src);
+    showTokens(tokens);
+    if (save) {
+        size_t n = strlen(path) - (hasExt(path, ".c") ? 2 : 0);
+        char *tksPath = (char*)safeAlloc(n + sizeof(TK_STREAM_EXT));
+        memcpy(tksPath, path, n);
+        strcpy(tksPath + n, TK_STREAM_EXT);
+        saveTokens(tokens, tksPath);
+        free(tksPath);
+    }
+    freeTokens(tokens);
+    freeLines(tkLines);
+    free(src);
+}
 
-int main() {
-    char *inbuf=loadFile("tests/testad.c");
-    /*Token *tokens = tokenize(inbuf);
-    parse(tokens);*/
-    Token* parselist = tokenize(inbuf);
-    showTokens(parselist);
+int main(int argc, char **argv) {
+    // the options can come in any order, before or after the units
+    // --lsp: runs the language server on stdin and stdout, instead of compiling
+    // --profile [file]: profiles the program and writes its collapsed stacks in file, for the flame graphs
+    // the file cannot be a unit (x.c) or an option, so the units can follow --profile
+    // --sampling: with --profile, only the time, the calls and the loops are profiled, without counting the instructions
+    // (a lower overhead); the collapsed stacks then count the time samples
+    // --safe: the accesses to the arrays with a known dimension are checked (the IR optimizer removes the redundant checks)
+    // --fast-math: the vectorized sums of doubles can add in any order
+    // --incremental: each unit x.c is kept compiled in its object x.ao, which is used while x.c does not change
+    // --tokens: only prints the tokens of the units; with --save-tokens they are also saved in their token streams (x.tks)
+    // --quiet: only runs the program, without printing the symbols, the code and the stats of the compiler
+    // the other arguments are the units of the program, which are compiled in parallel and linked (tests/testad.c if there is none)
+    bool lsp = false, profile = false, sampling = false, incremental = false, tokensOnly = false, saveTks = false, quiet = false;
+    const char *collapsedFile = NULL;
+    const char **paths = (const char**)safeAlloc(argc * sizeof(const char*));
+    int nPaths = 0;
+    for (int k = 1; k < argc; k++) {
+        if (!strcmp(argv[k], "--lsp")) lsp = true;
+        else if (!strcmp(argv[k], "--profile")) {
+            profile = true;
+            if (k + 1 < argc && strncmp(argv[k + 1], "--", 2) && !hasExt(argv[k + 1], ".c")) collapsedFile = argv[++k];
+        } else if (!strcmp(argv[k], "--sampling")) sampling = true;
+        else if (!strcmp(argv[k], "--safe")) gcBoundsChecks = true;
+        else if (!strcmp(argv[k], "--fast-math")) irFastMath = true;
+        else if (!strcmp(argv[k], "--incremental")) incremental = true;
+        else if (!strcmp(argv[k], "--tokens")) tokensOnly = true;
+        else if (!strcmp(argv[k], "--save-tokens")) saveTks = true;
+        else if (!strcmp(argv[k], "--quiet")) quiet = true;
+        else if (strncmp(argv[k], "--", 2)) paths[nPaths++] = argv[k];
+        else err("unknown option %s", argv[k]);
+    }
+    if (lsp) {
+        free(paths);
+        initTypes();
+        LspStats lspStats = {0};
+        int code = lspServe(stdin, stdout, &lspStats);
+        showLspStats(&lspStats);
+        vmFreeGlobals();
+        return code;
+    }
+    if (!nPaths) paths[nPaths++] = "tests/testad.c";
+    if (tokensOnly) {
+        for (int k = 0; k < nPaths; k++) showUnitTokens(paths[k], saveTks);
+        free(paths);
+        return 0;
+    }
+    initTypes();
     pushDomain();
-    parse(parselist);
-    showDomain(symTable,"global");
+    vmInit();
+    LinkStats linkStats = {0};
+    Unit *units = linkProgram(paths, nPaths, PARSE_THREADS, incremental, &linkStats);
+    if(!quiet){
+        showLinkStats(&linkStats);
+        showDomain(symTable,"global");
+    }
+    ElideStats elideStats={0};
+    elideCopies(symTable,&elideStats);
+    if(!quiet)showElideStats(&elideStats);
+    InlineStats inlineStats={0};
+    inlineDomain(symTable,INLINE_BUDGET,&inlineStats);
+    if(!quiet)showInlineStats(&inlineStats);
+    IrStats irStats={0};
+    irOptimizeDomain(symTable,&irStats,!quiet);
+    if(!quiet)irShowStats(&irStats);
+    OptStats stats={0};
+    optimizeDomain(symTable,&stats);
+    if(!quiet)showOptStats(&stats);
+    Symbol *mainFn=findSymbolInDomain(symTable,"main");
+    if(mainFn&&mainFn->kind==SK_FN){
+        Instr *startup=NULL;
+        addInstrWithPtr(&startup,OP_CALL,mainFn);
+        addInstr(&startup,OP_HALT);
+        if(profile)profStart(symTable,!sampling);
+        run(startup);
+        if(profile){
+            profStop();
+            profReport(stdout,units,nPaths);
+            if(collapsedFile){
+                FILE *collapsed = fopen(collapsedFile, "w");
+                if(!collapsed)err("cannot write %s", collapsedFile);
+                profWriteCollapsed(collapsed, sampling);
+                fclose(collapsed);
+            }
+            profFree();
+        }
+        freeInstrs(startup);
+    }
     dropDomain();
+    freeUnits(units, nPaths);
+    free(paths);
+    vmFreeGlobals();
     return 0;
 }
@@ -0,0 +1,426 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "opt.h"
+#include "utils.h"
+
+// the code of a function, as an array, during an optimization step
+// the deleted instructions are only marked and they are removed from the list at the end of the step
+typedef struct{
+	InstrIndex index;
+	Instr **instrs;		// index.instrs
+	int n;
+	bool *dead;
+	bool *target;		// true if the instruction is a jump target
+	int *skip;		// for a deleted instruction, a following one such that all those between are deleted
+	}Code;
+
+static int indexOf(Code *c,Instr *instr){
+	return instrIndex(&c->index,instr);
+	}
+
+static bool isJump(Opcode op){
+	return op==OP_JMP||op==OP_JF||op==OP_JT;
+	}
+
+static void loadCode(Code *c,Instr *list){
+	initInstrIndex(&c->index,list);
+	c->instrs=c->index.instrs;
+	c->n=c->index.n;
+	c->dead=(bool*)safeAlloc(c->n*sizeof(bool));
+	c->target=(bool*)safeAlloc(c->n*sizeof(bool));
+	c->skip=(int*)safeAlloc(c->n*sizeof(int));
+	memset(c->dead,0,c->n*sizeof(bool));
+	memset(c->target,0,c->n*sizeof(bool));
+	for(int k=0;k<c->n;k++)c->skip[k]=k+1;
+	for(int k=0;k<c->n;k++){
+		if(isJump(c->instrs[k]->op))c->target[indexOf(c,c->instrs[k]->arg.instr)]=true;
+		}
+	}
+
+// the deleted instructions are skipped in runs, which are merged on each search (path compression)
+// so the long runs, as the jumps at the end of deeply nested statements, are not scanned again for each jump to them
+static int nextLive(Code *c,int i){
+	int live=i+1;
+	while(live<c->n&&c->dead[live])live=c->skip[live];
+	for(int k=i+1;k<live;){
+		int next=c->skip[k];
+		c->skip[k]=live;
+		k=next;
+		}
+	return live;
+	}
+
+static int prevLive(Code *c,int i){
+	for(i--;i>=0&&c->dead[i];i--){}
+	return i;
+	}
+
+// marks an instruction as deleted
+// the jumps to it will go to the next live instruction, which becomes a target
+static void kill(Code *c,int i){
+	c->dead[i]=true;
+	if(c->target[i]){
+		int next=nextLive(c,i);
+		if(next<c->n)c->target[next]=true;
+		}
+	}
+
+// rebuilds the list from the live instructions, retargets the jumps and frees the deleted instructions
+// returns the new list
+static Instr *storeCode(Code *c){
+	Instr *list=NULL,*last=NULL;
+	for(int k=0;k<c->n;k++){
+		Instr *i=c->instrs[k];
+		if(c->dead[k])continue;
+		if(isJump(i->op)){
+			int t=indexOf(c,i->arg.instr);
+			if(c->dead[t])t=nextLive(c,t);
+			if(t>=c->n)err("storeCode: a jump goes after the end of the function");
+			i->arg.instr=c->instrs[t];
+			}
+		if(last)last->next=i;
+		else list=i;
+		last=i;
+		}
+	if(last)last->next=NULL;
+	for(int k=0;k<c->n;k++){
+		if(c->dead[k])free(c->instrs[k]);
+		}
+	free(c->dead);
+	free(c->target);
+	free(c->skip);
+	freeInstrIndex(&c->index);
+	return list;
+	}
+
+static bool isUnary(Opcode op){
+	return (op>=OP_CONV_I_F&&op<=OP_CONV_I_C)||(op>=OP_NEG_I&&op<=OP_NOT_F);
+	}
+
+static bool isBinary(Opcode op){
+	return op>=OP_ADD_I&&op<=OP_NOTEQ_F;
+	}
+
+// the value pushed by a PUSH_I or PUSH_F
+static Val pushedVal(Instr *push){
+	Val v;
+	if(push->op==OP_PUSH_I)v.i=push->arg.i;
+	else v.f=push->arg.f;
+	return v;
+	}
+
+// replaces op with the push of its result, if it can be computed from the given operands
+static bool fold(Instr *op,Val *args){
+	Val r;
+	Opcode push=vmEval(op->op,args,&r);
+	if(push==OP_NOP)return false;
+	op->op=push;
+	if(push==OP_PUSH_I)op->arg.i=r.i;
+	else op->arg.f=r.f;
+	return true;
+	}
+
+static bool isConst(Instr *i){
+	return i->op==OP_PUSH_I||i->op==OP_PUSH_F;
+	}
+
+// computes at compile time the operations with constant operands and the branches with constant conditions
+// a pattern can be folded only if no jump goes inside it
+static bool foldConstants(Code *c,OptStats *stats){
+	bool changed=false;
+	for(int k=0;k<c->n;k++){
+		if(c->dead[k])continue;
+		Instr *i=c->instrs[k];
+		int p1=prevLive(c,k);
+		if(p1<0||c->target[k])continue;
+		Instr *a=c->instrs[p1];
+		if(isUnary(i->op)){
+			Val args[1]={pushedVal(a)};
+			if(!isConst(a)||!fold(i,args))continue;
+			kill(c,p1);
+			stats->folded++;
+			changed=true;
+			}else if(isBinary(i->op)){
+			int p2=prevLive(c,p1);
+			if(p2<0||c->target[p1])continue;
+			Instr *b=a;
+			a=c->instrs[p2];
+			Val args[2]={pushedVal(a),pushedVal(b)};
+			if(!isConst(a)||!isConst(b)||!fold(i,args))continue;
+			kill(c,p2);
+			kill(c,p1);
+			stats->folded++;
+			changed=true;
+			}else if((i->op==OP_JF||i->op==OP_JT)&&a->op==OP_PUSH_I){
+			if((a->arg.i!=0)==(i->op==OP_JT)){
+				i->op=OP_JMP;		// the branch is always taken
+				}else{
+				kill(c,k);		// the branch is never taken
+				}
+			kill(c,p1);
+			stats->constBranches++;
+			changed=true;
+			}
+		}
+	return changed;
+	}
+
+// removes the instructions which cannot be reached from the function's entry
+static bool removeUnreachable(Code *c,OptStats *stats){
+	bool *reached=(bool*)safeAlloc(c->n*sizeof(bool));
+	int *work=(int*)safeAlloc(c->n*sizeof(int));
+	int nWork=0;
+	memset(reached,0,c->n*sizeof(bool));
+	int first=nextLive(c,-1);
+	if(first<c->n){
+		reached[first]=true;
+		work[nWork++]=first;
+		}
+	while(nWork){
+		int k=work[--nWork];
+		Instr *i=c->instrs[k];
+		int succ[2],nSucc=0;
+		if(isJump(i->op)){
+			int t=indexOf(c,i->arg.instr);
+			if(c->dead[t])t=nextLive(c,t);
+			succ[nSucc++]=t;
+			}
+		if(i->op!=OP_JMP&&i->op!=OP_RET&&i->op!=OP_RET_VOID&&i->op!=OP_HALT)succ[nSucc++]=nextLive(c,k);
+		for(int s=0;s<nSucc;s++){
+			if(succ[s]<c->n&&!reached[succ[s]]){
+				reached[succ[s]]=true;
+				work[nWork++]=succ[s];
+				}
+			}
+		}
+	bool changed=false;
+	for(int k=0;k<c->n;k++){
+		if(!c->dead[k]&&!reached[k]){
+			c->dead[k]=true;
+			stats->unreachable++;
+			changed=true;
+			}
+		}
+	free(reached);
+	free(work);
+	return changed;
+	}
+
+// the successors of the instruction k, for the data flow analysis
+static int successors(Code *c,int k,int succ[2]){
+	Instr *i=c->instrs[k];
+	int nSucc=0;
+	if(isJump(i->op)){
+		int t=indexOf(c,i->arg.instr);
+		if(c->dead[t])t=nextLive(c,t);
+		if(t<c->n)succ[nSucc++]=t;
+		}
+	if(i->op!=OP_JMP&&i->op!=OP_RET&&i->op!=OP_RET_VOID&&i->op!=OP_HALT){
+		int next=nextLive(c,k);
+		if(next<c->n)succ[nSucc++]=next;
+		}
+	return nSucc;
+	}
+
+// removes the FPSTOREs of the slots which are not read after the store
+// a slot whose address is taken (FPADDR) is never considered
+static bool removeDeadStores(Code *c,OptStats *stats){
+	// the slots accessed with FPLOAD/FPSTORE get consecutive numbers (bits in the liveness sets)
+	// bitOfSlot is indexed from the lowest slot, so each instruction finds its bit directly, even with many slots (ex: inlined calls)
+	int minSlot=0,maxSlot=0;
+	for(int k=0;k<c->n;k++){
+		Instr *i=c->instrs[k];
+		if(c->dead[k]||(i->op!=OP_FPLOAD&&i->op!=OP_FPSTORE&&i->op!=OP_FPADDR))continue;
+		if(i->arg.i<minSlot)minSlot=i->arg.i;
+		if(i->arg.i>maxSlot)maxSlot=i->arg.i;
+		}
+	int nRange=maxSlot-minSlot+1,nSlots=0;
+	int *bitOfSlot=(int*)safeAlloc(nRange*sizeof(int));
+	bool *escaped=(bool*)safeAlloc(nRange*sizeof(bool));
+	int *bitOf=(int*)safeAlloc(c->n*sizeof(int));
+	for(int s=0;s<nRange;s++)bitOfSlot[s]=-1;
+	for(int k=0;k<c->n;k++){
+		Instr *i=c->instrs[k];
+		bitOf[k]=-1;
+		if(c->dead[k]||(i->op!=OP_FPLOAD&&i->op!=OP_FPSTORE&&i->op!=OP_FPADDR))continue;
+		int *s=&bitOfSlot[i->arg.i-minSlot];
+		if(*s<0){
+			*s=nSlots;
+			escaped[nSlots++]=false;
+			}
+		if(i->op==OP_FPADDR)escaped[*s]=true;
+		bitOf[k]=*s;
+		}
+	int words=(nSlots+63)/64;
+	bool changed=false;
+	if(words&&(size_t)c->n*words<=OPT_MAX_LIVE_WORDS){
+		uint64_t *liveIn=(uint64_t*)safeAlloc((size_t)c->n*words*sizeof(uint64_t));
+		uint64_t *liveOut=(uint64_t*)safeAlloc((size_t)c->n*words*sizeof(uint64_t));
+		memset(liveIn,0,(size_t)c->n*words*sizeof(uint64_t));
+		memset(liveOut,0,(size_t)c->n*words*sizeof(uint64_t));
+		for(bool again=true;again;){
+			again=false;
+			for(int k=c->n-1;k>=0;k--){
+				if(c->dead[k])continue;
+				uint64_t *out=liveOut+(size_t)k*words,*in=liveIn+(size_t)k*words;
+				int succ[2];
+				int nSucc=successors(c,k,succ);
+				for(int w=0;w<words;w++){
+					uint64_t o=0;
+					for(int s=0;s<nSucc;s++)o|=liveIn[(size_t)succ[s]*words+w];
+					out[w]=o;
+					}
+				for(int w=0;w<words;w++){
+					uint64_t v=out[w];
+					int b=bitOf[k];
+					if(b>=0&&b/64==w){
+						Opcode op=c->instrs[k]->op;
+						if(op==OP_FPSTORE)v&=~(1ULL<<(b%64));
+						else v|=1ULL<<(b%64);		// FPLOAD and FPADDR use the slot
+						}
+					if(v!=in[w]){
+						in[w]=v;
+						again=true;
+						}
+					}
+				}
+			}
+		for(int k=0;k<c->n;k++){
+			if(c->dead[k]||c->instrs[k]->op!=OP_FPSTORE)continue;
+			int b=bitOf[k];
+			if(escaped[b])continue;
+			if(liveOut[(size_t)k*words+b/64]&(1ULL<<(b%64)))continue;
+			kill(c,k);
+			stats->deadStores++;
+			changed=true;
+			}
+		free(liveIn);
+		free(liveOut);
+		}
+	free(bitOfSlot);
+	free(escaped);
+	free(bitOf);
+	return changed;
+	}
+
+// removes the computations of the values which are only dropped, when they have no side effects
+// ex: PUSH_I 0 DROP, FPLOAD 1 PUSH_I 1 ADD_I DROP
+static bool removeUnusedValues(Code *c){
+	bool changed=false;
+	for(int k=0;k<c->n;k++){
+		if(c->dead[k]||c->instrs[k]->op!=OP_DROP||c->target[k])continue;
+		for(;;){
+			int p=prevLive(c,k);
+			if(p<0)break;
+			Instr *i=c->instrs[p];
+			switch(i->op){
+				case OP_PUSH_I:case OP_PUSH_F:case OP_PUSH_A:case OP_FPLOAD:case OP_FPADDR:case OP_RLOAD_I:case OP_RLOAD_F:
+					// [] -> [v] DROP: both are removed
+					kill(c,p);
+					kill(c,k);
+					changed=true;
+					break;
+				case OP_CONV_I_F:case OP_CONV_F_I:case OP_CONV_I_C:case OP_NEG_I:case OP_NEG_F:case OP_NOT_I:case OP_NOT_F:
+				case OP_LOAD_I:case OP_LOAD_F:case OP_LOAD_C:case OP_LOAD_A:case OP_OFFSET:
+					// [a] -> [v] DROP: the operand is dropped instead
+					kill(c,p);
+					changed=true;
+					if(c->target[k])break;
+					continue;
+				default:
+					if(isBinary(i->op)||i->op==OP_INDEX){
+						// [a,b] -> [v] DROP: both operands are dropped
+						i->op=OP_DROP;
+						changed=true;
+						if(c->target[k])break;
+						continue;
+						}
+					break;
+				}
+			break;
+			}
+		}
+	return changed;
+	}
+
+// the load which reads what the given store writes, or OP_NOP if op is not a store to a slot or register
+static Opcode reloadOf(Opcode op){
+	switch(op){
+		case OP_FPSTORE:return OP_FPLOAD;
+		case OP_RSTORE_I:return OP_RLOAD_I;
+		case OP_RSTORE_F:return OP_RLOAD_F;
+		default:return OP_NOP;
+		}
+	}
+
+// FPSTORE s DROP FPLOAD s -> FPSTORE s (and the same for the registers)
+// the stored value is used from the stack, instead of being loaded again
+static bool removeReloads(Code *c){
+	bool changed=false;
+	for(int k=0;k<c->n;k++){
+		if(c->dead[k])continue;
+		Opcode reload=reloadOf(c->instrs[k]->op);
+		if(reload==OP_NOP)continue;
+		int drop=nextLive(c,k);
+		if(drop>=c->n||c->instrs[drop]->op!=OP_DROP||c->target[drop])continue;
+		int load=nextLive(c,drop);
+		if(load>=c->n||c->instrs[load]->op!=reload||c->target[load]||c->instrs[load]->arg.i!=c->instrs[k]->arg.i)continue;
+		kill(c,drop);
+		kill(c,load);
+		changed=true;
+		}
+	return changed;
+	}
+
+// removes the NOPs and the jumps to the next instruction
+static bool removeNops(Code *c){
+	bool changed=false;
+	for(int k=0;k<c->n;k++){
+		if(c->dead[k])continue;
+		Instr *i=c->instrs[k];
+		if(i->op==OP_NOP){
+			kill(c,k);
+			changed=true;
+			}else if(i->op==OP_JMP){
+			int t=indexOf(c,i->arg.instr);
+			if(c->dead[t])t=nextLive(c,t);
+			if(t==nextLive(c,k)){
+				kill(c,k);
+				changed=true;
+				}
+			}
+		}
+	return changed;
+	}
+
+void optimizeFn(Symbol *fn,OptStats *stats){
+	stats->before+=instrsLen(fn->fn.instr);
+	for(bool changed=true;changed;){
+		Code c;
+		loadCode(&c,fn->fn.instr);
+		changed=foldConstants(&c,stats);
+		changed|=removeUnreachable(&c,stats);
+		changed|=removeDeadStores(&c,stats);
+		changed|=removeUnusedValues(&c);
+		changed|=removeReloads(&c);
+		changed|=removeNops(&c);
+		fn->fn.instr=storeCode(&c);
+		}
+	stats->after+=instrsLen(fn->fn.instr);
+	}
+
+void optimizeDomain(Domain *d,OptStats *stats){
+	for(Symbol *s=d->symbols;s;s=s->next){
+		if(s->kind==SK_FN&&s->fn.instr)optimizeFn(s,stats);
+		}
+	}
+
+void showOptStats(OptStats *stats){
+	printf("// optimizations: %d instructions removed (%d -> %d)\n",stats->before-stats->after,stats->before,stats->after);
+	printf("//\tunreachable: %d, constant branches: %d, dead stores: %d, folded operations: %d\n",
+		stats->unreachable,stats->constBranches,stats->deadStores,stats->folded);
+	}
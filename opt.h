@@ -0,0 +1,31 @@
+#pragma once
+
+// optimizations of the generated code
+
+#include "ad.h"
+
+typedef struct{
+	int before;		// the number of instructions before the optimizations
+	int after;		// the number of instructions after the optimizations
+	int unreachable;		// the removed unreachable instructions (ex: after return or break)
+	int constBranches;		// the removed or simplified branches with constant conditions
+	int deadStores;		// the removed stores to locals which are not read after that
+	int folded;		// the operations computed at compile time
+	}OptStats;
+
+// the maximum size of the liveness sets of a function (instructions * 64-bit words of slots)
+// the dead stores are not removed from the larger functions (ex: hundreds of thousands of inlined calls)
+#define OPT_MAX_LIVE_WORDS (1<<22)
+
+// removes from fn's code:
+//		- the unreachable instructions
+//		- the branches with constant conditions (only the taken branch remains)
+//		- the stores to local variables or parameters which are not read after that,
+//			together with the computation of the stored value if it has no side effects
+//		- the loads of a value which was just stored from the stack
+//		- the NOPs and the jumps to the next instruction
+// the statistics are added to stats
+void optimizeFn(Symbol *fn,OptStats *stats);
+// optimizes all the functions with code from domain d
+void optimizeDomain(Domain *d,OptStats *stats);
+void showOptStats(OptStats *stats);
@@ -3,38 +3,49 @@
 #include <stdarg.h>
 #include <stdbool.h>
 #include<string.h>
+#include <threads.h>
+#include <stdatomic.h>
 
 #include "parser.h"
 #include "ad.h"
 #include "utils.h"
 #include "at.h"
+#include "gc.h"
 
-Token *iTk;		// the iterator in the tokens list
-Token *consumedTk;		// the last consumed token
-Symbol *owner;
+// the parser's state is per thread, so the function bodies can be checked in parallel
+_Thread_local Token *iTk;		// the iterator in the tokens list
+_Thread_local Token *consumedTk;		// the last consumed token
+_Thread_local Symbol *owner;
 
-void tkerr(const char *fmt,...){
-	fprintf(stderr,"error in line %d: ",iTk->line);
+noreturn void tkerr(const char *fmt,...){
 	va_list va;
 	va_start(va,fmt);
-	vfprintf(stderr,fmt,va);
-	va_end(va);
-	fprintf(stderr,"\n");
-	exit(EXIT_FAILURE);
+	verr(tkLine(iTk),tkColumn(iTk),fmt,va);
 	}
 
 bool consume(int code){
 	if(iTk->code==code){
-		consumedTk=iTk;
+		consumedTk=gcSrcTk=iTk;
 		iTk=iTk->next;
 		return true;
 		}
 	return false;
 	}
 
+// FIRST(typeBase): the tokens which can begin a type base
+static bool startsTypeBase(Token *tk){
+    switch(tk->code){
+        case TYPE_INT:case TYPE_DOUBLE:case TYPE_CHAR:case STRUCT:
+            return true;
+        default:
+            return false;
+    }
+}
+
 // typeBase: TYPE_INT | TYPE_DOUBLE | TYPE_CHAR | STRUCT ID
 bool typeBase(Type *t){
     t->n = -1;
+    t->s = NULL;
 
 	if(consume(TYPE_INT)){
         t->tb=TB_INT;
@@ -52,9 +63,9 @@ bool typeBase(Type *t){
 		if (consume(ID)) {
             Token *tkName = consumedTk;
             t->tb=TB_STRUCT;
-            t->s=findSymbol(tkName->text);
+            t->s=findSymbol(tkText(tkName));
             if(!t->s)
-                tkerr("Struct undefined: %s !",tkName->text);
+                tkerr("Struct undefined: %s !",tkText(tkName));
 																						 
             return true;
         }
@@ -70,12 +81,10 @@ bool structDef(){
             Token *tkName = consumedTk;
 
             if(consume(LACC)){
-                Symbol *s=findSymbolInDomain(symTable,tkName->text);
-                if(s)tkerr("Symbol redefinition: %s!",tkName->text);
-                s=addSymbolToDomain(symTable,newSymbol(tkName->text,SK_STRUCT));
-                s->type.tb=TB_STRUCT;
-                s->type.s=s;
-                s->type.n=-1;
+                Symbol *s=findSymbolInDomain(symTable,tkText(tkName));
+                if(s)tkerr("Symbol redefinition: %s!",tkText(tkName));
+                s=addSymbolToDomain(symTable,newSymbol(tkText(tkName),SK_STRUCT));
+                s->type=typeIntern(&(Type){TB_STRUCT,s,-1});
                 pushDomain();
                 owner=s;
 
@@ -103,43 +112,48 @@ bool structDef(){
     return false;
 }
 
+// the rest of a variable definition, after its type base t and its name: arrayDecl? SEMICOLON
+static void varDefRest(Type t,Token *tkName){
+    if(arrayDecl(&t)){
+        if(t.n==0)
+            tkerr("A vector variable must have a specified dimension!");
+    }
+    if(!consume(SEMICOLON))
+        tkerr( "Missing: ;");
+    Symbol *var=findSymbolInDomain(symTable,tkText(tkName));
+    if(var)tkerr("symbol redefinition: %s",tkText(tkName));
+    var=newSymbol(tkText(tkName),SK_VAR);
+    var->type=typeIntern(&t);
+    var->owner=owner;
+    addSymbolToDomain(symTable,var);
+    if(owner){
+    switch(owner->kind){
+    case SK_FN:
+    var->varIdx=symbolsLen(owner->fn.locals);
+    gcAddToFrame(owner,var);
+    addSymbolToList(&owner->fn.locals,dupSymbol(&owner->fn.arena,var));
+    break;
+    case SK_STRUCT:
+    // its size would be infinite
+    if(t.tb==TB_STRUCT&&t.s==owner)tkerr("a struct cannot contain itself: %s",owner->name);
+    var->varIdx=typeSize(typeOf(owner->type));
+    // the members live as long as the struct, in the arena of the domain which contains it
+    addSymbolToList(&owner->structMembers,dupSymbol(&symTable->parent->arena,var));
+    break;
+    }
+    }else{
+    var->varMem=vmAllocGlobal(typeSize(&t));     // the globals start with 0, like in C
+    }
+}
+
+// varDef: typeBase ID arrayDecl? SEMICOLON
 bool varDef(){
     Type t;
     Token *start=iTk;
     if(typeBase(&t)){
         if(consume(ID)){
-            Token *tkName = consumedTk;
-            if(arrayDecl(&t)){
-                if(t.n==0)
-                    tkerr("A vector variable must have a specified dimension!");
-            }
-            if(consume(SEMICOLON)){
-
-                Symbol *var=findSymbolInDomain(symTable,tkName->text);
-                if(var)tkerr("symbol redefinition: %s",tkName->text);
-                var=newSymbol(tkName->text,SK_VAR);
-                var->type=t;
-                var->owner=owner;
-                addSymbolToDomain(symTable,var);
-                if(owner){
-                switch(owner->kind){
-                case SK_FN:
-                var->varIdx=symbolsLen(owner->fn.locals);
-                addSymbolToList(&owner->fn.locals,dupSymbol(var));
-                break;
-                case SK_STRUCT:
-                var->varIdx=typeSize(&owner->type);
-                addSymbolToList(&owner->structMembers,dupSymbol(var));
-                break;
-                }
-                }else{
-                var->varMem=safeAlloc(typeSize(&t));
-                }
-
-                return true;
-            }
-            else tkerr( "Missing: ;");
-
+            varDefRest(t,consumedTk);
+            return true;
         }
         else tkerr( "Lipseste identificatorul dupa declaratia de tip");
     }
@@ -166,156 +180,132 @@ bool arrayDecl(Type *t){
     return false;
 }
 
-bool fnDef()
-{
-    Token *start = iTk;
-    Type t;
-    if (consume(VOID))
-    {
-        t.tb=TB_VOID;
-        if (consume(ID))
-        {
-            Token *tkName = consumedTk;
-            if (consume(LPAR))
-            {
-                Symbol *fn=findSymbolInDomain(symTable,tkName->text);
-                if(fn)tkerr("symbol redefinition: %s",tkName->text);
-                fn=newSymbol(tkName->text,SK_FN);
-                fn->type=t;
-                addSymbolToDomain(symTable,fn);
-                owner=fn;
-                pushDomain();
+// the function bodies which were skipped in the lazy mode and are not parsed yet, in their definition order
+typedef struct{
+    Symbol *fn;
+    Token *body;    // the { of the body
+}LazyBody;
 
-                if (fnParam())
-                {
-                    for (;;)
-                    {
-                        if (consume(COMMA))
-                        {
-                            if (fnParam()){}
-                            else
-                            {
-                                tkerr("expected a parameter after ',' in function definition");
-                                break;
-                            }
-                        }
-                        else
-                        {
-                            break;
-                        }
-                    }
-                }
-                if (consume(RPAR))
-                {
-                    if (stmCompound(false))
-                    {
-                        dropDomain();
-                        owner=NULL;
-                        return true;
-                    }
-                }
-                else
-                {
-                    tkerr("expected ) after the function parameters were defined");
-                }
-            }
-            else
-            {
-                tkerr("expected ( after the function parameters were defined");
-            }
-        }
-        else
-        {
-            tkerr("missing the name of the function");
+static bool lazyMode;
+static LazyBody *lazyBodies;
+static int nLazyBodies, lazyBodiesCap;
+
+// skips the tokens of a compound statement, by matching its braces
+static bool skipCompound(){
+    if(iTk->code!=LACC)return false;
+    int depth=0;
+    Token *tk;
+    for(tk=iTk;tk->code!=END;tk=tk->next){
+        if(tk->code==LACC)depth++;
+        else if(tk->code==RACC&&--depth==0){
+            consumedTk=tk;
+            iTk=tk->next;
+            return true;
         }
     }
-    else if (typeBase(&t))
-    {
-        if (consume(ID))
-        {
-            Token *tkName = consumedTk;
-            if (consume(LPAR))
-            {
-                Symbol *fn=findSymbolInDomain(symTable,tkName->text);
-				if(fn)tkerr("symbol redefinition: %s",tkName->text);
-				fn=newSymbol(tkName->text,SK_FN);
-				fn->type=t;
-				addSymbolToDomain(symTable,fn);
-				owner=fn;
-				pushDomain();
-                if (fnParam())
-                {
-                    for (;;)
-                    {
-                        if (consume(COMMA))
-                        {
-                            if (fnParam()){}
-                            else
-                            {
-                                tkerr("expected a parameter after ',' in function definition");
-                                break;
-                            }
-                        } else break;
-                    }
-                }
-                if (consume(RPAR))
-                {
-                    if (stmCompound(false))
-                    {
-                        dropDomain();
-						owner=NULL;
-                        return true;
-                    }
-                }
-                else
-                {
-                    tkerr("expected ) after the function parameters were defined");
-                }
-            }
-        }
-        else
-        {
-            tkerr("missing the name of the function");
+    iTk=tk;
+    tkerr("Lipseste: }");
+    return false;
+}
+
+// the body of fn, after its parameters, whose domain is the current one
+// in the lazy mode the body is only recorded, to be parsed later by parseFnBody
+static bool fnBody(Symbol *fn){
+    if(lazyMode){
+        Token *body=iTk;
+        if(!skipCompound())return false;
+        if(nLazyBodies==lazyBodiesCap){
+            lazyBodiesCap=lazyBodiesCap?lazyBodiesCap*2:16;
+            lazyBodies=(LazyBody*)realloc(lazyBodies,lazyBodiesCap*sizeof(LazyBody));
+            if(!lazyBodies)err("not enough memory");
         }
+        lazyBodies[nLazyBodies++]=(LazyBody){fn,body};
+    }else{
+        gcBeginFn(fn);
+        if(!stmCompound(false))return false;
+        gcEndFn();
     }
-    iTk = start;
-    return false;
+    dropDomain();
+    owner=NULL;
+    return true;
 }
-size_t getPointerSize() {
-    return sizeof(void*);
+
+// true if the parameters from the lists a and b have the same types, in the same order
+static bool sameParamTypes(Symbol *a,Symbol *b){
+    for(;a&&b;a=a->next,b=b->next){
+        if(a->type!=b->type)return false;
+    }
+    return !a&&!b;
 }
 
-bool fnParam() {
-    Type t;
-    Token *start = iTk;
-    if (typeBase(&t)) {
-        if (consume(ID)) {
-            Token *tkName = consumedTk;
-            if (arrayDecl(&t)) {
-                t.n = 0; // For function parameters, set array size to 0
-            }
-            Symbol *param = findSymbolInDomain(symTable, tkName->text);
-            if (param) tkerr("Symbol redefinition: %s !", tkName->text);
-            param = newSymbol(tkName->text, SK_PARAM);
-            param->type = t;
-            param->owner = owner;
-            param->paramIdx = symbolsLen(owner->fn.params);
-
-            // Use dynamic pointer size
-            param->type.n = t.tb == TB_STRUCT && t.n > 0 ? t.n * getPointerSize() : getPointerSize();
-
-            addSymbolToDomain(symTable, param);
-            addSymbolToList(&owner->fn.params, dupSymbol(param));
-            return true;
-        } else {
-            tkerr("Lipseste identificatorul de tips");
+// the rest of a function definition, after its return type t, its name and LPAR:
+// ( fnParam ( COMMA fnParam )* )? RPAR ( stmCompound | SEMICOLON )
+// with SEMICOLON it is a prototype, which declares a function defined later or in another unit
+// a function declared by a prototype keeps its symbol when it is declared again or defined, so the calls
+// which were generated before refer to its definition; the signature must be the same
+static void fnDefRest(Type *t,Token *tkName){
+    Symbol *fn=findSymbolInDomain(symTable,tkText(tkName));
+    Symbol *declared=NULL;
+    if(fn){
+        if(fn->kind!=SK_FN||!fn->fn.prototype)tkerr("symbol redefinition: %s",tkText(tkName));
+        if(fn->type!=typeIntern(t))tkerr("the return type of %s differs from its prototype",fn->name);
+        declared=fn->fn.params;
+        fn->fn.params=NULL;
+        fn->fn.frame=(FrameLayout){0,0,0};
+        Symbol *last=symTable->symbols;
+        while(last->next)last=last->next;
+        fn->fn.lastVisible=last;
+    }else{
+        fn=newSymbol(tkText(tkName),SK_FN);
+        fn->type=typeIntern(t);
+        fn->fn.lastVisible=fn;
+        addSymbolToDomain(symTable,fn);
+    }
+    owner=fn;
+    pushDomain();
+    if(fnParam()){
+        while(consume(COMMA)){
+            if(!fnParam())
+                tkerr("expected a parameter after ',' in function definition");
         }
     }
-    iTk = start;
-    return false;
+    if(!consume(RPAR))
+        tkerr("expected ) after the function parameters were defined");
+    if(declared&&!sameParamTypes(declared,fn->fn.params))
+        tkerr("the parameters of %s differ from its prototype",fn->name);
+    if(consume(SEMICOLON)){
+        fn->fn.prototype=true;
+        dropDomain();
+        owner=NULL;
+        return;
+    }
+    fn->fn.prototype=false;
+    if(!fnBody(fn))
+        tkerr("missing the body of the function %s",fn->name);
+}
+
+// fnDef: ( typeBase | VOID ) ID LPAR ( fnParam ( COMMA fnParam )* )? RPAR ( stmCompound | SEMICOLON )
+// varDef: typeBase ID arrayDecl? SEMICOLON
+// a global definition which begins with a type is parsed up to its name only once, then LPAR selects a fnDef
+static void fnOrVarDef(){
+    Type t;
+    bool isVoid=consume(VOID);
+    if(isVoid)
+        t=(Type){TB_VOID,NULL,-1};
+    else
+        typeBase(&t);
+    if(!consume(ID))
+        tkerr("missing the name of the function");
+    Token *tkName=consumedTk;
+    if(consume(LPAR))
+        fnDefRest(&t,tkName);
+    else if(isVoid)
+        tkerr("expected ( after the function parameters were defined");
+    else
+        varDefRest(t,tkName);
 }
 
-/*bool fnParam(){
+bool fnParam(){
     Type t;
     Token *start=iTk;
     if(typeBase(&t)){
@@ -324,496 +314,728 @@ bool fnParam() {
             if(arrayDecl(&t)){
                 t.n=0;
             }
-            Symbol *param=findSymbolInDomain(symTable,tkName->text);
-            if(param)tkerr("Symbol redefinition: %s !",tkName->text);
-            param=newSymbol(tkName->text,SK_PARAM);
-            param->type=t;
+            Symbol *param=findSymbolInDomain(symTable,tkText(tkName));
+            if(param)tkerr("Symbol redefinition: %s !",tkText(tkName));
+            param=newSymbol(tkText(tkName),SK_PARAM);
+            param->type=typeIntern(&t);
             param->owner=owner;
             param->paramIdx=symbolsLen(owner->fn.params);
-																					
+            gcAddToFrame(owner,param);
             addSymbolToDomain(symTable,param);
-            addSymbolToList(&owner->fn.params,dupSymbol(param));
+            addSymbolToList(&owner->fn.params,dupSymbol(&symTable->parent->arena,param));
             return true;
         }
         else tkerr( "Lipseste identificatorul de tips");
     }
     iTk = start;
     return false;
-}*/
-
-bool stm(){
-    Token *start=iTk;
-    
-    if(stmCompound(true)){
-        return true;
-    }
-    iTk=start;
-    if(consume(IF)){
-        if(consume(LPAR)){
-            if(expr(&rCond)){
-                 if(!canBeScalar(&rCond))
-                    tkerr("The if condition must be a scalar value!");
-                if(consume(RPAR)){
-                    if(stm()){
-                        if(consume(ELSE)){
-                            if(stm()){
-                                return true;
-                            }
-                            else tkerr( "Lipseste branch: else");
-                        }
-                        return true;
-                    }
-                    else tkerr( "Lipseste branch: if");
-                }
-                else tkerr( "Lipseste: )");
-            }
-            else tkerr("Lipseste conditia pentru if");
-        }
-    }
-    iTk=start;
-    if(consume(WHILE)){
-        if(consume(LPAR)){
-            if(expr(&rCond)){
-                if(!canBeScalar(&rCond))
-                    tkerr("The while condition must be a scalar value!");
-                if(consume(RPAR)){
-                    if(stm()){
-                        return true;
-                    }
-                    else tkerr( "Lipseste: while");
-                }
-                else tkerr( "Lipseste: )");
-            }
-            else tkerr( "Lipseste conditia");
-        }
-    }
-    iTk=start;
-    if(consume(RETURN)){
-        if(expr(&rExpr)){
-            if(owner->type.tb==TB_VOID)
-                tkerr("A void function cannot return a value!");
-            if(!canBeScalar(&rExpr))
-                tkerr("The return value must be a scalar value!");
-            if(!convTo(&rExpr.type,&owner->type))
-                tkerr("Cannot convert the return expression type to the function return type!");																 
-        }
-        else {
-		if(owner->type.tb!=TB_VOID)
-                tkerr("A non-void function must return a value!");
-        }
-        if(consume(SEMICOLON)){
-            return true;
-        } else tkerr("Missing ; after RETURN!");
-    }
-    else if(expr(&rExpr)) {
-        if (consume(SEMICOLON)) {
-            return true;
-        } else tkerr("Expected ; after expression!");
-    }
-    iTk = start;
-    return false;
 }
 
+// the pending break jumps of the innermost loop, chained through their arg.instr
+// they are patched when the loop ends
+_Thread_local Instr *loopBreaks;
+_Thread_local int loopDepth;
 
-bool stmCompound(bool newDomain){
-    Token *start=iTk;
-    if(consume(LACC)){
-        if(newDomain)
-            pushDomain();
-        for(;;){
-            if(varDef()){}
-            else if(stm()){}
-            else break;
-        }
-        if(consume(RACC)){
-            if(newDomain)
-                dropDomain();
-            return true;
-        }
-        else tkerr( "Lipseste: }");
-    }
-    iTk = start;
-    return false;
-}
+// the statements and the expressions are parsed with explicit stacks of frames, not by recursion,
+// so an arbitrarily deep nesting cannot overflow the C stack
+// a frame keeps a construct whose parsing waits for a nested statement or expression to end
+int parseMaxNesting=PARSE_MAX_NESTING;
 
-bool expr(Ret *r){
-    Token *start=iTk;
-    if(exprAssign(r)){
-        return true;
-    }
-    iTk = start;
-    return false;
+// grows the frames stack *frames for one more frame, of the given size
+static void *growFrames(void *frames,int n,int *cap,size_t size,const char *what){
+    if(n>=parseMaxNesting)
+        tkerr("The %s are nested too deeply (more than %d pending constructs)",what,parseMaxNesting);
+    if(n<*cap)return frames;
+    *cap=*cap?*cap*2:64;
+    frames=realloc(frames,*cap*size);
+    if(!frames)err("not enough memory");
+    return frames;
 }
 
-bool exprAssign(){
-    Token *start=iTk;
-    if(exprUnary()){
-        if(consume(ASSIGN)){
-            if(exprAssign()){
-                return true;
-            }
-            else tkerr( "Lipseste termenul drept al expresiei");
-        }
-    }
-    iTk=start;
-    if(exprOr()){
-        return true;
-    }
-    iTk = start;
-    return false;
-}
+typedef enum{
+    SF_COMPOUND,        // { ... }: its items follow
+    SF_IF,      // if ( expr ): its branch follows
+    SF_ELSE,        // if ( expr ) stm else: the else branch follows
+    SF_WHILE,       // while ( expr ): its body follows
+}StmFrameKind;
 
-bool exprOr(){
-    Token *start=iTk;
-    if(exprAnd()){
-        if(exprOrSecondary()){
-            return true;
-        }
-    }
-    iTk = start;
-    return false;
-}
+typedef struct{
+    StmFrameKind kind;
+    union{
+        bool newDomain;     // SF_COMPOUND
+        Instr *ifJF;        // SF_IF
+        Instr *ifJMP;       // SF_ELSE
+        struct{
+            Instr *beforeCond,*jf,*outerBreaks;
+        }loop;      // SF_WHILE
+    };
+}StmFrame;
 
-bool exprOrSecondary(){
-    Token *start=iTk;
-    if(consume(OR)){
-        if(exprAnd()){
-            if(exprOrSecondary()){
-                return true;
-            }
-        }
-        else tkerr( "Lipseste expresia de dupa: ||");
-    }
-    iTk = start;
-    return true;
-}
+static _Thread_local StmFrame *stmFrames;
+static _Thread_local int nStmFrames,stmFramesCap;
 
-bool exprAnd(){
-    Token *start=iTk;
-    if(exprEq()){
-        if(exprAndSecondary()){
-            return true;
-        }
-    }
-    iTk = start;
-    return false;
+static StmFrame *pushStmFrame(StmFrameKind kind){
+    stmFrames=(StmFrame*)growFrames(stmFrames,nStmFrames,&stmFramesCap,sizeof(StmFrame),"statements");
+    StmFrame *f=&stmFrames[nStmFrames++];
+    f->kind=kind;
+    return f;
 }
 
-bool exprAndSecondary(){
-    Token *start=iTk;
-    if(consume(AND)){
-        if(exprEq()){
-            if(exprAndSecondary()){
-                return true;
-            }
-        }
-        else tkerr( "Lipseste expresia dupa: &&");
-    }
-    iTk = start;
-    return true;
-}
+typedef enum{
+    SS_STM,     // a statement begins
+    SS_ITEM,        // the next item of the compound statement from the stack top begins
+    SS_END,     // a statement ended
+    SS_FAILED,      // no statement begins at iTk
+}StmState;
 
-bool exprEq(){
-    Token *start=iTk;
-    if(exprRel()){
-        if(exprEqSecondary()){
+// FIRST(expr): the tokens which can begin an expression
+static bool startsExpr(Token *tk){
+    switch(tk->code){
+        case ID:case INT:case DOUBLE:case CHAR:case STRING:case LPAR:case SUB:case NOT:
             return true;
-        }
+        default:
+            return false;
     }
-    iTk = start;
-    return false;
 }
 
-bool exprEqSecondary(){
+// parses the beginning of a statement, up to its nested statement, if it has one
+// the statement is selected by its first token
+static StmState stmBegin(){
+    Ret rCond,rExpr;
     Token *start=iTk;
-    char c;
-    if(start->code == EQUAL) 
-      c = '=';
-    else 
-      c='!';
-
-    if(consume(EQUAL)||consume(NOTEQ)){
-        if(exprRel()){
-            if(exprEqSecondary()){
-                return true;
+    switch(iTk->code){
+        case LACC:
+            consume(LACC);
+            pushDomain();
+            pushStmFrame(SF_COMPOUND)->newDomain=true;
+            return SS_ITEM;
+        case IF:
+            consume(IF);
+            if(!consume(LPAR))
+                break;
+            if(!expr(&rCond))
+                tkerr("Lipseste conditia pentru if");
+            if(!canBeScalar(&rCond))
+                tkerr("The if condition must be a scalar value!");
+            gcRVal(&rCond);
+            gcCond(rCond.type);
+            if(!consume(RPAR))
+                tkerr( "Lipseste: )");
+            pushStmFrame(SF_IF)->ifJF=gcAdd(OP_JF);
+            return SS_STM;
+        case WHILE:{
+            consume(WHILE);
+            if(!consume(LPAR))
+                break;
+            Instr *beforeWhileCond=gcAdd(OP_NOP);
+            if(!expr(&rCond))
+                tkerr( "Lipseste conditia");
+            if(!canBeScalar(&rCond))
+                tkerr("The while condition must be a scalar value!");
+            gcRVal(&rCond);
+            gcCond(rCond.type);
+            if(!consume(RPAR))
+                tkerr( "Lipseste: )");
+            StmFrame *f=pushStmFrame(SF_WHILE);
+            f->loop.beforeCond=beforeWhileCond;
+            f->loop.jf=gcAdd(OP_JF);
+            f->loop.outerBreaks=loopBreaks;
+            loopBreaks=NULL;
+            loopDepth++;
+            return SS_STM;
+            }
+        case BREAK:{
+            consume(BREAK);
+            if(!loopDepth)
+                tkerr("break can be used only inside a loop");
+            Instr *jmp=gcAdd(OP_JMP);
+            jmp->arg.instr=loopBreaks;
+            loopBreaks=jmp;
+            if(!consume(SEMICOLON))
+                tkerr("Missing ; after break!");
+            return SS_END;
+            }
+        case RETURN:
+            consume(RETURN);
+            if(startsExpr(iTk)&&expr(&rExpr)){
+                if(owner->type==TID_VOID)
+                    tkerr("A void function cannot return a value!");
+                if(!canBeScalar(&rExpr))
+                    tkerr("The return value must be a scalar value!");
+                if(!convTo(rExpr.type,owner->type))
+                    tkerr("Cannot convert the return expression type to the function return type!");
+                gcRVal(&rExpr);
+                gcConv(gcLast(),rExpr.type,owner->type);
+                gcAddInt(OP_RET,paramsSlots(owner));
+            }
+            else {
+                if(owner->type!=TID_VOID)
+                    tkerr("A non-void function must return a value!");
+                gcAddInt(OP_RET_VOID,paramsSlots(owner));
+            }
+            if(!consume(SEMICOLON))
+                tkerr("Missing ; after RETURN!");
+            return SS_END;
+        default:
+            if(startsExpr(iTk)&&expr(&rExpr)){
+                if(rExpr.type!=TID_VOID)
+                    gcAdd(OP_DROP);
+                if(!consume(SEMICOLON))
+                    tkerr("Expected ; after expression!");
+                return SS_END;
             }
-        }
-        else tkerr( "Lipseste expresia de dupa %c=", c);
     }
     iTk = start;
-    return true;
+    return SS_FAILED;
 }
 
-bool exprRel(){
-    Token *start=iTk;
-    if(exprAdd()){
-        if(exprRelSecondary()){
-            return true;
+// parses a statement (state SS_STM) or the items of a compound statement whose { is consumed (state SS_ITEM)
+// the statements nested in it are parsed in the same loop, using the frames above base
+static bool stmNested(StmState state){
+    int base=nStmFrames-(state==SS_ITEM);
+    for(;;){
+        switch(state){
+            case SS_STM:
+                state=stmBegin();
+                break;
+            case SS_ITEM:
+                state=startsTypeBase(iTk)&&varDef()?SS_ITEM:SS_STM;
+                break;
+            case SS_END:{
+                if(nStmFrames==base)
+                    return true;
+                StmFrame *f=&stmFrames[nStmFrames-1];
+                switch(f->kind){
+                    case SF_COMPOUND:
+                        state=SS_ITEM;
+                        break;
+                    case SF_IF:
+                        if(consume(ELSE)){
+                            Instr *ifJMP=gcAdd(OP_JMP);
+                            f->ifJF->arg.instr=gcAdd(OP_NOP);
+                            f->kind=SF_ELSE;
+                            f->ifJMP=ifJMP;
+                            state=SS_STM;
+                            break;
+                        }
+                        f->ifJF->arg.instr=gcAdd(OP_NOP);
+                        nStmFrames--;
+                        break;
+                    case SF_ELSE:
+                        f->ifJMP->arg.instr=gcAdd(OP_NOP);
+                        nStmFrames--;
+                        break;
+                    case SF_WHILE:{
+                        gcAdd(OP_JMP)->arg.instr=f->loop.beforeCond;
+                        Instr *afterWhile=gcAdd(OP_NOP);
+                        f->loop.jf->arg.instr=afterWhile;
+                        for(Instr *next;loopBreaks;loopBreaks=next){
+                            next=loopBreaks->arg.instr;
+                            loopBreaks->arg.instr=afterWhile;
+                        }
+                        loopBreaks=f->loop.outerBreaks;
+                        loopDepth--;
+                        nStmFrames--;
+                        }break;
+                }
+                }break;
+            case SS_FAILED:{
+                if(nStmFrames==base)
+                    return false;
+                StmFrame *f=&stmFrames[nStmFrames-1];
+                switch(f->kind){
+                    case SF_COMPOUND:
+                        // no more items
+                        if(consume(RACC)){
+                            if(f->newDomain)
+                                dropDomain();
+                            nStmFrames--;
+                            state=SS_END;
+                        }
+                        else tkerr( "Lipseste: }");
+                        break;
+                    case SF_IF:tkerr( "Lipseste branch: if");break;
+                    case SF_ELSE:tkerr( "Lipseste branch: else");break;
+                    case SF_WHILE:tkerr( "Lipseste: while");break;
+                }
+                }break;
         }
     }
-    iTk = start;
-    return false;
 }
 
-bool exprRelSecondary(){
-    Token *start=iTk;
-    char c[3];
-    if(start->code == LESS) 
-      strcpy(c, "<");
-    else if(start->code == LESSEQ)
-      strcpy(c, "<=");
-    else if(start->code == GREATER)
-      strcpy(c, ">");
-    else if(start->code == GREATEREQ)
-      strcpy(c, ">=");
-
-    if(consume(LESS)||consume(LESSEQ)||consume(GREATER)||consume(GREATEREQ)){
-        if(exprAdd()){
-            if(exprRelSecondary()){
-                return true;
-            }
-        }
-        else tkerr( "Lipseste expresia de dupa %s", c);
-    }
-    iTk = start;
-    return true;
+bool stm(){
+    return stmNested(SS_STM);
 }
-bool exprAdd(){
-    Token *start=iTk;
-    if(exprMul()){
-        if(exprAddSecondary()){
-            return true;
-        }
-    }
-    iTk = start;
-    return false;
+
+bool stmCompound(bool newDomain){
+    if(!consume(LACC))
+        return false;
+    if(newDomain)
+        pushDomain();
+    pushStmFrame(SF_COMPOUND)->newDomain=newDomain;
+    return stmNested(SS_ITEM);
 }
 
 
-bool exprAddSecondary(){
-    Token *start=iTk;
-    char c;
-    if(start->code == ADD) 
-     c = '+';
-    else 
-      c = '-';
-    if(consume(ADD)||consume(SUB)){
-        if(exprMul()){
-            if(exprAddSecondary()){
-                return true;
-            }
-        }
-        else tkerr( "Lipseste expresia de dupa %c", c);
-    }
-    iTk = start;
-    return true;
+// the precedence levels of the binary operators, from the lowest one
+// 0 means that the token is not a binary operator
+enum{PREC_NONE,PREC_OR,PREC_AND,PREC_EQ,PREC_REL,PREC_ADD,PREC_MUL};
+
+// the operators table, indexed by the token code
+static const struct{
+    unsigned char prec;
+    const char *name;       // used in the error messages
+}binaryOps[]={
+    [OR]={PREC_OR,"||"},
+    [AND]={PREC_AND,"&&"},
+    [EQUAL]={PREC_EQ,"=="},[NOTEQ]={PREC_EQ,"!="},
+    [LESS]={PREC_REL,"<"},[LESSEQ]={PREC_REL,"<="},[GREATER]={PREC_REL,">"},[GREATEREQ]={PREC_REL,">="},
+    [ADD]={PREC_ADD,"+"},[SUB]={PREC_ADD,"-"},
+    [MUL]={PREC_MUL,"*"},[DIV]={PREC_MUL,"/"},
+};
+#define BINARY_OPS_COUNT ((int)(sizeof(binaryOps)/sizeof(binaryOps[0])))
+
+static int binaryPrec(int code){
+    return code<BINARY_OPS_COUNT?binaryOps[code].prec:PREC_NONE;
 }
-bool exprMul(){
-    Token *start=iTk;
-    if(exprCast()){
-        if(exprMulSecondary()){
-            return true;
-        }
-    }
-    iTk = start;
-    return false;
+
+// the result of the logical and relational operators: int, not left-value, constant
+static void setLogicRet(Ret *r){
+    r->type=TID_INT;
+    r->lval=false;
+    r->ct=true;
 }
 
-bool exprMulSecondary(){
-    Token *start=iTk;
-    char c;
-    if(start->code == MUL) 
-      c = '*';
-    else 
-      c='/';
-
-    if(consume(MUL)||consume(DIV)){
-        if(exprCast()){
-            if(exprMulSecondary()){
-                return true;
-            }
-        }
-        else tkerr( "Lipseste expresia de dupa %c", c);
-    }
-    iTk = start;
-    return true;
+typedef enum{
+    EF_OPERAND,     // an operand: its start, to backtrack or to generate an assignment
+    EF_CAST,        // a cast, applied after its operand is parsed
+    EF_UNARY,       // - or !, applied after its operand is parsed
+    EF_BINARY,      // a binary operator, which waits for its right operand
+    EF_ASSIGN,      // an assignment, which waits for its source
+    EF_PAREN,       // ( expr ) as primary expression
+    EF_INDEX,       // [ expr ] after an array
+    EF_CALL,        // a function call, which waits for an argument
+}ExprFrameKind;
+
+typedef struct{
+    ExprFrameKind kind;
+    int code;       // EF_UNARY, EF_BINARY: the operator
+    Ret r;      // EF_BINARY: the left operand; EF_ASSIGN: the destination; EF_INDEX: the array
+    union{
+        struct{
+            Token *start;
+            Instr *startInstr;
+        }operand;       // EF_OPERAND
+        Type cast;      // EF_CAST: the destination type
+        Instr *instr;       // EF_BINARY: the last instruction of the left operand or the jump of || and &&
+        struct{
+            Instr *startInstr,*lastDst;     // the destination's address is generated after startInstr, up to lastDst
+        }assign;        // EF_ASSIGN
+        Token *lpar;        // EF_PAREN
+        struct{
+            Symbol *fn,*param;      // param is the parameter of the next argument
+            bool afterComma;
+        }call;      // EF_CALL
+    };
+}ExprFrame;
+
+static _Thread_local ExprFrame *exprFrames;
+static _Thread_local int nExprFrames,exprFramesCap;
+
+static ExprFrame *pushExprFrame(ExprFrameKind kind){
+    exprFrames=(ExprFrame*)growFrames(exprFrames,nExprFrames,&exprFramesCap,sizeof(ExprFrame),"expressions");
+    ExprFrame *f=&exprFrames[nExprFrames++];
+    f->kind=kind;
+    return f;
 }
 
-bool exprUnary(){
-    Token *start=iTk;
-    char c;
-    if(start->code == SUB) 
-      c = '-';
-    else 
-      c='!';
-
-    if(consume(SUB)||consume(NOT)){
-        if(exprUnary()){
-            return true;
-        }
-        else tkerr( "Lipseste expresia de dupa %c", c);
-    }
-    iTk=start;
-    if(exprPostfix()){
-        return true;
-    }
-    iTk = start;
-    return false;
+static ExprFrame *exprTop(){
+    return &exprFrames[nExprFrames-1];
 }
 
-bool exprPostfixSecondary(){
-    Token *start=iTk;
-    if(consume(LBRACKET)){
-        if(expr()){
-            if(consume(RBRACKET)){
-                if(exprPostfixSecondary()){
-                    return true;
-                }
-            }
-            else tkerr( "Lipseste: ]");
-        }
-        else tkerr( "Lipseste expresia dintre: []");
-    }
-    iTk=start;
-    if(consume(DOT)){
-        if(consume(ID)){
-            if(exprPostfixSecondary()){
-                return true;
-            }
+typedef enum{
+    ES_OPERAND,     // an operand begins
+    ES_POSTFIX,     // r is a primary expression, which can be followed by [] or .
+    ES_OPERAND_END,     // the postfix expression of the operand ended
+    ES_OPERAND_FAILED,      // no operand begins at iTk
+    ES_EXPR_FAILED,     // no expression begins at iTk
+    ES_BINARY,      // r is a left operand, which can be followed by a binary operator
+    ES_EXPR_END,        // r is a complete expression
+}ExprState;
+
+// operand: ( LPAR typeBase arrayDecl? RPAR )* ( SUB | NOT )* exprPrimary
+// exprPrimary: ID ( LPAR ( expr ( COMMA expr )* )? RPAR )? | INT | DOUBLE | CHAR | STRING | LPAR expr RPAR
+// the casts and the unary operators are pushed as frames, to be applied after the postfix expression
+static ExprState exprOperand(Ret *r){
+    ExprFrame *f=pushExprFrame(EF_OPERAND);
+    f->operand.start=iTk;
+    f->operand.startInstr=gcLast();
+    // a LPAR followed by FIRST(typeBase) begins a cast
+    while(iTk->code==LPAR&&startsTypeBase(iTk->next)){
+        Token *lpar=iTk;
+        Type t;
+        consume(LPAR);
+        if(!typeBase(&t)){
+            // STRUCT without a name: ( is a primary expression, which fails
+            iTk=lpar;
+            break;
         }
-        else tkerr( "Lipseste identificatorul de dupa .");
+        if(arrayDecl(&t)){}
+        if(!consume(RPAR))
+            tkerr(" Lipseste : )");
+        pushExprFrame(EF_CAST)->cast=t;
     }
-    iTk = start;
-    return true;
-}
-
-bool exprSecondaryary(){
-    Token *start=iTk;
+    while(consume(SUB)||consume(NOT))
+        pushExprFrame(EF_UNARY)->code=consumedTk->code;
     if(consume(ID)){
+        Token *tkName=consumedTk;
+        Symbol *s=findSymbol(tkText(tkName));
+        if(!s)
+            tkerr("Undefined id: %s",tkText(tkName));
         if(consume(LPAR)){
-            if(expr()){
-                while(consume(COMMA)){
-                    if(expr()){}
-                    else{
-                        tkerr( "Lipseste expresie dupa ,");
-                    }
-                }
-            }
-            if(consume(RPAR)){
-                return true;
-            }
-            else tkerr( "Lipseste: )");
+            if(s->kind!=SK_FN)
+                tkerr("Only a function can be called");
+            f=pushExprFrame(EF_CALL);
+            f->call.fn=s;
+            f->call.param=s->fn.params;
+            f->call.afterComma=false;
+            return ES_OPERAND;
         }
-        return true;
+        if(s->kind==SK_FN)
+            tkerr("A function can only be called");
+        gcVarAddr(s);
+        r->type=s->type;
+        r->lval=true;
+        r->ct=typeOf(s->type)->n>=0;
+        return ES_POSTFIX;
     }
-    iTk=start;
-    if(consume(TYPE_INT)){
-        return true;
+    if(consume(INT)){
+        gcAddInt(OP_PUSH_I,consumedTk->i);
+        r->type=TID_INT;
+        r->lval=false;
+        r->ct=true;
+        return ES_POSTFIX;
+    }
+    if(consume(DOUBLE)){
+        gcAddDouble(OP_PUSH_F,tkDouble(consumedTk));
+        r->type=TID_DOUBLE;
+        r->lval=false;
+        r->ct=true;
+        return ES_POSTFIX;
     }
-    if(consume(TYPE_DOUBLE)){
-        return true;
+    if(consume(CHAR)){
+        gcAddInt(OP_PUSH_I,consumedTk->c);
+        r->type=TID_CHAR;
+        r->lval=false;
+        r->ct=true;
+        return ES_POSTFIX;
     }
-    if(consume(TYPE_CHAR)){
-        return true;
+    if(consume(STRING)){
+        gcAddPtr(OP_PUSH_A,(char*)tkText(consumedTk));     // the string is a constant (r->lval is false)
+        r->type=TID_STRING;
+        r->lval=false;
+        r->ct=true;
+        return ES_POSTFIX;
     }
     if(consume(LPAR)){
-        if(expr()){
-            if(consume(RPAR)){
-                return true;
-            }
-            else tkerr( "Lipseste )");
+        // no error if there is no expression inside: the operand fails and its context reports the error
+        pushExprFrame(EF_PAREN)->lpar=consumedTk;
+        return ES_OPERAND;
+    }
+    return ES_OPERAND_FAILED;
+}
+
+// exprPostfix: exprPrimary ( LBRACKET expr RBRACKET | DOT ID )*
+static ExprState exprPostfix(Ret *r){
+    for(;;){
+        if(consume(LBRACKET)){
+            gcRVal(r);
+            pushExprFrame(EF_INDEX)->r=*r;
+            return ES_OPERAND;
         }
-        else tkerr( "Lipseste expresia dupa (");
+        if(!consume(DOT))
+            return ES_OPERAND_END;
+        if(!consume(ID))
+            tkerr( "Lipseste identificatorul de dupa .");
+        Token *tkName=consumedTk;
+        Type *t=typeOf(r->type);
+        if(t->tb!=TB_STRUCT||t->n>=0)
+            tkerr("A field can only be selected from a struct");
+        Symbol *s=findSymbolInList(t->s->structMembers,tkText(tkName));
+        if(!s)
+            tkerr("The structure %s does not have a field %s",t->s->name,tkText(tkName));
+        // OFFSET is generated even for the first field, so the address is not mistaken for a scalar variable's slot
+        gcAddInt(OP_OFFSET,s->varIdx);
+        r->type=s->type;
+        r->lval=true;
+        r->ct=typeOf(s->type)->n>=0;
     }
-    iTk = start;
-    return false;
 }
 
-bool exprCast(){
-    Token *start=iTk;
-    if(consume(LPAR)){
-        Type t;
-        if(typeBase(&t)){
-            if(arrayDecl(&t)){}
-            if(consume(RPAR)){
-                if(exprCast()){
-                    return true;
-                }
+// applies to r the unary operators and the casts of its operand, from the innermost one
+// the first operand of an expression, if it is not a cast, can be the destination of an assignment: exprUnary ASSIGN expr
+static ExprState exprOperandEnd(Ret *r,int base){
+    bool isCast=false;
+    for(;;){
+        ExprFrame *f=exprTop();
+        if(f->kind==EF_UNARY){
+            char c=f->code==SUB?'-':'!';
+            if(!canBeScalar(r))
+                tkerr("Unary %c must have a scalar operand", c);
+            gcRVal(r);
+            if(c=='-'){
+                gcAdd(r->type==TID_DOUBLE?OP_NEG_F:OP_NEG_I);
+            }else{
+                gcAdd(r->type==TID_DOUBLE?OP_NOT_F:OP_NOT_I);
+                r->type=TID_INT;
             }
-            else tkerr(" Lipseste : )");
-        }
+            r->lval=false;
+            r->ct=true;
+        }else if(f->kind==EF_CAST){
+            Type *tOp=typeOf(r->type);
+            if(f->cast.tb==TB_STRUCT)
+                tkerr("Cannot convert to a struct type");
+            if(tOp->tb==TB_STRUCT)
+                tkerr("Cannot convert a struct");
+            if(tOp->n>=0&&f->cast.n<0)
+                tkerr("An array can be converted only to another array");
+            if(tOp->n<0&&f->cast.n>=0)
+                tkerr("A scalar can be converted only to another scalar");
+            TypeId tDst=typeIntern(&f->cast);
+            gcRVal(r);
+            gcConv(gcLast(),r->type,tDst);
+            r->type=tDst;
+            r->lval=false;
+            r->ct=true;
+            isCast=true;
+        }else break;
+        nExprFrames--;
     }
-    iTk=start;
-    if(exprUnary()){
-        return true;
+    Instr *startInstr=exprTop()->operand.startInstr;
+    nExprFrames--;
+    bool first=nExprFrames==base||exprTop()->kind!=EF_BINARY;
+    if(first&&!isCast&&consume(ASSIGN)){
+        ExprFrame *f=pushExprFrame(EF_ASSIGN);
+        f->r=*r;
+        f->assign.startInstr=startInstr;
+        f->assign.lastDst=gcLast();
+        return ES_OPERAND;
     }
-    iTk = start;
-    return false;
+    return ES_BINARY;
 }
 
-bool exprPostfix(){
-    Token *start=iTk;
-    if(exprPrimary()){
-        if(exprPostfixSecondary()){
-            return true;
+// binaryOps: ( BINARY_OP operand )*, where each operator has a precedence of at least minPrec
+// minPrec is PREC_OR for the operators of an expression and the next precedence after the operator for a right operand,
+// so a right operand takes only the operators with a higher precedence and all the operators are left associative
+static ExprState exprBinary(Ret *r,int base){
+    bool right=nExprFrames>base&&exprTop()->kind==EF_BINARY;
+    int minPrec=right?binaryPrec(exprTop()->code)+1:PREC_OR;
+    int code=iTk->code;
+    int prec=binaryPrec(code);
+    if(prec!=PREC_NONE&&prec>=minPrec){
+        consume(code);
+        gcRVal(r);
+        ExprFrame *f=pushExprFrame(EF_BINARY);
+        f->code=code;
+        f->r=*r;
+        if(code==OR){
+            // a||b is evaluated as: a ? 1 : (b!=0)
+            gcCond(r->type);
+            f->instr=gcAdd(OP_JT);
+        }else if(code==AND){
+            // a&&b is evaluated as: a ? (b!=0) : 0
+            gcCond(r->type);
+            f->instr=gcAdd(OP_JF);
+        }else f->instr=gcLast();
+        return ES_OPERAND;
+    }
+    if(!right)
+        return ES_EXPR_END;
+    // r is the complete right operand of the operator from the stack top
+    ExprFrame *f=exprTop();
+    TypeId tDst;
+    if(!arithTypeTo(f->r.type,r->type,&tDst))
+        tkerr("Invalid operand type for %s",binaryOps[f->code].name);
+    gcRVal(r);
+    if(f->code==OR||f->code==AND){
+        gcBool(r->type);
+        Instr *jmp=gcAdd(OP_JMP);
+        f->instr->arg.instr=gcAddInt(OP_PUSH_I,f->code==OR);
+        jmp->arg.instr=gcAdd(OP_NOP);
+        setLogicRet(r);
+    }else{
+        gcConv(f->instr,f->r.type,tDst);
+        gcConv(gcLast(),r->type,tDst);
+        gcAdd(gcBinaryOp(f->code,tDst));
+        if(binaryPrec(f->code)>=PREC_ADD){
+            r->type=tDst;
+            r->lval=false;
+            r->ct=true;
         }
+        else setLogicRet(r);
     }
-    iTk = start;
-    return false;
+    nExprFrames--;
+    return ES_BINARY;
 }
 
+// the arguments of the call from the stack top ended: RPAR
+static ExprState exprCallEnd(Ret *r){
+    ExprFrame *f=exprTop();
+    if(!consume(RPAR))
+        tkerr(" Lipseste: )");
+    Symbol *s=f->call.fn;
+    if(f->call.param)
+        tkerr("Too few arguments in the call of %s",s->name);
+    gcAddPtr(s->fn.extFnPtr?OP_CALL_EXT:OP_CALL,s);
+    r->type=s->type;
+    r->lval=false;
+    r->ct=true;
+    nExprFrames--;
+    return ES_POSTFIX;
+}
 
-bool exprPrimary(){
-    Token *start=iTk;
-    if(consume(ID)){
-        if(consume(LPAR)){
-            if(expr()){
-                while(consume(COMMA)){
-                    if(expr()){}
-                    else{
-                        tkerr(" Lipseste expresie dupa  ,");
-                    }
-                }
+// r is a complete expression, which ends the construct from the stack top
+static ExprState exprEnd(Ret *r){
+    ExprFrame *f=exprTop();
+    switch(f->kind){
+        case EF_ASSIGN:{
+            Ret *rDst=&f->r;
+            if(!rDst->lval)tkerr("The assign destination must be a left-value!");
+            if(rDst->ct)tkerr("The assign destination cannot be constant!");
+            if(!canBeScalar(rDst))tkerr("The assign destination must be scalar!");
+            if(!canBeScalar(r))tkerr("The assign source must be scalar!");
+            if(!convTo(r->type,rDst->type))tkerr("The assign source cannot be converted to destination!");
+            gcRVal(r);
+            gcConv(gcLast(),r->type,rDst->type);
+            gcStore(f->assign.startInstr,f->assign.lastDst,rDst->type);
+            r->type=rDst->type;
+            r->lval=false;
+            r->ct=true;
+            nExprFrames--;
+            return ES_EXPR_END;
             }
-            if(consume(RPAR)){
-                return true;
+        case EF_PAREN:
+            if(!consume(RPAR))
+                tkerr(" Lipseste: )");
+            nExprFrames--;
+            return ES_POSTFIX;
+        case EF_INDEX:{
+            if(!consume(RBRACKET))
+                tkerr( "Lipseste: ]");
+            Type elem=*typeOf(f->r.type);
+            if(elem.n<0)
+                tkerr("Only an array can be indexed");
+            if(!convTo(r->type,TID_INT))
+                tkerr("The index is not convertible to int");
+            int dim=elem.n;
+            elem.n=-1;
+            gcRVal(r);
+            gcConv(gcLast(),r->type,TID_INT);
+            if(gcBoundsChecks&&dim>0)gcAddInt(OP_CHECK,dim);
+            gcAddInt(OP_INDEX,typeSize(&elem));
+            r->type=typeIntern(&elem);
+            r->lval=true;
+            r->ct=false;
+            nExprFrames--;
+            return ES_POSTFIX;
             }
-            else tkerr(" Lipseste: )");
-        }
-        return true;
-    }
-    iTk=start;
-    if(consume(INT)){
-        return true;
-    }
-    if(consume(DOUBLE)){
-        return true;
+        case EF_CALL:{
+            Symbol *s=f->call.fn,*param=f->call.param;
+            if(!param)
+                tkerr("Too many arguments in the call of %s",s->name);
+            if(!convTo(r->type,param->type))
+                tkerr("In the call of %s, cannot convert the argument type to the parameter type",s->name);
+            gcRVal(r);
+            gcConv(gcLast(),r->type,param->type);
+            if(typeOf(param->type)->tb==TB_STRUCT&&typeOf(param->type)->n<0)
+                gcAddInt(OP_PUSH_STRUCT,typeSize(typeOf(param->type)));
+            f->call.param=param->next;
+            if(consume(COMMA)){
+                f->call.afterComma=true;
+                return ES_OPERAND;
+            }
+            return exprCallEnd(r);
+            }
+        default:
+            err("invalid expression frame");
     }
-    if(consume(CHAR)){
-        return true;
+}
+
+// no operand begins at iTk: drops the frames of the operand
+// the operand can be missing only at the beginning of an expression
+static ExprState exprOperandFailed(int base){
+    ExprFrame *f=exprTop();
+    if(f->kind==EF_UNARY)
+        tkerr( "Lipseste expresia de dupa %c",f->code==SUB?'-':'!');
+    while(f->kind==EF_CAST)
+        f=&exprFrames[--nExprFrames-1];
+    iTk=f->operand.start;
+    nExprFrames--;
+    if(nExprFrames>base&&exprTop()->kind==EF_BINARY){
+        f=exprTop();
+        if(f->code==OR)tkerr( "Lipseste expresia de dupa: ||");
+        if(f->code==AND)tkerr( "Lipseste expresia dupa: &&");
+        tkerr( "Lipseste expresia de dupa %s",binaryOps[f->code].name);
     }
-    if(consume(STRING)){
-        return true;
+    return ES_EXPR_FAILED;
+}
+
+// no expression begins at iTk, inside the construct from the stack top
+static ExprState exprFailed(Ret *r){
+    ExprFrame *f=exprTop();
+    switch(f->kind){
+        case EF_ASSIGN:tkerr( "Lipseste termenul drept al expresiei");
+        case EF_INDEX:tkerr( "Lipseste expresia dintre: []");
+        case EF_CALL:
+            if(f->call.afterComma)
+                tkerr(" Lipseste expresie dupa  ,");
+            // a call without arguments
+            return exprCallEnd(r);
+        case EF_PAREN:
+            // the ( does not begin a primary expression, so the operand which contains it fails
+            iTk=f->lpar;
+            nExprFrames--;
+            return ES_OPERAND_FAILED;
+        default:
+            err("invalid expression frame");
     }
-    if(consume(LPAR)){
-        if(expr()){
-            if(consume(RPAR)){
-                return true;
-            }
-            else tkerr(" Lipseste: )");
+}
+
+// expr: exprUnary ASSIGN expr | operand binaryOps
+// the nested expressions are parsed in the same loop, using the frames above base
+bool expr(Ret *r){
+    int base=nExprFrames;
+    ExprState state=ES_OPERAND;
+    for(;;){
+        switch(state){
+            case ES_OPERAND:state=exprOperand(r);break;
+            case ES_POSTFIX:state=exprPostfix(r);break;
+            case ES_OPERAND_END:state=exprOperandEnd(r,base);break;
+            case ES_OPERAND_FAILED:state=exprOperandFailed(base);break;
+            case ES_EXPR_FAILED:
+                if(nExprFrames==base)
+                    return false;
+                state=exprFailed(r);
+                break;
+            case ES_BINARY:state=exprBinary(r,base);break;
+            case ES_EXPR_END:
+                if(nExprFrames==base)
+                    return true;
+                state=exprEnd(r);
+                break;
         }
-        else tkerr(" Lipseste expresie dupa (");
     }
-    iTk = start;
-    return false;
 }
 
+
 // unit: ( structDef | fnDef | varDef )* END
+// the definition is selected by its first tokens, so it is parsed only once:
+// STRUCT ID LACC begins a structDef, and VOID or the other type bases begin a fnDef or a varDef
 bool unit(){
 	for(;;){
-		if(structDef()){}
-		else if(fnDef()){}
-		else if(varDef()){}
+		Token *tk=iTk;
+		if(tk->code==STRUCT&&(tk->next->code!=ID||tk->next->next->code==LACC))structDef();
+		else if(tk->code==VOID||startsTypeBase(tk))fnOrVarDef();
 		else break;
 		}
 	if(consume(END)){
@@ -826,3 +1048,157 @@ void parse(Token *tokens){
 	iTk=tokens;
 	if(!unit())tkerr("syntax error");
 	}
+
+void parseDeclarations(Token *tokens){
+    lazyMode=true;
+    parse(tokens);
+    lazyMode=false;
+}
+
+// parses a recorded body, in the domain of the calling thread, which must be the global one
+static void parseBody(LazyBody *lazy){
+    Symbol *fn=lazy->fn;
+    loopBreaks=NULL;
+    loopDepth=0;
+    // only the global symbols defined before fn's body are visible in it, as in a full parse
+    lastVisibleGlobal=fn->fn.lastVisible;
+    Token *savedTk=iTk,*savedConsumed=consumedTk;
+    owner=fn;
+    pushDomain();
+    for(Symbol *p=fn->fn.params;p;p=p->next)addSymbolToDomain(symTable,dupSymbol(&symTable->arena,p));
+    iTk=gcSrcTk=lazy->body;
+    if(!fnBody(fn))tkerr("invalid body of the function %s",fn->name);
+    lastVisibleGlobal=NULL;
+    iTk=savedTk;
+    consumedTk=savedConsumed;
+}
+
+bool parseFnBody(Symbol *fn){
+    int k;
+    for(k=0;k<nLazyBodies&&lazyBodies[k].fn!=fn;k++){}
+    if(k==nLazyBodies)return false;
+    LazyBody lazy=lazyBodies[k];
+    memmove(lazyBodies+k,lazyBodies+k+1,(nLazyBodies-k-1)*sizeof(LazyBody));
+    nLazyBodies--;
+    if(symTable->parent)err("parseFnBody: the current domain must be the global one");
+    parseBody(&lazy);
+    return true;
+}
+
+Token *lazyBodyOf(Symbol *fn){
+    for(int k=0;k<nLazyBodies;k++){
+        if(lazyBodies[k].fn==fn)return lazyBodies[k].body;
+    }
+    return NULL;
+}
+
+void reparseFnBody(Symbol *fn,Token *body){
+    if(symTable->parent)err("reparseFnBody: the current domain must be the global one");
+    arenaReset(&fn->fn.arena);
+    fn->fn.locals=NULL;
+    freeInstrs(fn->fn.instr);
+    fn->fn.instr=NULL;
+    fn->fn.frame.localsSize=0;
+    parseBody(&(LazyBody){fn,body});
+}
+
+void parseRecover(){
+    lazyMode=false;
+    nStmFrames=0;
+    nExprFrames=0;
+    owner=NULL;
+    gcSrcTk=NULL;
+    lastVisibleGlobal=NULL;
+}
+
+void parseLazyBodies(){
+    while(nLazyBodies)parseFnBody(lazyBodies[0].fn);
+    free(lazyBodies);
+    lazyBodies=NULL;
+    lazyBodiesCap=0;
+}
+
+// the work shared by the threads of parseBodiesParallel
+typedef struct{
+    Domain *globals;
+    LineTable *lines;   // the lines of the source, for the lines of the generated code
+    const char *file;   // the source file of the errors
+    atomic_int next;    // the index of the next body to be parsed
+    // the earliest body with an error (nLazyBodies if there is none) and its error
+    // each body is checked with errTrap, so the reported error does not depend on the order in which the threads run
+    mtx_t errLock;
+    atomic_int errBody;
+    char errMsg[ERR_MSG_SIZE];
+    int errLine,errColumn;
+}BodiesWork;
+
+void parseThreadExit(){
+    trimDomains();
+    free(stmFrames);
+    free(exprFrames);
+    stmFrames=NULL;
+    exprFrames=NULL;
+    nStmFrames=stmFramesCap=0;
+    nExprFrames=exprFramesCap=0;
+}
+
+static int bodiesWorker(void *arg){
+    BodiesWork *work=(BodiesWork*)arg;
+    symTable=work->globals;
+    tkLines=work->lines;
+    errFile=work->file;
+    jmp_buf *savedTrap=errTrap;
+    jmp_buf trap;
+    for(;;){
+        int k=atomic_fetch_add(&work->next,1);
+        // the bodies are taken in order, so after an error only the earlier bodies can have an error which is reported
+        if(k>=nLazyBodies||k>atomic_load(&work->errBody))break;
+        errTrap=&trap;
+        if(setjmp(trap)){
+            parseRecover();
+            while(symTable!=work->globals)dropDomain();
+            mtx_lock(&work->errLock);
+            if(k<atomic_load(&work->errBody)){
+                atomic_store(&work->errBody,k);
+                memcpy(work->errMsg,errMsg,ERR_MSG_SIZE);
+                work->errLine=errLine;
+                work->errColumn=errColumn;
+            }
+            mtx_unlock(&work->errLock);
+            continue;
+        }
+        parseBody(&lazyBodies[k]);
+    }
+    errTrap=savedTrap;
+    parseThreadExit();
+    return 0;
+}
+
+void parseBodiesParallel(int nThreads){
+    if(symTable->parent)err("parseBodiesParallel: the current domain must be the global one");
+    // the global domain is only read by the threads
+    if(nThreads>nLazyBodies)nThreads=nLazyBodies;
+    if(nThreads<1)nThreads=1;
+    BodiesWork work={.globals=symTable,.lines=tkLines,.file=errFile};
+    atomic_init(&work.next,0);
+    if(mtx_init(&work.errLock,mtx_plain)!=thrd_success)err("cannot create the errors lock");
+    atomic_init(&work.errBody,nLazyBodies);
+    // the calling thread is one of the workers, so all the bodies are parsed even if no thread can be created
+    thrd_t *threads=(thrd_t*)safeAlloc(nThreads*sizeof(thrd_t));
+    int nStarted=0;
+    for(;nStarted<nThreads-1;nStarted++){
+        if(thrd_create(&threads[nStarted],bodiesWorker,&work)!=thrd_success)break;
+    }
+    Domain *saved=symTable;
+    bodiesWorker(&work);
+    symTable=saved;
+    for(int i=0;i<nStarted;i++)thrd_join(threads[i],NULL);
+    free(threads);
+    mtx_destroy(&work.errLock);
+    bool failed=atomic_load(&work.errBody)<nLazyBodies;
+    free(lazyBodies);
+    lazyBodies=NULL;
+    nLazyBodies=lazyBodiesCap=0;
+    errFile=work.file;
+    if(failed)errAt(work.errLine,work.errColumn,"%s",work.errMsg);
+}
@@ -1,33 +1,50 @@
 #pragma once
 
 #include "lexer.h"
+#include "at.h"
 #include <stdbool.h>
 
 void parse(Token *tokens);
+// parses only the declarations: the function bodies are skipped by matching their braces,
+// so the global symbols are available without the cost of parsing and checking the bodies
+// the tokens must be kept until all the bodies are parsed
+void parseDeclarations(Token *tokens);
+// parses, checks and generates the code of fn's body, which was skipped by parseDeclarations
+// the current domain must be the global one
+// returns false if the body of fn is not waiting to be parsed
+bool parseFnBody(Symbol *fn);
+// returns the { of fn's body, if the body is waiting to be parsed, else NULL
+Token *lazyBodyOf(Symbol *fn);
+// parses again the body of fn, which starts with the token body, after its tokens were edited
+// the previous locals and code of fn are dropped
+// the current domain must be the global one
+void reparseFnBody(Symbol *fn,Token *body);
+// resets the parser's state after an error which was caught with errTrap
+// the domains pushed by the interrupted parsing must be dropped by the caller
+void parseRecover();
+// parses all the bodies which are not parsed yet, in their definition order
+void parseLazyBodies();
+// the number of threads used by main to check the function bodies
+#define PARSE_THREADS 4
+// parses all the bodies which are not parsed yet, with nThreads threads which share the read-only global domain
+// each body is checked in its own domains and gets its own code, exactly as in parseLazyBodies
+// if several bodies have errors, the error of the first one in the source is reported
+// the current domain must be the global one
+void parseBodiesParallel(int nThreads);
+// a whole program unit can be parsed with parse by any thread, in its own global domain, while other threads parse
+// other units
+// frees the parser's state of the calling thread, which ends after it parsed in parallel with other threads
+void parseThreadExit();
+// the maximum nesting of the statements and of the expressions, as the number of their pending constructs
+// the nested constructs are kept on heap stacks, not on the C stack, so the limit only bounds the memory used by them
+#define PARSE_MAX_NESTING 10000000
+extern int parseMaxNesting;
 bool unit();
 bool structDef();
 bool varDef();
-bool typeBase();
-bool arrayDecl();
-bool fnDef();
+bool typeBase(Type *t);
+bool arrayDecl(Type *t);
 bool fnParam();
 bool stm();
 bool stmCompound(bool newDomain); 
-bool expr();
-bool exprAssign();
-bool exprOr();
-bool exprOrSecondary();
-bool exprAnd();
-bool exprAndSecondary();
-bool exprEq();
-bool exprEqSecondary();
-bool exprRel();
-bool exprRelSecondary();
-bool exprAdd();
-bool exprAddSecondary();
-bool exprMul();
-bool exprMulSecondary();
-bool exprCast();
-bool exprUnary();
-bool exprPostfix();
-bool exprPrimary();
+bool expr(Ret *r);
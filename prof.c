@@ -0,0 +1,393 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE		// for sigaction and setitimer
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#ifndef _WIN32
+#include <sys/time.h>
+#endif
+
+#include "prof.h"
+#include "lexer.h"
+#include "utils.h"
+
+bool profEnabled;
+bool profCounting;
+ProfNode *profNode;
+ProfLine *profLines;
+volatile sig_atomic_t profTicks;
+
+static ProfNode *root;
+static int nLines;		// the number of entries in profLines
+static Instr **sameLineLoops;		// the jumps back to an instruction from their own line, sorted by address
+static int nSameLineLoops;
+static clock_t startClock;
+static double cpuMs;		// the CPU time of the profiled run, which is divided between the samples
+#ifndef _WIN32
+static struct sigaction oldAction;
+#endif
+
+#define PROF_TOP_LINES 10		// the number of the hottest lines and loops shown by profReport
+
+void profSample(Instr *i){
+	int n=profTicks;
+	profTicks-=n;
+	profNode->samples+=n;
+	profLines[i->line].samples+=n;
+	}
+
+void profCall(Symbol *fn){
+	ProfNode *n;
+	for(n=profNode->children;n&&n->fn!=fn;n=n->next){}
+	if(!n){
+		n=(ProfNode*)safeAlloc(sizeof(ProfNode));
+		memset(n,0,sizeof(ProfNode));
+		n->fn=fn;
+		n->parent=profNode;
+		n->next=profNode->children;
+		profNode->children=n;
+		}
+	n->calls++;
+	profNode=n;
+	}
+
+static int cmpInstrs(const void *a,const void *b){
+	uintptr_t x=(uintptr_t)*(Instr*const*)a,y=(uintptr_t)*(Instr*const*)b;
+	return x<y?-1:x>y;
+	}
+
+bool profSameLineLoop(Instr *jmp){
+	return nSameLineLoops&&bsearch(&jmp,sameLineLoops,nSameLineLoops,sizeof(Instr*),cmpInstrs);
+	}
+
+// the lines cannot tell if a jump inside a line goes back, so these jumps are found by their position in fn's code
+static void findSameLineLoops(Symbol *fn){
+	InstrIndex index;
+	initInstrIndex(&index,fn->fn.instr);
+	for(int k=0;k<index.n;k++){
+		Instr *i=index.instrs[k];
+		if(i->op!=OP_JMP&&i->op!=OP_JF&&i->op!=OP_JT)continue;
+		if(i->arg.instr->line!=i->line||instrIndex(&index,i->arg.instr)>k)continue;
+		sameLineLoops=(Instr**)realloc(sameLineLoops,(nSameLineLoops+1)*sizeof(Instr*));
+		if(!sameLineLoops)err("not enough memory");
+		sameLineLoops[nSameLineLoops++]=i;
+		}
+	freeInstrIndex(&index);
+	}
+
+#ifndef _WIN32
+static void onTick(int sig){
+	(void)sig;
+	profTicks++;
+	}
+#endif
+
+void profStart(Domain *d,bool countInstrs){
+	profFree();
+	int maxLine=0;
+	for(Symbol *s=d->symbols;s;s=s->next){
+		if(s->kind!=SK_FN||!s->fn.instr)continue;
+		for(Instr *i=s->fn.instr;i;i=i->next){
+			if(i->line>maxLine)maxLine=i->line;
+			}
+		findSameLineLoops(s);
+		}
+	if(nSameLineLoops)qsort(sameLineLoops,nSameLineLoops,sizeof(Instr*),cmpInstrs);
+	nLines=maxLine+1;
+	profLines=(ProfLine*)safeAlloc(nLines*sizeof(ProfLine));
+	memset(profLines,0,nLines*sizeof(ProfLine));
+	root=(ProfNode*)safeAlloc(sizeof(ProfNode));
+	memset(root,0,sizeof(ProfNode));
+	profNode=root;
+	profTicks=0;
+	profCounting=countInstrs;
+	profEnabled=true;
+	cpuMs=0;
+	startClock=clock();
+#ifndef _WIN32
+	struct sigaction action;
+	memset(&action,0,sizeof(action));
+	action.sa_handler=onTick;
+	action.sa_flags=SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGPROF,&action,&oldAction);
+	struct itimerval timer={{0,PROF_INTERVAL_US},{0,PROF_INTERVAL_US}};
+	setitimer(ITIMER_PROF,&timer,NULL);
+#endif
+	}
+
+void profStop(){
+	if(!profEnabled)return;
+#ifndef _WIN32
+	struct itimerval timer;
+	memset(&timer,0,sizeof(timer));
+	setitimer(ITIMER_PROF,&timer,NULL);
+	sigaction(SIGPROF,&oldAction,NULL);
+#endif
+	profTicks=0;
+	profEnabled=false;
+	cpuMs=(double)(clock()-startClock)*1000/CLOCKS_PER_SEC;
+	}
+
+// the totals of a function, from all its calls paths
+typedef struct{
+	Symbol *fn;
+	long long instrs,samples;		// in fn's own code
+	long long totalInstrs,totalSamples;		// with the callees
+	long long calls;
+	int active;		// the number of fn's nodes on the current path of the traversal
+	}FnStats;
+
+typedef struct{
+	FnStats *fns;
+	int n,cap;
+	}FnTable;
+
+static FnStats *fnStats(FnTable *t,Symbol *fn){
+	for(int k=0;k<t->n;k++){
+		if(t->fns[k].fn==fn)return &t->fns[k];
+		}
+	if(t->n==t->cap){
+		t->cap=t->cap?t->cap*2:16;
+		t->fns=(FnStats*)realloc(t->fns,t->cap*sizeof(FnStats));
+		if(!t->fns)err("not enough memory");
+		}
+	FnStats *s=&t->fns[t->n++];
+	memset(s,0,sizeof(FnStats));
+	s->fn=fn;
+	return s;
+	}
+
+// the totals of all the nodes and of all the functions, in one traversal of the calls tree without recursion
+// a recursive function's total counts only its outermost calls, so its callees are not counted again for each level
+static void computeTotals(FnTable *t,long long *instrs,long long *samples){
+	ProfNode *n=root;
+	for(;;){
+		// entering n: its totals start with its own counts
+		n->totalInstrs=n->instrs;
+		n->totalSamples=n->samples;
+		if(n->fn){
+			FnStats *s=fnStats(t,n->fn);
+			s->instrs+=n->instrs;
+			s->samples+=n->samples;
+			s->calls+=n->calls;
+			s->active++;
+			}
+		if(n->children){
+			n=n->children;
+			continue;
+			}
+		for(;;){
+			// leaving n: all its children are done
+			if(n->fn){
+				FnStats *s=fnStats(t,n->fn);
+				if(!--s->active){
+					s->totalInstrs+=n->totalInstrs;
+					s->totalSamples+=n->totalSamples;
+					}
+				}
+			if(!n->parent){
+				*instrs=n->totalInstrs;
+				*samples=n->totalSamples;
+				return;
+				}
+			n->parent->totalInstrs+=n->totalInstrs;
+			n->parent->totalSamples+=n->totalSamples;
+			if(n->next){
+				n=n->next;
+				break;
+				}
+			n=n->parent;
+			}
+		}
+	}
+
+static bool sortBySamples;		// the sort key of the reports: the samples, if there are any, else the instructions
+
+static int cmpFns(const void *a,const void *b){
+	const FnStats *x=(const FnStats*)a,*y=(const FnStats*)b;
+	long long kx=sortBySamples?x->samples:x->instrs,ky=sortBySamples?y->samples:y->instrs;
+	if(kx!=ky)return kx<ky?1:-1;
+	return x->instrs<y->instrs?1:x->instrs>y->instrs?-1:0;
+	}
+
+static int cmpLines(const void *a,const void *b){
+	const ProfLine *x=&profLines[*(const int*)a],*y=&profLines[*(const int*)b];
+	long long kx=sortBySamples?x->samples:x->instrs,ky=sortBySamples?y->samples:y->instrs;
+	if(kx!=ky)return kx<ky?1:-1;
+	if(x->instrs!=y->instrs)return x->instrs<y->instrs?1:-1;
+	return *(const int*)a-*(const int*)b;
+	}
+
+static int cmpLoops(const void *a,const void *b){
+	const ProfLine *x=&profLines[*(const int*)a],*y=&profLines[*(const int*)b];
+	if(x->iterations!=y->iterations)return x->iterations<y->iterations?1:-1;
+	return *(const int*)a-*(const int*)b;
+	}
+
+static double percent(long long part,long long total){
+	return total?100.0*(double)part/(double)total:0;
+	}
+
+static long long allSamples;
+
+// the timer's signals can come less often than requested, so the samples get the measured CPU time
+static double ms(long long samples){
+	return allSamples?cpuMs*(double)samples/(double)allSamples:0;
+	}
+
+// the first line of the unit of the given program line (0 without the units)
+static int firstLineOf(const Unit *units,int nUnits,int line){
+	return units?units[unitOfLine(units,nUnits,line)].firstLine:0;
+	}
+
+// shows a line of the program as the line of its unit, and unit:line if there are several units
+static void showLine(FILE *out,const Unit *units,int nUnits,int line){
+	if(!units||nUnits<2){
+		fprintf(out,"%d",line);
+		return;
+		}
+	const Unit *u=&units[unitOfLine(units,nUnits,line)];
+	fprintf(out,"%s:%d",u->path,line-u->firstLine);
+	}
+
+// shows the text of the line, without its indentation
+// lines are the tables of the lines of the units
+static void showLineText(FILE *out,const Unit *units,int nUnits,const LineTable *lines,int line){
+	if(!units)return;
+	int k=unitOfLine(units,nUnits,line);
+	line-=units[k].firstLine;
+	if(line<1||line>lines[k].n)return;
+	const char *p=units[k].src+lines[k].starts[line-1];
+	while(*p==' '||*p=='\t')p++;
+	int len=0;
+	while(p[len]&&p[len]!='\n'&&p[len]!='\r'&&len<60)len++;
+	fprintf(out,"\t%.*s",len,p);
+	}
+
+void profReport(FILE *out,const Unit *units,int nUnits){
+	if(!root)return;
+	FnTable t={NULL,0,0};
+	long long instrs,samples;
+	computeTotals(&t,&instrs,&samples);
+	sortBySamples=samples>0;
+	allSamples=samples;
+	fprintf(out,"// profile: %lld instructions, %.0f ms of CPU time, %lld samples\n",instrs,cpuMs,samples);
+	qsort(t.fns,t.n,sizeof(FnStats),cmpFns);
+	fprintf(out,"// functions: self instructions, self time, total time (with the callees), calls\n");
+	for(int k=0;k<t.n;k++){
+		FnStats *s=&t.fns[k];
+		fprintf(out,"//\t%s\t%.1f%%\t%.0f ms\t%.0f ms\t%lld\n",s->fn->name,percent(s->instrs,instrs),ms(s->samples),ms(s->totalSamples),s->calls);
+		}
+	free(t.fns);
+	LineTable *lines=NULL;
+	if(units){
+		lines=(LineTable*)safeAlloc(nUnits*sizeof(LineTable));
+		for(int k=0;k<nUnits;k++){
+			lines[k]=(LineTable){NULL,0,0,0,false};
+			computeLines(&lines[k],units[k].src);
+			}
+		}
+	int *order=(int*)safeAlloc(nLines*sizeof(int));
+	int n=0;
+	for(int line=1;line<nLines;line++){
+		if(profLines[line].instrs||profLines[line].samples)order[n++]=line;
+		}
+	qsort(order,n,sizeof(int),cmpLines);
+	fprintf(out,"// hottest lines: instructions, time\n");
+	for(int k=0;k<n&&k<PROF_TOP_LINES;k++){
+		ProfLine *l=&profLines[order[k]];
+		fputs("//\t",out);
+		showLine(out,units,nUnits,order[k]);
+		fprintf(out,"\t%.1f%%\t%.0f ms",percent(l->instrs,instrs),ms(l->samples));
+		showLineText(out,units,nUnits,lines,order[k]);
+		fputc('\n',out);
+		}
+	n=0;
+	for(int line=1;line<nLines;line++){
+		if(profLines[line].iterations)order[n++]=line;
+		}
+	qsort(order,n,sizeof(int),cmpLoops);
+	if(n)fprintf(out,"// hottest loops: iterations, instructions and time in the loop's lines\n");
+	for(int k=0;k<n&&k<PROF_TOP_LINES;k++){
+		ProfLine *l=&profLines[order[k]];
+		long long loopInstrs=0,loopSamples=0;
+		for(int line=order[k];line<=l->loopEnd;line++){
+			loopInstrs+=profLines[line].instrs;
+			loopSamples+=profLines[line].samples;
+			}
+		fputs("//\tlines ",out);
+		showLine(out,units,nUnits,order[k]);
+		// the end of a loop whose code was inlined from another unit (or reordered by the IR) can be in another unit
+		int first=firstLineOf(units,nUnits,order[k]);
+		if(firstLineOf(units,nUnits,l->loopEnd)==first)fprintf(out,"-%d",l->loopEnd-first);
+		else{
+			fputc('-',out);
+			showLine(out,units,nUnits,l->loopEnd);
+			}
+		fprintf(out," in %s\t%lld\t%.1f%%\t%.0f ms",l->loopFn?l->loopFn->name:"?",l->iterations,percent(loopInstrs,instrs),ms(loopSamples));
+		showLineText(out,units,nUnits,lines,order[k]);
+		fputc('\n',out);
+		}
+	free(order);
+	if(units){
+		for(int k=0;k<nUnits;k++)freeLines(&lines[k]);
+		free(lines);
+		}
+	}
+
+void profWriteCollapsed(FILE *out,bool bySamples){
+	if(!root)return;
+	Symbol **path=NULL;
+	int pathCap=0;
+	for(ProfNode *n=root;n;){
+		long long count=bySamples?n->samples:n->instrs;
+		if(count&&n->fn){
+			int depth=0;
+			for(ProfNode *p=n;p->fn;p=p->parent){
+				if(depth==pathCap){
+					pathCap=pathCap?pathCap*2:64;
+					path=(Symbol**)realloc(path,pathCap*sizeof(Symbol*));
+					if(!path)err("not enough memory");
+					}
+				path[depth++]=p->fn;
+				}
+			for(int k=depth-1;k>=0;k--)fprintf(out,"%s%c",path[k]->name,k?';':' ');
+			fprintf(out,"%lld\n",count);
+			}
+		// the next node in preorder
+		if(n->children){
+			n=n->children;
+			}else{
+			while(n&&!n->next)n=n->parent;
+			if(n)n=n->next;
+			}
+		}
+	free(path);
+	}
+
+void profFree(){
+	profStop();
+	for(ProfNode *n=root;n;){
+		// the children are freed before their parent
+		if(n->children){
+			n=n->children;
+			continue;
+			}
+		ProfNode *parent=n->parent;
+		if(parent)parent->children=n->next;
+		free(n);
+		n=parent;
+		}
+	root=profNode=NULL;
+	free(profLines);
+	profLines=NULL;
+	free(sameLineLoops);
+	sameLineLoops=NULL;
+	nSameLineLoops=0;
+	nLines=0;
+	}
@@ -0,0 +1,94 @@
+#pragma once
+
+// the execution profiler
+// while it is enabled, run counts the executed instructions by source line and by calls path:
+// each path of calls from the program's start is a node in the calls tree, so recursive calls do not grow the tree
+// with setitimer, the CPU time is also sampled every PROF_INTERVAL_US microseconds (or at the system's timer resolution):
+// a timer signal only counts a tick, which run attributes to the line and the calls path of the current instruction
+// a loop is found when a jump goes back to an earlier line, or to an earlier instruction of its own line: the target's line is the loop's header
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <signal.h>
+
+#include "vm.h"
+#include "ad.h"
+#include "link.h"
+
+#define PROF_INTERVAL_US 1000
+
+typedef struct ProfNode{
+	Symbol *fn;		// NULL for the root, which is the startup code
+	struct ProfNode *parent;
+	struct ProfNode *children;		// the functions called from this path
+	struct ProfNode *next;		// in parent's children
+	long long calls;
+	long long instrs;		// the instructions executed in fn's own code, on this path
+	long long samples;		// the time samples taken in fn's own code, on this path
+	long long totalInstrs,totalSamples;		// with the callees, computed by profReport
+	}ProfNode;
+
+typedef struct{
+	long long instrs;
+	long long samples;
+	long long iterations;		// the jumps back to this line, if it is a loop's header
+	int loopEnd;		// the last line of the loop which starts on this line
+	Symbol *loopFn;		// the function which runs the loop
+	}ProfLine;
+
+// the profiler's state, updated by run
+extern bool profEnabled;
+extern bool profCounting;		// if false, only the time, the calls and the loops are profiled, with a lower overhead
+extern ProfNode *profNode;		// the calls path which runs now
+extern ProfLine *profLines;		// by source line; line 0 is for the instructions without a line
+extern volatile sig_atomic_t profTicks;		// the timer ticks which are not attributed yet
+
+// attributes the pending ticks to the instruction i, from the current calls path
+void profSample(Instr *i);
+
+// the instruction i is executed now
+static inline void profInstr(Instr *i){
+	if(profTicks)profSample(i);
+	if(profCounting){
+		profLines[i->line].instrs++;
+		profNode->instrs++;
+		}
+	}
+
+// enters the calls path of fn, called from the current one
+void profCall(Symbol *fn);
+
+// returns from the current calls path; i is the instruction which returns, or the call of an extern function
+static inline void profReturn(Instr *i){
+	if(profTicks)profSample(i);
+	profNode=profNode->parent;
+	}
+
+// true if jmp goes back to an instruction from its own line (a loop written on a single line)
+bool profSameLineLoop(Instr *jmp);
+
+// a jump to the target of jmp was taken
+static inline void profJump(Instr *jmp){
+	int header=jmp->arg.instr->line;
+	if(header&&(header<jmp->line||(header==jmp->line&&profSameLineLoop(jmp)))){
+		ProfLine *l=&profLines[header];
+		l->iterations++;
+		if(jmp->line>l->loopEnd)l->loopEnd=jmp->line;
+		l->loopFn=profNode->fn;
+		}
+	}
+
+// starts a new profile of the code of the functions from domain d and starts the timer
+// countInstrs sets profCounting
+void profStart(Domain *d,bool countInstrs);
+// stops the timer; the profile is kept for the reports
+void profStop();
+// shows the instructions, the time and the calls of the functions, the hottest lines and loops
+// units are the nUnits units of the program, which give the text of the lines, or NULL
+// the lines are the program's lines (Unit.firstLine), which are shown as unit:line if there are several units
+void profReport(FILE *out,const Unit *units,int nUnits);
+// writes the calls paths in the collapsed stacks format of the flame graphs tools: "main;f;g count" on each line
+// the count is the number of time samples, or the number of instructions if bySamples is false (only if they were counted)
+void profWriteCollapsed(FILE *out,bool bySamples);
+// frees the profile
+void profFree();
@@ -0,0 +1,229 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <errno.h>
+#ifdef _WIN32
+#include <io.h>
+#define read _read
+#define write _write
+#define isatty _isatty
+#else
+#include <unistd.h>
+#endif
+
+#include "rt.h"
+#include "vm.h"
+#include "ad.h"
+#include "utils.h"
+
+static char outBuf[RT_OUT_SIZE];
+static int outLen;
+static int outInteractive=-1;		// -1 until the output is checked to be a terminal
+static bool flushAtExit;
+
+static char inBuf[RT_IN_SIZE];
+static int inPos,inLen;
+
+void rtFlush(){
+	if(!outLen)return;
+	// the host program can have its own output buffered in stdout, which must come first
+	fflush(stdout);
+	for(int done=0;done<outLen;){
+		int n=(int)write(1,outBuf+done,outLen-done);
+		if(n<0){
+			if(errno==EINTR)continue;
+			outLen=0;
+			err("cannot write the output of the program");
+			}
+		done+=n;
+		}
+	outLen=0;
+	}
+
+static void outWrite(const char *s,int n){
+	if(outInteractive<0){
+		outInteractive=isatty(1);
+		if(!flushAtExit){
+			atexit(rtFlush);
+			errFlush=rtFlush;
+			flushAtExit=true;
+			}
+		}
+	// on a terminal each line is shown as soon as it is complete
+	bool newline=outInteractive&&n>0&&memchr(s,'\n',n);
+	while(n>0){
+		if(outLen==RT_OUT_SIZE)rtFlush();
+		int k=RT_OUT_SIZE-outLen;
+		if(k>n)k=n;
+		memcpy(outBuf+outLen,s,k);
+		outLen+=k;
+		s+=k;
+		n-=k;
+		}
+	if(newline)rtFlush();
+	}
+
+static void outInt(int i){
+	char buf[16];
+	char *p=buf+sizeof(buf);
+	unsigned u=i<0?0u-(unsigned)i:(unsigned)i;
+	do{
+		*--p=(char)('0'+u%10);
+		u/=10;
+		}while(u);
+	if(i<0)*--p='-';
+	outWrite(p,(int)(buf+sizeof(buf)-p));
+	}
+
+// returns the next input character without consuming it, or EOF
+static int inPeek(){
+	if(inPos==inLen){
+		// a prompt must be visible before the program waits for input
+		rtFlush();
+		int n;
+		do{
+			n=(int)read(0,inBuf,RT_IN_SIZE);
+			}while(n<0&&errno==EINTR);
+		if(n<=0)return EOF;
+		inPos=0;
+		inLen=n;
+		}
+	return (unsigned char)inBuf[inPos];
+	}
+
+static int inGet(){
+	int c=inPeek();
+	if(c!=EOF)inPos++;
+	return c;
+	}
+
+static void inSkipSpaces(){
+	for(int c=inPeek();c==' '||c=='\t'||c=='\n'||c=='\r';c=inPeek())inPos++;
+	}
+
+// the builtins get their arguments from the VM stack, in the reverse order, and push their result
+
+static void puti(){
+	outInt(popi());
+	}
+
+static void putd(){
+	char buf[32];
+	outWrite(buf,snprintf(buf,sizeof(buf),"%g",popd()));
+	}
+
+static void putcExt(){
+	char c=(char)popi();
+	outWrite(&c,1);
+	}
+
+static void putsExt(){
+	const char *s=(const char*)popa();
+	outWrite(s,(int)strlen(s));
+	outWrite("\n",1);
+	}
+
+static void geti(){
+	inSkipSpaces();
+	int c=inPeek();
+	bool neg=c=='-';
+	if(c=='-'||c=='+'){
+		inPos++;
+		c=inPeek();
+		}
+	if(c<'0'||c>'9')err("geti: the input is not an integer");
+	// the magnitude of INT_MIN is one more than INT_MAX
+	unsigned u=0,max=neg?(unsigned)INT_MAX+1:(unsigned)INT_MAX;
+	for(;c>='0'&&c<='9';c=inPeek()){
+		unsigned d=(unsigned)(c-'0');
+		if(u>(max-d)/10)err("geti: the integer is out of range");
+		u=u*10+d;
+		inPos++;
+		}
+	pushi(neg?(int)(0u-u):(int)u);
+	}
+
+static void getd(){
+	char buf[64];
+	int n=0;
+	inSkipSpaces();
+	for(int c=inPeek();c!=EOF&&n<(int)sizeof(buf)-1&&strchr("+-.0123456789eE",c);c=inPeek()){
+		buf[n++]=(char)c;
+		inPos++;
+		}
+	buf[n]='\0';
+	char *end;
+	double d=strtod(buf,&end);
+	if(!n||*end)err("getd: the input is not a number");
+	pushd(d);
+	}
+
+static void getcExt(){
+	pushi(inGet());
+	}
+
+static void getsExt(){
+	int size=popi();
+	char *s=(char*)popa();
+	int c=inGet();
+	if(c==EOF){
+		if(size>0)s[0]='\0';
+		pushi(-1);
+		return;
+		}
+	// the characters which do not fit in s are skipped, up to the end of the line
+	int n=0;
+	for(;c!=EOF&&c!='\n';c=inGet()){
+		if(n<size-1)s[n++]=(char)c;
+		}
+	if(size>0)s[n]='\0';
+	pushi(n);
+	}
+
+static void strlenExt(){
+	pushi((int)strlen((const char*)popa()));
+	}
+
+static void strcmpExt(){
+	const char *b=(const char*)popa();
+	const char *a=(const char*)popa();
+	int r=strcmp(a,b);
+	pushi(r<0?-1:r>0);
+	}
+
+static void strcpyExt(){
+	int size=popi();
+	const char *src=(const char*)popa();
+	char *dst=(char*)popa();
+	size_t n=strlen(src);
+	if(size<=0||n>=(size_t)size)err("strcpy: the string of %zu characters does not fit in %d bytes",n,size);
+	memcpy(dst,src,n+1);
+	}
+
+void rtAddBuiltins(){
+	Symbol *fn=addExtFn("puti",puti,TID_VOID);
+	addFnParam(fn,"i",TID_INT);
+	fn=addExtFn("putd",putd,TID_VOID);
+	addFnParam(fn,"d",TID_DOUBLE);
+	fn=addExtFn("puts",putsExt,TID_VOID);
+	addFnParam(fn,"s",TID_STRING);
+	fn=addExtFn("putc",putcExt,TID_VOID);
+	addFnParam(fn,"c",TID_CHAR);
+	addExtFn("geti",geti,TID_INT);
+	addExtFn("getd",getd,TID_DOUBLE);
+	addExtFn("getc",getcExt,TID_INT);
+	fn=addExtFn("gets",getsExt,TID_INT);
+	addFnParam(fn,"s",TID_STRING);
+	addFnParam(fn,"size",TID_INT);
+	fn=addExtFn("strlen",strlenExt,TID_INT);
+	addFnParam(fn,"s",TID_STRING);
+	fn=addExtFn("strcmp",strcmpExt,TID_INT);
+	addFnParam(fn,"a",TID_STRING);
+	addFnParam(fn,"b",TID_STRING);
+	fn=addExtFn("strcpy",strcpyExt,TID_VOID);
+	addFnParam(fn,"dst",TID_STRING);
+	addFnParam(fn,"src",TID_STRING);
+	addFnParam(fn,"size",TID_INT);
+	}
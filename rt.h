@@ -0,0 +1,22 @@
+#pragma once
+
+// the runtime library: the builtin functions which the programs run by the VM can call
+// the output is collected in a user-space buffer and written with one system call when:
+// the buffer is full, a newline is written to an interactive terminal, the program needs input or it ends
+// the input is read in large blocks, in another buffer
+
+// the sizes of the output and input buffers
+#define RT_OUT_SIZE (64*1024)
+#define RT_IN_SIZE (64*1024)
+
+// adds the builtin functions to the current domain
+// output: puti(int), putd(double), putc(char), puts(char[]) (followed by a newline)
+// input: geti(), getd(), getc() (-1 at the end of the input), gets(char[] s,int size) (a line, returns its length or -1)
+// strings: strlen(char[]), strcmp(char[],char[]), strcpy(char[] dst,char[] src,int size) (size is dst's size)
+// geti, getd and strcpy stop the program with an error if the input is not a number, geti's integer is out of range
+// or src does not fit in dst
+void rtAddBuiltins();
+// writes the buffered output
+// it is called when the VM halts, before an error is written (errFlush) and at exit, so the output is complete
+// and it comes before the error which ends the program
+void rtFlush();
@@ -0,0 +1,12 @@
+// a global array of 80 MB: the data segment is only reserved, and its pages are committed when they are used
+double big[10000000];
+int after;
+void main(){
+	big[0]=1.5;
+	big[9999999]=2.5;
+	after=7;
+	puti(big[0]+big[9999999]+big[5000000]);
+	putc(32);
+	puti(after);
+	putc(10);
+	}
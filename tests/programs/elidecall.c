@@ -0,0 +1,24 @@
+// a struct argument is copied when it is pushed: a call in the following arguments which writes it does not change it
+struct S{ int a; int b; };
+struct S g;
+int two(struct S x,int y){
+	return x.a*100+y;
+	}
+int setg(){
+	g.a=7;
+	return 1;
+	}
+// only reads: its argument is passed by reference
+int three(struct S x,int y){
+	return x.a*100+y;
+	}
+int id(int v){
+	return v;
+	}
+void main(){
+	g.a=3;
+	puti(two(g,setg()));
+	putc(' ');
+	puti(three(g,id(2)));
+	putc(10);
+	}
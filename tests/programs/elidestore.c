@@ -0,0 +1,13 @@
+// a struct argument is copied when it is pushed: an assignment in the following arguments does not change it
+struct S{ int a; int b; };
+int two(struct S x,int y){
+	return x.a*100+y;
+	}
+void main(){
+	struct S s;
+	s.a=5;
+	puti(two(s,s.a=50));
+	putc(' ');
+	puti(s.a);
+	putc(10);
+	}
@@ -0,0 +1,104 @@
+// the function bodies are checked in parallel: the error of the first body in the source is reported,
+// even if a later body is checked faster by another thread
+int f0(int a){ int b; b=a*0; while(b>100){ b=b-100; } return b; }
+int f1(int a){ int b; b=a*1; while(b>100){ b=b-100; } return b; }
+int f2(int a){ int b; b=a*2; while(b>100){ b=b-100; } return b; }
+int f3(int a){ int b; b=a*3; while(b>100){ b=b-100; } return b; }
+int f4(int a){ int b; b=a*4; while(b>100){ b=b-100; } return b; }
+int f5(int a){ int b; b=a*5; while(b>100){ b=b-100; } return b; }
+int f6(int a){ int b; b=a*6; while(b>100){ b=b-100; } return b; }
+int f7(int a){ int b; b=a*7; while(b>100){ b=b-100; } return b; }
+int f8(int a){ int b; b=a*8; while(b>100){ b=b-100; } return b; }
+int f9(int a){ int b; b=a*9; while(b>100){ b=b-100; } return b; }
+int f10(int a){ int b; b=a*10; while(b>100){ b=b-100; } return b; }
+int f11(int a){ int b; b=a;
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b*2+a-(b/3); b=b*3+a-(b/4); b=b*4+a-(b/5); b=b*5+a-(b/6); b=b*6+a-(b/7); b=b*7+a-(b/8); b=b*8+a-(b/9); b=b*9+a-(b/10); b=b*10+a-(b/11); b=b*11+a-(b/12); b=b*12+a-(b/13); b=b*13+a-(b/14); b=b*14+a-(b/15); b=b*15+a-(b/16); b=b*16+a-(b/17); b=b*17+a-(b/18); b=b*18+a-(b/19); b=b*19+a-(b/20); b=b*20+a-(b/21); b=b*21+a-(b/22); b=b*22+a-(b/23); b=b*23+a-(b/24); b=b*24+a-(b/25); b=b*25+a-(b/26); b=b*26+a-(b/27); b=b*27+a-(b/28); b=b*28+a-(b/29); b=b*29+a-(b/30); b=b*30+a-(b/31); b=b*31+a-(b/32); b=b*32+a-(b/33); b=b*33+a-(b/34); b=b*34+a-(b/35); b=b*35+a-(b/36); b=b*36+a-(b/37); b=b*37+a-(b/38); b=b*38+a-(b/39); b=b*39+a-(b/40); b=b*40+a-(b/41); b=b*41+a-(b/42);
+	b=b+undefined11; return b; }
+int f12(int a){ int b; b=a*12; while(b>100){ b=b-100; } return b; }
+int f13(int a){ int b; b=a*13; while(b>100){ b=b-100; } return b; }
+int f14(int a){ int b; b=a*14; while(b>100){ b=b-100; } return b; }
+int f15(int a){ int b; b=a*15; while(b>100){ b=b-100; } return b; }
+int f16(int a){ int b; b=a*16; while(b>100){ b=b-100; } return b; }
+int f17(int a){ int b; b=a*17; while(b>100){ b=b-100; } return b; }
+int f18(int a){ int b; b=a*18; while(b>100){ b=b-100; } return b; }
+int f19(int a){ int b; b=a*19; while(b>100){ b=b-100; } return b; }
+int f20(int a){ int b; b=a*20; while(b>100){ b=b-100; } return b; }
+int f21(int a){ int b; b=a*21; while(b>100){ b=b-100; } return b; }
+int f22(int a){ int b; b=a*22; while(b>100){ b=b-100; } return b; }
+int f23(int a){ int b; b=a*23; while(b>100){ b=b-100; } return b; }
+int f24(int a){ int b; b=a*24; while(b>100){ b=b-100; } return b; }
+int f25(int a){ return a+undefined25; }
+int f26(int a){ int b; b=a*26; while(b>100){ b=b-100; } return b; }
+int f27(int a){ int b; b=a*27; while(b>100){ b=b-100; } return b; }
+int f28(int a){ int b; b=a*28; while(b>100){ b=b-100; } return b; }
+int f29(int a){ int b; b=a*29; while(b>100){ b=b-100; } return b; }
+int f30(int a){ int b; b=a*30; while(b>100){ b=b-100; } return b; }
+int f31(int a){ int b; b=a*31; while(b>100){ b=b-100; } return b; }
+int f32(int a){ int b; b=a*32; while(b>100){ b=b-100; } return b; }
+int f33(int a){ return a+undefined33; }
+int f34(int a){ int b; b=a*34; while(b>100){ b=b-100; } return b; }
+int f35(int a){ int b; b=a*35; while(b>100){ b=b-100; } return b; }
+int f36(int a){ int b; b=a*36; while(b>100){ b=b-100; } return b; }
+int f37(int a){ int b; b=a*37; while(b>100){ b=b-100; } return b; }
+int f38(int a){ int b; b=a*38; while(b>100){ b=b-100; } return b; }
+int f39(int a){ int b; b=a*39; while(b>100){ b=b-100; } return b; }
+void main(){ puti(f1(2)); putc(10); }
@@ -0,0 +1,32 @@
+// the int arithmetic wraps around in two's complement, when it is folded at compile time and when it runs
+int f(int a,int b){
+	return a/b;
+	}
+void main(){
+	int x;
+	int m;
+	int y;
+	x=2147483647;
+	m=-2147483647-1;
+	y=-1;
+	puti(x+1);
+	putc(' ');
+	puti(2147483647+1);
+	putc(' ');
+	puti((-2147483647-1)/(-1));
+	putc(' ');
+	puti(m/y);
+	putc(' ');
+	puti(f(m,-1));
+	putc(' ');
+	puti(-m);
+	putc(' ');
+	puti(m-1);
+	putc(' ');
+	puti(x*2);
+	putc(' ');
+	puti(65536*65536);
+	putc(' ');
+	puti(7/(-1));
+	putc(10);
+	}
@@ -0,0 +1,104 @@
+// the bodies checked in parallel add many new types, while the other threads read the types table
+int f0(){ char a[1]; int b[2]; double c[3]; char d[4]; int e[5]; double g[6]; b[0]=0; return b[0]; }
+int f1(){ char a[7]; int b[8]; double c[9]; char d[10]; int e[11]; double g[12]; b[0]=1; return b[0]; }
+int f2(){ char a[13]; int b[14]; double c[15]; char d[16]; int e[17]; double g[18]; b[0]=2; return b[0]; }
+int f3(){ char a[19]; int b[20]; double c[21]; char d[22]; int e[23]; double g[24]; b[0]=3; return b[0]; }
+int f4(){ char a[25]; int b[26]; double c[27]; char d[28]; int e[29]; double g[30]; b[0]=4; return b[0]; }
+int f5(){ char a[31]; int b[32]; double c[33]; char d[34]; int e[35]; double g[36]; b[0]=5; return b[0]; }
+int f6(){ char a[37]; int b[38]; double c[39]; char d[40]; int e[41]; double g[42]; b[0]=6; return b[0]; }
+int f7(){ char a[43]; int b[44]; double c[45]; char d[46]; int e[47]; double g[48]; b[0]=7; return b[0]; }
+int f8(){ char a[49]; int b[50]; double c[51]; char d[52]; int e[53]; double g[54]; b[0]=8; return b[0]; }
+int f9(){ char a[55]; int b[56]; double c[57]; char d[58]; int e[59]; double g[60]; b[0]=9; return b[0]; }
+int f10(){ char a[61]; int b[62]; double c[63]; char d[64]; int e[65]; double g[66]; b[0]=10; return b[0]; }
+int f11(){ char a[67]; int b[68]; double c[69]; char d[70]; int e[71]; double g[72]; b[0]=11; return b[0]; }
+int f12(){ char a[73]; int b[74]; double c[75]; char d[76]; int e[77]; double g[78]; b[0]=12; return b[0]; }
+int f13(){ char a[79]; int b[80]; double c[81]; char d[82]; int e[83]; double g[84]; b[0]=13; return b[0]; }
+int f14(){ char a[85]; int b[86]; double c[87]; char d[88]; int e[89]; double g[90]; b[0]=14; return b[0]; }
+int f15(){ char a[91]; int b[92]; double c[93]; char d[94]; int e[95]; double g[96]; b[0]=15; return b[0]; }
+int f16(){ char a[97]; int b[98]; double c[99]; char d[100]; int e[101]; double g[102]; b[0]=16; return b[0]; }
+int f17(){ char a[103]; int b[104]; double c[105]; char d[106]; int e[107]; double g[108]; b[0]=17; return b[0]; }
+int f18(){ char a[109]; int b[110]; double c[111]; char d[112]; int e[113]; double g[114]; b[0]=18; return b[0]; }
+int f19(){ char a[115]; int b[116]; double c[117]; char d[118]; int e[119]; double g[120]; b[0]=19; return b[0]; }
+int f20(){ char a[121]; int b[122]; double c[123]; char d[124]; int e[125]; double g[126]; b[0]=20; return b[0]; }
+int f21(){ char a[127]; int b[128]; double c[129]; char d[130]; int e[131]; double g[132]; b[0]=21; return b[0]; }
+int f22(){ char a[133]; int b[134]; double c[135]; char d[136]; int e[137]; double g[138]; b[0]=22; return b[0]; }
+int f23(){ char a[139]; int b[140]; double c[141]; char d[142]; int e[143]; double g[144]; b[0]=23; return b[0]; }
+int f24(){ char a[145]; int b[146]; double c[147]; char d[148]; int e[149]; double g[150]; b[0]=24; return b[0]; }
+int f25(){ char a[151]; int b[152]; double c[153]; char d[154]; int e[155]; double g[156]; b[0]=25; return b[0]; }
+int f26(){ char a[157]; int b[158]; double c[159]; char d[160]; int e[161]; double g[162]; b[0]=26; return b[0]; }
+int f27(){ char a[163]; int b[164]; double c[165]; char d[166]; int e[167]; double g[168]; b[0]=27; return b[0]; }
+int f28(){ char a[169]; int b[170]; double c[171]; char d[172]; int e[173]; double g[174]; b[0]=28; return b[0]; }
+int f29(){ char a[175]; int b[176]; double c[177]; char d[178]; int e[179]; double g[180]; b[0]=29; return b[0]; }
+int f30(){ char a[181]; int b[182]; double c[183]; char d[184]; int e[185]; double g[186]; b[0]=30; return b[0]; }
+int f31(){ char a[187]; int b[188]; double c[189]; char d[190]; int e[191]; double g[192]; b[0]=31; return b[0]; }
+int f32(){ char a[193]; int b[194]; double c[195]; char d[196]; int e[197]; double g[198]; b[0]=32; return b[0]; }
+int f33(){ char a[199]; int b[200]; double c[201]; char d[202]; int e[203]; double g[204]; b[0]=33; return b[0]; }
+int f34(){ char a[205]; int b[206]; double c[207]; char d[208]; int e[209]; double g[210]; b[0]=34; return b[0]; }
+int f35(){ char a[211]; int b[212]; double c[213]; char d[214]; int e[215]; double g[216]; b[0]=35; return b[0]; }
+int f36(){ char a[217]; int b[218]; double c[219]; char d[220]; int e[221]; double g[222]; b[0]=36; return b[0]; }
+int f37(){ char a[223]; int b[224]; double c[225]; char d[226]; int e[227]; double g[228]; b[0]=37; return b[0]; }
+int f38(){ char a[229]; int b[230]; double c[231]; char d[232]; int e[233]; double g[234]; b[0]=38; return b[0]; }
+int f39(){ char a[235]; int b[236]; double c[237]; char d[238]; int e[239]; double g[240]; b[0]=39; return b[0]; }
+int f40(){ char a[241]; int b[242]; double c[243]; char d[244]; int e[245]; double g[246]; b[0]=40; return b[0]; }
+int f41(){ char a[247]; int b[248]; double c[249]; char d[250]; int e[251]; double g[252]; b[0]=41; return b[0]; }
+int f42(){ char a[253]; int b[254]; double c[255]; char d[256]; int e[257]; double g[258]; b[0]=42; return b[0]; }
+int f43(){ char a[259]; int b[260]; double c[261]; char d[262]; int e[263]; double g[264]; b[0]=43; return b[0]; }
+int f44(){ char a[265]; int b[266]; double c[267]; char d[268]; int e[269]; double g[270]; b[0]=44; return b[0]; }
+int f45(){ char a[271]; int b[272]; double c[273]; char d[274]; int e[275]; double g[276]; b[0]=45; return b[0]; }
+int f46(){ char a[277]; int b[278]; double c[279]; char d[280]; int e[281]; double g[282]; b[0]=46; return b[0]; }
+int f47(){ char a[283]; int b[284]; double c[285]; char d[286]; int e[287]; double g[288]; b[0]=47; return b[0]; }
+int f48(){ char a[289]; int b[290]; double c[291]; char d[292]; int e[293]; double g[294]; b[0]=48; return b[0]; }
+int f49(){ char a[295]; int b[296]; double c[297]; char d[298]; int e[299]; double g[300]; b[0]=49; return b[0]; }
+int f50(){ char a[301]; int b[302]; double c[303]; char d[304]; int e[305]; double g[306]; b[0]=50; return b[0]; }
+int f51(){ char a[307]; int b[308]; double c[309]; char d[310]; int e[311]; double g[312]; b[0]=51; return b[0]; }
+int f52(){ char a[313]; int b[314]; double c[315]; char d[316]; int e[317]; double g[318]; b[0]=52; return b[0]; }
+int f53(){ char a[319]; int b[320]; double c[321]; char d[322]; int e[323]; double g[324]; b[0]=53; return b[0]; }
+int f54(){ char a[325]; int b[326]; double c[327]; char d[328]; int e[329]; double g[330]; b[0]=54; return b[0]; }
+int f55(){ char a[331]; int b[332]; double c[333]; char d[334]; int e[335]; double g[336]; b[0]=55; return b[0]; }
+int f56(){ char a[337]; int b[338]; double c[339]; char d[340]; int e[341]; double g[342]; b[0]=56; return b[0]; }
+int f57(){ char a[343]; int b[344]; double c[345]; char d[346]; int e[347]; double g[348]; b[0]=57; return b[0]; }
+int f58(){ char a[349]; int b[350]; double c[351]; char d[352]; int e[353]; double g[354]; b[0]=58; return b[0]; }
+int f59(){ char a[355]; int b[356]; double c[357]; char d[358]; int e[359]; double g[360]; b[0]=59; return b[0]; }
+int f60(){ char a[361]; int b[362]; double c[363]; char d[364]; int e[365]; double g[366]; b[0]=60; return b[0]; }
+int f61(){ char a[367]; int b[368]; double c[369]; char d[370]; int e[371]; double g[372]; b[0]=61; return b[0]; }
+int f62(){ char a[373]; int b[374]; double c[375]; char d[376]; int e[377]; double g[378]; b[0]=62; return b[0]; }
+int f63(){ char a[379]; int b[380]; double c[381]; char d[382]; int e[383]; double g[384]; b[0]=63; return b[0]; }
+int f64(){ char a[385]; int b[386]; double c[387]; char d[388]; int e[389]; double g[390]; b[0]=64; return b[0]; }
+int f65(){ char a[391]; int b[392]; double c[393]; char d[394]; int e[395]; double g[396]; b[0]=65; return b[0]; }
+int f66(){ char a[397]; int b[398]; double c[399]; char d[400]; int e[401]; double g[402]; b[0]=66; return b[0]; }
+int f67(){ char a[403]; int b[404]; double c[405]; char d[406]; int e[407]; double g[408]; b[0]=67; return b[0]; }
+int f68(){ char a[409]; int b[410]; double c[411]; char d[412]; int e[413]; double g[414]; b[0]=68; return b[0]; }
+int f69(){ char a[415]; int b[416]; double c[417]; char d[418]; int e[419]; double g[420]; b[0]=69; return b[0]; }
+int f70(){ char a[421]; int b[422]; double c[423]; char d[424]; int e[425]; double g[426]; b[0]=70; return b[0]; }
+int f71(){ char a[427]; int b[428]; double c[429]; char d[430]; int e[431]; double g[432]; b[0]=71; return b[0]; }
+int f72(){ char a[433]; int b[434]; double c[435]; char d[436]; int e[437]; double g[438]; b[0]=72; return b[0]; }
+int f73(){ char a[439]; int b[440]; double c[441]; char d[442]; int e[443]; double g[444]; b[0]=73; return b[0]; }
+int f74(){ char a[445]; int b[446]; double c[447]; char d[448]; int e[449]; double g[450]; b[0]=74; return b[0]; }
+int f75(){ char a[451]; int b[452]; double c[453]; char d[454]; int e[455]; double g[456]; b[0]=75; return b[0]; }
+int f76(){ char a[457]; int b[458]; double c[459]; char d[460]; int e[461]; double g[462]; b[0]=76; return b[0]; }
+int f77(){ char a[463]; int b[464]; double c[465]; char d[466]; int e[467]; double g[468]; b[0]=77; return b[0]; }
+int f78(){ char a[469]; int b[470]; double c[471]; char d[472]; int e[473]; double g[474]; b[0]=78; return b[0]; }
+int f79(){ char a[475]; int b[476]; double c[477]; char d[478]; int e[479]; double g[480]; b[0]=79; return b[0]; }
+int f80(){ char a[481]; int b[482]; double c[483]; char d[484]; int e[485]; double g[486]; b[0]=80; return b[0]; }
+int f81(){ char a[487]; int b[488]; double c[489]; char d[490]; int e[491]; double g[492]; b[0]=81; return b[0]; }
+int f82(){ char a[493]; int b[494]; double c[495]; char d[496]; int e[497]; double g[498]; b[0]=82; return b[0]; }
+int f83(){ char a[499]; int b[500]; double c[501]; char d[502]; int e[503]; double g[504]; b[0]=83; return b[0]; }
+int f84(){ char a[505]; int b[506]; double c[507]; char d[508]; int e[509]; double g[510]; b[0]=84; return b[0]; }
+int f85(){ char a[511]; int b[512]; double c[513]; char d[514]; int e[515]; double g[516]; b[0]=85; return b[0]; }
+int f86(){ char a[517]; int b[518]; double c[519]; char d[520]; int e[521]; double g[522]; b[0]=86; return b[0]; }
+int f87(){ char a[523]; int b[524]; double c[525]; char d[526]; int e[527]; double g[528]; b[0]=87; return b[0]; }
+int f88(){ char a[529]; int b[530]; double c[531]; char d[532]; int e[533]; double g[534]; b[0]=88; return b[0]; }
+int f89(){ char a[535]; int b[536]; double c[537]; char d[538]; int e[539]; double g[540]; b[0]=89; return b[0]; }
+int f90(){ char a[541]; int b[542]; double c[543]; char d[544]; int e[545]; double g[546]; b[0]=90; return b[0]; }
+int f91(){ char a[547]; int b[548]; double c[549]; char d[550]; int e[551]; double g[552]; b[0]=91; return b[0]; }
+int f92(){ char a[553]; int b[554]; double c[555]; char d[556]; int e[557]; double g[558]; b[0]=92; return b[0]; }
+int f93(){ char a[559]; int b[560]; double c[561]; char d[562]; int e[563]; double g[564]; b[0]=93; return b[0]; }
+int f94(){ char a[565]; int b[566]; double c[567]; char d[568]; int e[569]; double g[570]; b[0]=94; return b[0]; }
+int f95(){ char a[571]; int b[572]; double c[573]; char d[574]; int e[575]; double g[576]; b[0]=95; return b[0]; }
+int f96(){ char a[577]; int b[578]; double c[579]; char d[580]; int e[581]; double g[582]; b[0]=96; return b[0]; }
+int f97(){ char a[583]; int b[584]; double c[585]; char d[586]; int e[587]; double g[588]; b[0]=97; return b[0]; }
+int f98(){ char a[589]; int b[590]; double c[591]; char d[592]; int e[593]; double g[594]; b[0]=98; return b[0]; }
+int f99(){ char a[595]; int b[596]; double c[597]; char d[598]; int e[599]; double g[600]; b[0]=99; return b[0]; }
+void main(){ int s; s=0;
+	s=s+f0(); s=s+f7(); s=s+f14(); s=s+f21(); s=s+f28(); s=s+f35(); s=s+f42(); s=s+f49(); s=s+f56(); s=s+f63(); s=s+f70(); s=s+f77(); s=s+f84(); s=s+f91(); s=s+f98();
+	puti(s); putc(10); }
@@ -0,0 +1,12 @@
+// the int and double members of the packed structs are at unaligned addresses: loads, stores, copies and vector sums
+struct P{char c;int a;double b;double v[5];int w[7];};
+struct P g;
+double sumv(struct P p){ int i; double s; s=0; i=0; while(i<5){ s=s+p.v[i]; i=i+1; } return s; }
+void main(){ struct P p; int i; int s;
+  p.c='x'; p.a=7; p.b=2.5; g.c='y'; g.a=p.a*2; g.b=p.b*2;
+  i=0; while(i<5){ p.v[i]=i*1.5; g.v[i]=p.v[i]; i=i+1; }
+  i=0; while(i<7){ p.w[i]=i*i; i=i+1; }
+  s=0; i=0; while(i<7){ s=s+p.w[i]; i=i+1; }
+  puti(p.a+g.a); putc(' '); putd(p.b+g.b); putc(' '); puti(s); putc(' '); putd(sumv(p)+sumv(g)); putc(10);
+  g=p; puti(g.a); putc(10);
+}
@@ -0,0 +1,12 @@
+// strcpy gets the size of its destination and stops the program if the source does not fit
+
+void main(){
+	char a[4];
+	char b[8];
+	strcpy(a,"abc",4);
+	puts(a);
+	strcpy(b,a,8);
+	puts(b);
+	strcpy(b,"abcdefgh",8);
+	puts(b);
+	}
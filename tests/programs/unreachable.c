@@ -0,0 +1,20 @@
+// the unreachable blocks are removed from the IR: a dead loop, whose blocks refer to each other, and dead branches
+int f(int n){
+	int a;
+	a=n;
+	if(0){
+		while(a<3){ a=a+1; if(a==2) break; }
+		}
+	while(0){ a=a*2; }
+	if(n>100){ return 1; } else { return a; }
+	return 7;
+	}
+void main(){
+	int a;
+	a=1;
+	if(0){ while(a<3){ a=a+1; } }
+	puti(a);
+	putc(' ');
+	puti(f(5)+f(200));
+	putc(10);
+	}
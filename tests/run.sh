@@ -0,0 +1,116 @@
+#!/bin/sh
+# runs the tests, from the repository's directory:
+#		tests/run.sh
+# the compiler is built in $TEST_DIR (default: /tmp/atomc-test), with the sanitizers from $TEST_CFLAGS
+# each test prints "ok" or "FAIL" and the script exits with 1 if any test failed
+out=${TEST_DIR:-/tmp/atomc-test}
+cc=${CC:-gcc}
+cflags=${TEST_CFLAGS:--O1 -g -fsanitize=address,undefined -fno-sanitize-recover=undefined}
+# the compiler frees its memory only as needed, so the leaks are not errors
+ASAN_OPTIONS=${ASAN_OPTIONS:-detect_leaks=0}
+export ASAN_OPTIONS
+mkdir -p "$out"
+$cc -std=c11 $cflags -pthread -o "$out/main" *.c -lm || exit 1
+failed=0
+
+# check NAME EXPECTED ACTUAL: compares two files
+check(){
+	if cmp -s "$2" "$3"; then
+		echo "ok	$1"
+	else
+		echo "FAIL	$1"
+		diff "$2" "$3" | head -20
+		failed=1
+	fi
+}
+
+# the tokens of tests/testlex.c, lexed and then read back from their token stream
+cp tests/testlex.c "$out/testlex.c"
+"$out/main" --tokens --save-tokens "$out/testlex.c" > "$out/tokens.txt"
+check "tokens of testlex.c" tests/lista-de-atomi.txt "$out/tokens.txt"
+"$out/main" --tokens "$out/testlex.tks" > "$out/tokens.txt"
+check "token stream of testlex.c" tests/lista-de-atomi.txt "$out/tokens.txt"
+for f in tests/testad.c tests/testat.c tests/testparser.c; do
+	name=$(basename "$f" .c)
+	cp "$f" "$out/$name.c"
+	"$out/main" --tokens --save-tokens "$out/$name.c" > "$out/tokens.txt"
+	"$out/main" --tokens "$out/$name.tks" > "$out/stream.txt"
+	check "token stream of $name.c" "$out/tokens.txt" "$out/stream.txt"
+done
+
+# a source longer than 16 MB (TK_MAX_POS): its tokens keep their lines instead of their offsets, and the errors have no column
+pad='// a line of the padding, so the source is longer than 16 MB: 64 bytes'
+awk -v pad="$pad" 'BEGIN{ for(i=0;i<300000;i++) print pad; print "void main(){ int a; a=2;"; print "puti(a*21); putc(10); }" }' > "$out/big.c"
+echo 42 > "$out/big.out"
+"$out/main" --quiet "$out/big.c" > "$out/big.txt" 2>&1
+check "source longer than 16 MB" "$out/big.out" "$out/big.txt"
+sed 's/a\*21/b/' "$out/big.c" > "$out/bigerr.c"
+echo "$out/bigerr.c: error in line 300002: Undefined id: b" > "$out/big.out"
+"$out/main" --quiet "$out/bigerr.c" > "$out/big.txt" 2>&1
+check "error in a source longer than 16 MB" "$out/big.out" "$out/big.txt"
+
+# the nesting of a million statements or expressions, which the parser and the optimizers handle in linear time
+# nest KIND N: a main whose body nests N times the statement or expression KIND, and which prints 1
+nest(){
+	case $1 in
+	paren) set -- "$2" 'x=' '(' '1' ')' ';';;
+	not) set -- "$2" 'x=' '!!' '1' '' ';';;
+	unary) set -- "$2" 'x=' '--' '1' '' ';';;
+	cast) set -- "$2" 'x=' '(int)' '1' '' ';';;
+	assign) set -- "$2" '' 'x=' '1' '' ';';;
+	block) set -- "$2" '' '{' 'x=1;' '}' '';;
+	if) set -- "$2" '' 'if(x==0)' 'x=1;' '' '';;
+	elif) set -- "$2" '' 'if(x)x=2; else ' 'x=1;' '' '';;
+	while) set -- "$2" '' 'while(x==0)' 'x=1;' '' '';;
+	esac
+	awk -v n="$1" -v pre="$2" -v open="$3" -v mid="$4" -v end="$5" -v post="$6" 'BEGIN{
+		printf "int x;\nvoid main(){%s",pre
+		for(i=0;i<n;i++)printf "%s",open
+		printf "%s",mid
+		for(i=0;i<n;i++)printf "%s",end
+		printf "%s\nputi(x);}\n",post
+		}'
+}
+# the time of a million must be less than 16 times that of 125000 (a quadratic pass would take 64 times)
+printf 1 > "$out/nest.out"
+for kind in paren not unary cast assign block if elif while; do
+	for n in 125000 1000000; do
+		nest $kind $n > "$out/nest.c"
+		start=$(date +%s%N)
+		"$out/main" --quiet "$out/nest.c" > "$out/nest.txt" 2>&1
+		ms=$(( ($(date +%s%N) - start) / 1000000 ))
+		check "$n nested $kind" "$out/nest.out" "$out/nest.txt"
+		[ $n = 125000 ] && small=$ms
+	done
+	if [ $ms -lt $((16 * small + 100)) ]; then
+		echo "ok	linear time of nested $kind (${small} ms, ${ms} ms)"
+	else
+		echo "FAIL	linear time of nested $kind (${small} ms, ${ms} ms)"
+		failed=1
+	fi
+done
+
+# geti reads the limits of int and stops the program at an integer which does not fit
+printf 'void main(){\n\twhile(1){ puti(geti()); putc(10); }\n\t}\n' > "$out/geti.c"
+printf '2147483647\n-2147483648\nerror: geti: the integer is out of range\n' > "$out/geti.out"
+echo "2147483647 -2147483648 2147483648" | "$out/main" --quiet "$out/geti.c" > "$out/geti.txt" 2>&1
+check "geti out of range" "$out/geti.out" "$out/geti.txt"
+
+# a program of two units: the lines of the second unit are numbered after those of the first one in the program's code,
+# and the errors of the running program show them as the lines of their unit
+printf 'int get(int k);\nvoid main(){\n\tputi(get(1));\n\tputc(10);\n\tputi(get(9));\n\t}\n' > "$out/unita.c"
+printf 'int v[4];\nint get(int k){\n\tv[1]=7;\n\treturn v[k];\n\t}\n' > "$out/unitb.c"
+echo "error: the index 9 is out of the bounds of an array with 4 elements ($out/unitb.c, line 4)" > "$out/units.out"
+"$out/main" --quiet --safe "$out/unita.c" "$out/unitb.c" 2> "$out/units.txt" > /dev/null
+check "lines of two units" "$out/units.out" "$out/units.txt"
+
+# the programs: the output of tests/programs/x.c must be tests/programs/x.out, also with the bounds checks (--safe)
+for f in tests/programs/*.c; do
+	name=$(basename "$f" .c)
+	"$out/main" --quiet "$f" > "$out/$name.txt" 2>&1
+	check "program $name" "tests/programs/$name.out" "$out/$name.txt"
+	"$out/main" --quiet --safe "$f" > "$out/$name.txt" 2>&1
+	check "program $name --safe" "tests/programs/$name.out" "$out/$name.txt"
+done
+
+exit $failed
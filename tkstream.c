@@ -0,0 +1,136 @@
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "tkstream.h"
+#include "utils.h"
+
+_Static_assert(sizeof(TkStreamHeader)==16,"TkStreamHeader must have 16 bytes");
+_Static_assert(sizeof(TkRecord)==16,"TkRecord must have 16 bytes");
+
+static bool hasText(int code){
+	return code==ID||code==STRING;
+	}
+
+void saveTokens(const Token *tokens,const char *fileName){
+	TkStreamHeader h;
+	memset(&h,0,sizeof(h));
+	memcpy(h.magic,TK_STREAM_MAGIC,4);
+	size_t textsSize=0;
+	for(const Token *tk=tokens;tk;tk=tk->next){
+		h.nTokens++;
+		if(hasText(tk->code))textsSize+=strlen(tkText(tk))+1;
+		}
+	if(textsSize>UINT32_MAX)err("too many texts for the tokens file %s",fileName);
+	h.textsSize=(uint32_t)textsSize;
+	FILE *fis=fopen(fileName,"wb");
+	if(!fis)err("unable to open %s",fileName);
+	setvbuf(fis,NULL,_IOFBF,1<<16);
+	fwrite(&h,sizeof(h),1,fis);
+	uint32_t offset=0;
+	for(const Token *tk=tokens;tk;tk=tk->next){
+		TkRecord r;
+		memset(&r,0,sizeof(r));
+		r.code=tk->code;
+		r.line=tkLine(tk);
+		switch(tk->code){
+			case ID:
+			case STRING:
+				r.text=offset;
+				offset+=(uint32_t)strlen(tkText(tk))+1;
+				break;
+			case INT:r.i=tk->i;break;
+			case CHAR:r.c=tk->c;break;
+			case DOUBLE:r.d=tkDouble(tk);break;
+			}
+		fwrite(&r,sizeof(r),1,fis);
+		}
+	for(const Token *tk=tokens;tk;tk=tk->next){
+		if(hasText(tk->code))fwrite(tkText(tk),1,strlen(tkText(tk))+1,fis);
+		}
+	if(ferror(fis))err("cannot write all the content of %s",fileName);
+	if(fclose(fis))err("cannot write all the content of %s",fileName);
+	}
+
+static void mapFile(TkStream *s,const char *fileName){
+#ifdef _WIN32
+	HANDLE file=CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,NULL);
+	if(file==INVALID_HANDLE_VALUE)err("unable to open %s",fileName);
+	LARGE_INTEGER size;
+	if(!GetFileSizeEx(file,&size))err("unable to get the size of %s",fileName);
+	s->memSize=(size_t)size.QuadPart;
+	HANDLE mapping=s->memSize?CreateFileMappingA(file,NULL,PAGE_READONLY,0,0,NULL):NULL;
+	CloseHandle(file);
+	if(!mapping)err("unable to map %s",fileName);
+	s->mem=MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+	CloseHandle(mapping);
+	if(!s->mem)err("unable to map %s",fileName);
+#else
+	int fd=open(fileName,O_RDONLY);
+	if(fd<0)err("unable to open %s",fileName);
+	struct stat st;
+	if(fstat(fd,&st))err("unable to get the size of %s",fileName);
+	s->memSize=(size_t)st.st_size;
+	s->mem=mmap(NULL,s->memSize,PROT_READ,MAP_PRIVATE,fd,0);
+	close(fd);
+	if(s->mem==MAP_FAILED)err("unable to map %s",fileName);
+#endif
+	}
+
+void openTkStream(TkStream *s,const char *fileName){
+	mapFile(s,fileName);
+	if(s->memSize<sizeof(TkStreamHeader))err("%s is not a tokens file",fileName);
+	const TkStreamHeader *h=(const TkStreamHeader*)s->mem;
+	if(memcmp(h->magic,TK_STREAM_MAGIC,4))err("%s is not a tokens file",fileName);
+	s->nTokens=h->nTokens;
+	s->textsSize=h->textsSize;
+	if((s->memSize-sizeof(TkStreamHeader))/sizeof(TkRecord)<s->nTokens)err("%s is truncated",fileName);
+	s->records=(const TkRecord*)(h+1);
+	s->texts=(const char*)(s->records+s->nTokens);
+	if(s->memSize-sizeof(TkStreamHeader)-(size_t)s->nTokens*sizeof(TkRecord)<s->textsSize)err("%s is truncated",fileName);
+	if(s->textsSize&&s->texts[s->textsSize-1])err("%s has invalid texts",fileName);
+	// after these checks the records can be used without any other verification
+	for(uint32_t i=0;i<s->nTokens;i++){
+		const TkRecord *r=&s->records[i];
+		if(!tkName(r->code))err("%s: invalid token code %d",fileName,r->code);
+		if(hasText(r->code)&&r->text>=s->textsSize)err("%s: invalid text offset in token %u",fileName,i);
+		}
+	}
+
+void closeTkStream(TkStream *s){
+#ifdef _WIN32
+	UnmapViewOfFile(s->mem);
+#else
+	munmap(s->mem,s->memSize);
+#endif
+	memset(s,0,sizeof(*s));
+	}
+
+const char *tkRecordText(const TkStream *s,const TkRecord *r){
+	return s->texts+r->text;
+	}
+
+void showTkStream(const TkStream *s){
+	for(uint32_t i=0;i<s->nTokens;i++){
+		const TkRecord *r=&s->records[i];
+		printf("%d\t%s",r->line,tkName(r->code));
+		switch(r->code){
+			case ID:
+			case STRING:
+				printf(":%s",tkRecordText(s,r));
+				break;
+			case INT:printf(":%d",r->i);break;
+			case DOUBLE:printf(":%.2f",r->d);break;
+			case CHAR:printf(":%c",r->c);break;
+			}
+		putchar('\n');
+		}
+	fflush(stdout);
+	}
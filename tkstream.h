@@ -0,0 +1,60 @@
+#pragma once
+
+// binary token streams
+// a token list can be saved in a file and later used by other tools without lexing the source again
+// the file is made only from fixed size, aligned records, so it can be used directly from a memory mapping:
+//		TkStreamHeader
+//		TkRecord[nTokens]
+//		texts: the NUL terminated texts of the ID and STRING tokens, referred by TkRecord.text
+// all the numbers are in the byte order of the machine which wrote the file
+
+#include <stdint.h>
+#include <stddef.h>
+#include "lexer.h"
+
+#define TK_STREAM_MAGIC "TKS1"
+// the token stream of the source x.c is x.tks (see main --tokens)
+#define TK_STREAM_EXT ".tks"
+
+typedef struct{
+	char magic[4];		// TK_STREAM_MAGIC
+	uint32_t nTokens;
+	uint32_t textsSize;		// the size in bytes of the texts area
+	uint32_t reserved;		// 0
+	}TkStreamHeader;
+
+typedef struct{
+	int32_t code;		// ID, TYPE_CHAR, ... (the codes from lexer.h)
+	int32_t line;
+	union{
+		uint32_t text;		// for ID, STRING: the offset of the text in the texts area
+		int32_t i;		// the value for INT
+		char c;		// the value for CHAR
+		double d;		// the value for DOUBLE
+		};
+	}TkRecord;
+
+typedef struct{
+	const TkRecord *records;
+	uint32_t nTokens;
+	const char *texts;
+	uint32_t textsSize;
+	// the mapped file
+	void *mem;
+	size_t memSize;
+	}TkStream;
+
+// saves the tokens in the binary format
+// on error, prints a message and exit the program
+void saveTokens(const Token *tokens,const char *fileName);
+
+// maps in memory a file written by saveTokens and validates it
+// on error, prints a message and exit the program
+void openTkStream(TkStream *s,const char *fileName);
+// unmaps the file
+void closeTkStream(TkStream *s);
+
+// returns the text of an ID or STRING record
+const char *tkRecordText(const TkStream *s,const TkRecord *r);
+// prints the records in the same format as showTokens
+void showTkStream(const TkStream *s);
@@ -0,0 +1,413 @@
+// lexgen: generates the DFA of the lexer (lexdfa.h) from the token rules below
+// after the rules are changed, build and run it from the repository's directory:
+//		gcc -std=c11 -o lexgen tools/lexgen.c && ./lexgen > lexdfa.h
+//
+// the regular expression of each rule is compiled to an NFA (Thompson's construction),
+// the NFAs are joined and converted to a DFA (subset construction) and the DFA is minimized (Moore's partition refinement)
+// the bytes which have the same transitions in all the states are merged in classes, so the transitions table is small and dense
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdarg.h>
+#include <stdnoreturn.h>
+
+typedef struct{
+	const char *action;		// a token code from lexer.h, or a LEX_* pseudo-code from lexer.c
+	const char *regex;		// the operators are: | * + ? ( ) [...] [^...] and \ for escapes
+	}Rule;
+
+// when several rules match the longest text, the first one wins
+// the byte 0 ends the text, so no rule matches it
+// the errors are rules too: they match a longer text than the valid tokens which they prefix (ex: "1." and "1")
+static const Rule rules[]={
+	{"LEX_SKIP","[ \t\r\n]+"},
+	{"LEX_SKIP","//[^\n]*"},
+	{"TYPE_CHAR","char"},
+	{"TYPE_INT","int"},
+	{"TYPE_DOUBLE","double"},
+	{"STRUCT","struct"},
+	{"VOID","void"},
+	{"WHILE","while"},
+	{"IF","if"},
+	{"ELSE","else"},
+	{"FOR","for"},
+	{"BREAK","break"},
+	{"RETURN","return"},
+	{"ID","[A-Za-z_][A-Za-z0-9_]*"},
+	{"INT","[0-9]+"},
+	{"DOUBLE","[0-9]+(\\.[0-9]+([eE][+-]?[0-9]+)?|[eE][+-]?[0-9]+)"},
+	{"LEX_ERR_FRACTION","[0-9]+\\."},
+	{"LEX_ERR_DOTS","[0-9]+\\.[0-9]+\\."},
+	{"LEX_ERR_EXPONENT","[0-9]+(\\.[0-9]+)?[eE]"},
+	{"LEX_ERR_EXPONENT_SIGN","[0-9]+(\\.[0-9]+)?[eE][+-]"},
+	{"LEX_ERR_EXPONENTS","[0-9]+(\\.[0-9]+)?[eE][+-]?[0-9]+[eE]"},
+	{"CHAR","'[^']'"},
+	{"LEX_ERR_CHAR_EMPTY","''"},
+	{"LEX_ERR_CHAR_END","'[^']?"},
+	{"STRING","\"[^\"]*\""},
+	{"LEX_ERR_STRING_END","\"[^\"]*"},
+	{"COMMA",","},
+	{"SEMICOLON",";"},
+	{"LPAR","\\("},
+	{"RPAR","\\)"},
+	{"LACC","{"},
+	{"RACC","}"},
+	{"LBRACKET","\\["},
+	{"RBRACKET","\\]"},
+	{"DOT","\\."},
+	{"ADD","\\+"},
+	{"SUB","-"},
+	{"MUL","\\*"},
+	{"DIV","/"},
+	{"NOT","!"},
+	{"NOTEQ","!="},
+	{"ASSIGN","="},
+	{"EQUAL","=="},
+	{"LESS","<"},
+	{"LESSEQ","<="},
+	{"GREATER",">"},
+	{"GREATEREQ",">="},
+	{"AND","&&"},
+	{"OR","\\|\\|"},
+	{"LEX_ERR_SYMBOL","[&|]"},
+	};
+#define N_RULES ((int)(sizeof(rules)/sizeof(rules[0])))
+
+static noreturn void fail(const char *fmt,...){
+	va_list va;
+	va_start(va,fmt);
+	fprintf(stderr,"lexgen: ");
+	vfprintf(stderr,fmt,va);
+	fprintf(stderr,"\n");
+	va_end(va);
+	exit(EXIT_FAILURE);
+	}
+
+// the NFA
+// a state has either a transition on a set of bytes, or up to two epsilon transitions
+#define MAX_NFA 2048
+
+typedef struct{
+	bool bytes[256];
+	bool hasBytes;
+	int next;		// the target of the bytes transition
+	int eps[2];
+	int nEps;
+	int rule;		// the rule which is matched in this state, or -1
+	}NfaState;
+
+static NfaState nfa[MAX_NFA];
+static int nNfa;
+
+static int newNfaState(){
+	if(nNfa==MAX_NFA)fail("too many NFA states");
+	NfaState *s=&nfa[nNfa];
+	memset(s,0,sizeof(*s));
+	s->rule=-1;
+	return nNfa++;
+	}
+
+static void addEps(int from,int to){
+	if(nfa[from].nEps==2)fail("internal error: too many epsilon transitions");
+	nfa[from].eps[nfa[from].nEps++]=to;
+	}
+
+// a part of the NFA, with one start and one end state
+// the end state has no transitions yet
+typedef struct{
+	int start,end;
+	}Frag;
+
+static const char *re;		// the current position in the parsed regex
+static const Rule *rule;
+
+static Frag parseAlt();
+
+static int parseEscape(){
+	char c=*re++;
+	switch(c){
+		case 'n':return '\n';
+		case 't':return '\t';
+		case 'r':return '\r';
+		case '\0':fail("%s: the regex ends with \\",rule->action);
+		default:return (unsigned char)c;
+		}
+	}
+
+static Frag bytesFrag(const bool *bytes){
+	Frag f={newNfaState(),newNfaState()};
+	memcpy(nfa[f.start].bytes,bytes,sizeof(nfa[f.start].bytes));
+	nfa[f.start].bytes[0]=false;		// the end of the text
+	nfa[f.start].hasBytes=true;
+	nfa[f.start].next=f.end;
+	return f;
+	}
+
+static Frag parseClass(){
+	bool bytes[256]={false};
+	bool negated=*re=='^';
+	if(negated)re++;
+	while(*re!=']'){
+		if(!*re)fail("%s: missing ]",rule->action);
+		int first=*re=='\\'?(re++,parseEscape()):(unsigned char)*re++;
+		int last=first;
+		if(*re=='-'&&re[1]!=']'){
+			re++;
+			last=*re=='\\'?(re++,parseEscape()):(unsigned char)*re++;
+			}
+		for(int c=first;c<=last;c++)bytes[c]=true;
+		}
+	re++;
+	if(negated){
+		for(int c=0;c<256;c++)bytes[c]=!bytes[c];
+		}
+	return bytesFrag(bytes);
+	}
+
+static Frag parseAtom(){
+	bool bytes[256]={false};
+	char c=*re++;
+	switch(c){
+		case '(':{
+			Frag f=parseAlt();
+			if(*re++!=')')fail("%s: missing )",rule->action);
+			return f;
+			}
+		case '[':return parseClass();
+		case '\\':bytes[parseEscape()]=true;break;
+		default:bytes[(unsigned char)c]=true;break;
+		}
+	return bytesFrag(bytes);
+	}
+
+static Frag parseRepeat(){
+	Frag f=parseAtom();
+	while(*re=='*'||*re=='+'||*re=='?'){
+		char op=*re++;
+		Frag r={newNfaState(),newNfaState()};
+		addEps(r.start,f.start);
+		addEps(f.end,r.end);
+		if(op!='+')addEps(r.start,r.end);
+		if(op!='?')addEps(f.end,f.start);
+		f=r;
+		}
+	return f;
+	}
+
+static Frag parseConcat(){
+	Frag f={newNfaState(),-1};
+	f.end=f.start;
+	while(*re&&*re!='|'&&*re!=')'){
+		Frag next=parseRepeat();
+		addEps(f.end,next.start);
+		f.end=next.end;
+		}
+	return f;
+	}
+
+static Frag parseAlt(){
+	Frag f=parseConcat();
+	while(*re=='|'){
+		re++;
+		Frag other=parseConcat();
+		Frag a={newNfaState(),newNfaState()};
+		addEps(a.start,f.start);
+		addEps(a.start,other.start);
+		addEps(f.end,a.end);
+		addEps(other.end,a.end);
+		f=a;
+		}
+	return f;
+	}
+
+// the NFA of all the rules, whose start state has epsilon transitions to the rules
+static int buildNfa(){
+	int start=newNfaState(),last=start;
+	for(int i=0;i<N_RULES;i++){
+		rule=&rules[i];
+		re=rule->regex;
+		Frag f=parseAlt();
+		if(*re)fail("%s: unexpected %c",rule->action,*re);
+		nfa[f.end].rule=i;
+		// a chain of epsilon states, because a state has at most two epsilon transitions
+		int link=newNfaState();
+		addEps(last,link);
+		addEps(link,f.start);
+		last=link;
+		}
+	return start;
+	}
+
+// the DFA: each of its states is a set of NFA states
+#define MAX_DFA 1024
+#define SET_WORDS (MAX_NFA/64)
+
+typedef struct{
+	uint64_t w[SET_WORDS];
+	}NfaSet;
+
+static NfaSet dfaSets[MAX_DFA];
+static int dfaNext[MAX_DFA][256];
+static int dfaRule[MAX_DFA];		// the first rule which is matched in the state, or -1
+static int nDfa;
+
+static bool inSet(const NfaSet *s,int i){return (s->w[i/64]>>(i%64))&1;}
+static void addToSet(NfaSet *s,int i){s->w[i/64]|=(uint64_t)1<<(i%64);}
+
+static void closure(NfaSet *s){
+	int stack[MAX_NFA],n=0;
+	for(int i=0;i<nNfa;i++)if(inSet(s,i))stack[n++]=i;
+	while(n){
+		NfaState *st=&nfa[stack[--n]];
+		for(int k=0;k<st->nEps;k++){
+			if(!inSet(s,st->eps[k])){
+				addToSet(s,st->eps[k]);
+				stack[n++]=st->eps[k];
+				}
+			}
+		}
+	}
+
+// returns the DFA state of the set, which is added if it is new
+static int dfaState(const NfaSet *s){
+	for(int i=0;i<nDfa;i++){
+		if(!memcmp(&dfaSets[i],s,sizeof(NfaSet)))return i;
+		}
+	if(nDfa==MAX_DFA)fail("too many DFA states");
+	dfaSets[nDfa]=*s;
+	dfaRule[nDfa]=-1;
+	for(int i=0;i<nNfa;i++){
+		if(inSet(s,i)&&nfa[i].rule>=0&&(dfaRule[nDfa]<0||nfa[i].rule<dfaRule[nDfa]))dfaRule[nDfa]=nfa[i].rule;
+		}
+	return nDfa++;
+	}
+
+// state 0 is the dead state (the empty set) and state 1 is the start state
+static void buildDfa(int nfaStart){
+	NfaSet s;
+	memset(&s,0,sizeof(s));
+	dfaState(&s);
+	addToSet(&s,nfaStart);
+	closure(&s);
+	dfaState(&s);
+	for(int i=0;i<nDfa;i++){
+		for(int c=0;c<256;c++){
+			memset(&s,0,sizeof(s));
+			for(int k=0;k<nNfa;k++){
+				if(inSet(&dfaSets[i],k)&&nfa[k].hasBytes&&nfa[k].bytes[c])addToSet(&s,nfa[k].next);
+				}
+			closure(&s);
+			dfaNext[i][c]=dfaState(&s);
+			}
+		}
+	}
+
+// the minimized DFA
+static int block[MAX_DFA];		// the block of each DFA state
+static int nBlocks;
+
+static bool sameAction(int r1,int r2){
+	if(r1<0||r2<0)return r1==r2;
+	return !strcmp(rules[r1].action,rules[r2].action);
+	}
+
+// Moore's algorithm: the states start in blocks by their action and the blocks are split
+// by the blocks of their transitions, until no block is split
+// the blocks are numbered in the order of their first state, so the dead state stays 0 and the start state 1
+static void minimize(){
+	nBlocks=0;
+	for(int i=0;i<nDfa;i++){
+		block[i]=-1;
+		for(int j=0;j<i;j++){
+			if(sameAction(dfaRule[i],dfaRule[j])){block[i]=block[j];break;}
+			}
+		if(block[i]<0)block[i]=nBlocks++;
+		}
+	static int newBlock[MAX_DFA];
+	for(;;){
+		int n=0;
+		for(int i=0;i<nDfa;i++){
+			newBlock[i]=-1;
+			for(int j=0;j<i;j++){
+				if(block[i]!=block[j])continue;
+				bool same=true;
+				for(int c=0;c<256&&same;c++)same=block[dfaNext[i][c]]==block[dfaNext[j][c]];
+				if(same){newBlock[i]=newBlock[j];break;}
+				}
+			if(newBlock[i]<0)newBlock[i]=n++;
+			}
+		bool changed=n!=nBlocks;
+		memcpy(block,newBlock,nDfa*sizeof(int));
+		nBlocks=n;
+		if(!changed)break;
+		}
+	}
+
+// the byte classes: the bytes which go to the same blocks from all the blocks
+// class 0 has the byte 0, which goes to the dead state from all the states
+static int byteClass[256];
+static int classByte[256];		// a byte of each class
+static int nClasses;
+
+static void computeClasses(){
+	nClasses=0;
+	for(int c=0;c<256;c++){
+		byteClass[c]=-1;
+		for(int k=0;k<nClasses&&byteClass[c]<0;k++){
+			bool same=true;
+			for(int i=0;i<nDfa&&same;i++)same=block[dfaNext[i][c]]==block[dfaNext[i][classByte[k]]];
+			if(same)byteClass[c]=k;
+			}
+		if(byteClass[c]<0){
+			classByte[nClasses]=c;
+			byteClass[c]=nClasses++;
+			}
+		}
+	}
+
+static void printTable(const char *type,const char *name,const char *size,const int *values,int n,int perLine){
+	printf("static const %s %s[%s]={",type,name,size);
+	for(int i=0;i<n;i++){
+		if(i%perLine==0)printf("\n\t");
+		printf("%d,",values[i]);
+		}
+	printf("\n\t};\n\n");
+	}
+
+static void emit(){
+	// a state of each block
+	static int blockState[MAX_DFA];
+	for(int i=nDfa-1;i>=0;i--)blockState[block[i]]=i;
+	printf("// generated by tools/lexgen.c from its rules: do not edit\n");
+	printf("// %d rules, %d NFA states, %d DFA states, %d states after minimization, %d byte classes\n\n",N_RULES,nNfa,nDfa,nBlocks,nClasses);
+	printf("#define DFA_STATES %d\n",nBlocks);
+	printf("#define DFA_CLASSES %d\n",nClasses);
+	printf("#define DFA_START 1		// state 0 is the dead state, from which the text cannot continue a token\n\n");
+	printf("// the class of each byte\n");
+	printTable("uint8_t","dfaClass","256",byteClass,256,32);
+	static int next[MAX_DFA*256];
+	for(int b=0;b<nBlocks;b++){
+		for(int k=0;k<nClasses;k++)next[b*nClasses+k]=block[dfaNext[blockState[b]][classByte[k]]];
+		}
+	printf("// dfaNext[state*DFA_CLASSES+class] - the next state\n");
+	printTable(nBlocks<=256?"uint8_t":"uint16_t","dfaNext","DFA_STATES*DFA_CLASSES",next,nBlocks*nClasses,nClasses);
+	printf("// dfaAccept[state] - the code of the token which ends in the state, or -1 if the state does not end a token\n");
+	printf("static const int8_t dfaAccept[DFA_STATES]={");
+	for(int b=0;b<nBlocks;b++){
+		if(b%8==0)printf("\n\t");
+		int r=dfaRule[blockState[b]];
+		printf("%s,",r<0?"-1":rules[r].action);
+		}
+	printf("\n\t};\n");
+	}
+
+int main(){
+	buildDfa(buildNfa());
+	minimize();
+	computeClasses();
+	emit();
+	return 0;
+	}
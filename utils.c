@@ -4,22 +4,112 @@
 
 #include "utils.h"
 
-void err(const char *fmt,...){
-	fprintf(stderr,"error: ");
-	va_list va;
-	va_start(va,fmt);
+_Thread_local jmp_buf *errTrap;
+_Thread_local char errMsg[ERR_MSG_SIZE];
+_Thread_local int errLine;
+_Thread_local int errColumn;
+_Thread_local const char *errFile;
+void (*errFlush)(void);
+
+void verr(int line,int column,const char *fmt,va_list va){
+	if(errTrap){
+		vsnprintf(errMsg,ERR_MSG_SIZE,fmt,va);
+		errLine=line;
+		errColumn=column;
+		longjmp(*errTrap,1);
+		}
+	if(errFlush)errFlush();
+	if(errFile)fprintf(stderr,"%s: ",errFile);
+	if(line&&column)fprintf(stderr,"error in line %d, column %d: ",line,column);
+	else if(line)fprintf(stderr,"error in line %d: ",line);
+	else fprintf(stderr,"error: ");
 	vfprintf(stderr,fmt,va);
-	va_end(va);
 	fprintf(stderr,"\n");
 	exit(EXIT_FAILURE);
 	}
 
+void err(const char *fmt,...){
+	va_list va;
+	va_start(va,fmt);
+	verr(0,0,fmt,va);
+	}
+
+void errAt(int line,int column,const char *fmt,...){
+	va_list va;
+	va_start(va,fmt);
+	verr(line,column,fmt,va);
+	}
+
 void *safeAlloc(size_t nBytes){
 	void *p=malloc(nBytes);
 	if(!p)err("not enough memory");
 	return p;
 	}
 
+struct ArenaChunk{
+	ArenaChunk *next;
+	size_t size;		// the size of data in bytes
+	max_align_t data[];
+	};
+
+static ArenaChunk *newChunk(size_t size){
+	ArenaChunk *c=(ArenaChunk*)safeAlloc(sizeof(ArenaChunk)+size);
+	c->size=size;
+	return c;
+	}
+
+void *arenaAlloc(Arena *a,size_t n){
+	n=(n+sizeof(max_align_t)-1)/sizeof(max_align_t)*sizeof(max_align_t);
+	if((size_t)(a->end-a->p)>=n){
+		void *obj=a->p;
+		a->p+=n;
+		return obj;
+		}
+	if(n>ARENA_CHUNK_SIZE/4&&a->chunks){
+		// a large object gets its own chunk, placed after the current one, so the current one is still used
+		ArenaChunk *c=newChunk(n);
+		c->next=a->chunks->next;
+		a->chunks->next=c;
+		return c->data;
+		}
+	// the chunks start small and double up to ARENA_CHUNK_SIZE, because many arenas hold only a few objects
+	size_t size=ARENA_FIRST_CHUNK;
+	if(a->chunks)size=a->chunks->size<ARENA_CHUNK_SIZE?a->chunks->size*2:ARENA_CHUNK_SIZE;
+	while(size<n)size*=2;
+	ArenaChunk *c=newChunk(size);
+	c->next=a->chunks;
+	a->chunks=c;
+	a->p=(char*)c->data+n;
+	a->end=(char*)c->data+c->size;
+	return c->data;
+	}
+
+void arenaReset(Arena *a){
+	ArenaChunk *keep=a->chunks;
+	if(keep&&keep->size>ARENA_CHUNK_SIZE)keep=NULL;
+	for(ArenaChunk *c=a->chunks,*next;c;c=next){
+		next=c->next;
+		if(c!=keep)free(c);
+		}
+	a->chunks=keep;
+	if(keep){
+		keep->next=NULL;
+		a->p=(char*)keep->data;
+		a->end=a->p+keep->size;
+		}else{
+		a->p=a->end=NULL;
+		}
+	}
+
+void arenaFree(Arena *a){
+	for(ArenaChunk *c=a->chunks,*next;c;c=next){
+		next=c->next;
+		free(c);
+		}
+	a->chunks=NULL;
+	a->p=a->end=NULL;
+	}
+
 char *loadFile(const char *fileName){
 	FILE *fis=fopen(fileName,"rb");
 	if(!fis)err("unable to open %s",fileName);
@@ -3,16 +3,53 @@
 #pragma once
 
 #include <stddef.h>
+#include <stdarg.h>
+#include <setjmp.h>
 #include <stdnoreturn.h>
 
 // prints to stderr a message prefixed with "error: " and exit the program
 // the arguments are the same as for printf
 noreturn void err(const char *fmt,...);
+// the same as err, but for an error at the given line and column of the source (0 if they are not known)
+noreturn void verr(int line,int column,const char *fmt,va_list va);
+noreturn void errAt(int line,int column,const char *fmt,...);
+
+// the errors can be recovered instead of exiting the program (ex: in the language server)
+// if errTrap is set, an error puts its message in errMsg and its position in errLine and errColumn, and then it jumps to *errTrap
+#define ERR_MSG_SIZE 256
+extern _Thread_local jmp_buf *errTrap;
+extern _Thread_local char errMsg[ERR_MSG_SIZE];
+extern _Thread_local int errLine;
+extern _Thread_local int errColumn;
+// the source file of the errors, if it is set (the linker compiles each unit with its file)
+extern _Thread_local const char *errFile;
+// if it is set, it is called before an error is written (the runtime library writes there the output of the program,
+// so the error comes after it)
+extern void (*errFlush)(void);
 
 // allocs memory using malloc
 // if succeeds, it returns the allocated memory, else it prints an error message and exit the program
 void *safeAlloc(size_t nBytes);
 
+// an arena: many small objects are allocated from it by bumping a pointer, and they are all released at once
+typedef struct ArenaChunk ArenaChunk;
+typedef struct{
+	ArenaChunk *chunks;		// the current chunk is the first one
+	char *p;		// the free space of the current chunk
+	char *end;
+	}Arena;
+
+#define ARENA_FIRST_CHUNK 256		// the size of the first chunk of an arena
+#define ARENA_CHUNK_SIZE 4096		// the maximum size of the usual chunks; the larger objects get their own chunks
+
+// allocates n bytes from the arena, aligned for any object
+// if the memory is not enough, it prints an error message and exit the program
+void *arenaAlloc(Arena *a,size_t n);
+// releases all the objects from the arena, but keeps a chunk for the next allocations
+void arenaReset(Arena *a);
+// releases all the memory of the arena
+void arenaFree(Arena *a);
+
 // loads a text file in a dynamically allocated memory and returns it
 // on error, prints a message and exit the program
 char *loadFile(const char *fileName);
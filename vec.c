@@ -0,0 +1,81 @@
+#include <string.h>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "vec.h"
+
+static inline int loadInt(const char *p){
+	int v;
+	memcpy(&v,p,sizeof(v));
+	return v;
+	}
+
+static inline double loadDouble(const char *p){
+	double v;
+	memcpy(&v,p,sizeof(v));
+	return v;
+	}
+
+int vecSumI(const char *x,int n,int r){
+	unsigned s=(unsigned)r;
+	int k=0;
+#if defined(__AVX2__)
+	__m256i acc=_mm256_setzero_si256();
+	for(;k+8<=n;k+=8)acc=_mm256_add_epi32(acc,_mm256_loadu_si256((const __m256i*)(x+k*sizeof(int))));
+	unsigned lanes[8];
+	_mm256_storeu_si256((__m256i*)lanes,acc);
+	for(int j=0;j<8;j++)s+=lanes[j];
+#elif defined(__SSE2__)
+	__m128i acc=_mm_setzero_si128();
+	for(;k+4<=n;k+=4)acc=_mm_add_epi32(acc,_mm_loadu_si128((const __m128i*)(x+k*sizeof(int))));
+	unsigned lanes[4];
+	_mm_storeu_si128((__m128i*)lanes,acc);
+	for(int j=0;j<4;j++)s+=lanes[j];
+#endif
+	for(;k<n;k++)s+=(unsigned)loadInt(x+k*sizeof(int));
+	return (int)s;
+	}
+
+double vecSumF(const char *x,int n,double r,bool reassociate){
+	int k=0;
+	if(reassociate){
+#if defined(__AVX2__)
+		__m256d acc=_mm256_setzero_pd();
+		for(;k+4<=n;k+=4)acc=_mm256_add_pd(acc,_mm256_loadu_pd((const double*)(x+k*sizeof(double))));
+		double lanes[4];
+		_mm256_storeu_pd(lanes,acc);
+		r+=(lanes[0]+lanes[1])+(lanes[2]+lanes[3]);
+#elif defined(__SSE2__)
+		__m128d acc0=_mm_setzero_pd(),acc1=_mm_setzero_pd();
+		for(;k+4<=n;k+=4){
+			acc0=_mm_add_pd(acc0,_mm_loadu_pd((const double*)(x+k*sizeof(double))));
+			acc1=_mm_add_pd(acc1,_mm_loadu_pd((const double*)(x+(k+2)*sizeof(double))));
+			}
+		double lanes[2];
+		_mm_storeu_pd(lanes,_mm_add_pd(acc0,acc1));
+		r+=lanes[0]+lanes[1];
+#else
+		double acc[4]={0,0,0,0};
+		for(;k+4<=n;k+=4){
+			for(int j=0;j<4;j++)acc[j]+=loadDouble(x+(k+j)*sizeof(double));
+			}
+		r+=(acc[0]+acc[1])+(acc[2]+acc[3]);
+#endif
+		}
+	for(;k<n;k++)r+=loadDouble(x+k*sizeof(double));
+	return r;
+	}
+
+void vecCopy(char *dst,const char *src,int n,int size){
+	if(n<=0)return;
+	size_t len=(size_t)n*size;
+	// copying forward, an element is read before it is overwritten, except when dst is after src, inside it
+	if(dst<=src||dst>=src+len){
+		memmove(dst,src,len);
+		return;
+		}
+	for(int k=0;k<n;k++)memmove(dst+(size_t)k*size,src+(size_t)k*size,size);
+	}
@@ -0,0 +1,17 @@
+#pragma once
+
+// the vector kernels of the VM, which run the loops recognized by the IR vectorizer (OP_VSUM_I, OP_VSUM_F, OP_VCOPY)
+// they use SSE2 or AVX2 when the compiler targets them, with a scalar loop for the remaining elements
+
+#include <stdbool.h>
+
+// the arrays can be members of packed structs, so they can be at any address
+
+// r+x[0]+...+x[n-1], with the wrap-around of the int additions, for an array of ints
+int vecSumI(const char *x,int n,int r);
+// r+x[0]+...+x[n-1], for an array of doubles
+// if reassociate is false, the additions are done in order, so the result is the same as the scalar loop's
+double vecSumF(const char *x,int n,double r,bool reassociate);
+// dst[k]=src[k] for k from 0 to n-1, in this order, for elements of size bytes
+// the result is the same as the scalar loop's, even if dst and src overlap
+void vecCopy(char *dst,const char *src,int n,int size);
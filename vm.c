@@ -0,0 +1,608 @@
+#ifndef _WIN32
+#define _DEFAULT_SOURCE		// for MAP_ANONYMOUS and MAP_NORESERVE
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <threads.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "vm.h"
+#include "ad.h"
+#include "utils.h"
+#include "rt.h"
+#include "vec.h"
+#include "prof.h"
+
+static void lineNumber(int line,char *buf,size_t size){
+	snprintf(buf,size,"line %d",line);
+	}
+
+void (*vmLineName)(int line,char *buf,size_t size)=lineNumber;
+
+Instr *newInstr(Opcode op){
+	Instr *i=(Instr*)safeAlloc(sizeof(Instr));
+	memset(i,0,sizeof(Instr));
+	i->op=op;
+	return i;
+	}
+
+Instr *addInstr(Instr **list,Opcode op){
+	Instr *i=newInstr(op);
+	Instr *iter=*list;
+	if(iter){
+		while(iter->next)iter=iter->next;
+		iter->next=i;
+		}else{
+		*list=i;
+		}
+	return i;
+	}
+
+Instr *addInstrWithInt(Instr **list,Opcode op,int argVal){
+	Instr *i=addInstr(list,op);
+	i->arg.i=argVal;
+	return i;
+	}
+
+Instr *addInstrWithDouble(Instr **list,Opcode op,double argVal){
+	Instr *i=addInstr(list,op);
+	i->arg.f=argVal;
+	return i;
+	}
+
+Instr *addInstrWithPtr(Instr **list,Opcode op,void *argVal){
+	Instr *i=addInstr(list,op);
+	i->arg.p=argVal;
+	return i;
+	}
+
+Instr *insertInstr(Instr *after,Opcode op){
+	Instr *i=newInstr(op);
+	i->line=after->line;
+	i->next=after->next;
+	after->next=i;
+	return i;
+	}
+
+void delInstrAfter(Instr *instr){
+	freeInstrs(instr->next);
+	instr->next=NULL;
+	}
+
+void freeInstrs(Instr *list){
+	for(Instr *next;list;list=next){
+		next=list->next;
+		free(list);
+		}
+	}
+
+int instrsLen(Instr *list){
+	int n=0;
+	for(;list;list=list->next)n++;
+	return n;
+	}
+
+static unsigned instrHash(Instr *instr){
+	size_t h=(size_t)instr;
+	h^=h>>17;
+	h*=0x9E3779B1u;
+	return (unsigned)(h^(h>>15));
+	}
+
+void initInstrIndex(InstrIndex *index,Instr *list){
+	index->n=instrsLen(list);
+	index->instrs=(Instr**)safeAlloc((index->n+1)*sizeof(Instr*));
+	for(index->cap=16;index->cap<index->n*2;index->cap*=2){}
+	index->keys=(Instr**)safeAlloc(index->cap*sizeof(Instr*));
+	index->pos=(int*)safeAlloc(index->cap*sizeof(int));
+	memset(index->keys,0,index->cap*sizeof(Instr*));
+	int k=0;
+	for(Instr *i=list;i;i=i->next,k++){
+		index->instrs[k]=i;
+		unsigned h=instrHash(i)&(index->cap-1);
+		while(index->keys[h])h=(h+1)&(index->cap-1);
+		index->keys[h]=i;
+		index->pos[h]=k;
+		}
+	}
+
+int instrIndex(InstrIndex *index,Instr *instr){
+	for(unsigned h=instrHash(instr)&(index->cap-1);index->keys[h];h=(h+1)&(index->cap-1)){
+		if(index->keys[h]==instr)return index->pos[h];
+		}
+	err("instrIndex: the instruction is not in the list");
+	}
+
+void freeInstrIndex(InstrIndex *index){
+	free(index->instrs);
+	free(index->keys);
+	free(index->pos);
+	}
+
+// the int arithmetic wraps around in two's complement, as vecSumI: it is done in unsigned, which cannot overflow
+static inline int wrapAdd(int a,int b){return (int)((unsigned)a+(unsigned)b);}
+static inline int wrapSub(int a,int b){return (int)((unsigned)a-(unsigned)b);}
+static inline int wrapMul(int a,int b){return (int)((unsigned)a*(unsigned)b);}
+static inline int wrapNeg(int a){return (int)(0u-(unsigned)a);}
+// b must not be 0; INT_MIN/-1 gives INT_MIN, instead of the host's overflow trap
+static inline int wrapDiv(int a,int b){return b==-1?wrapNeg(a):a/b;}
+
+Opcode vmEval(Opcode op,const Val *args,Val *result){
+	int a=args[0].i,b=0;
+	double x=args[0].f,y=0;
+	if(op>=OP_ADD_I&&op<=OP_NOTEQ_F){
+		b=args[1].i;
+		y=args[1].f;
+		}
+	switch(op){
+		case OP_CONV_I_F:result->f=a;return OP_PUSH_F;
+		case OP_CONV_F_I:result->i=(int)x;return OP_PUSH_I;
+		case OP_CONV_I_C:result->i=(char)a;return OP_PUSH_I;
+		case OP_ADD_I:result->i=wrapAdd(a,b);return OP_PUSH_I;
+		case OP_ADD_F:result->f=x+y;return OP_PUSH_F;
+		case OP_SUB_I:result->i=wrapSub(a,b);return OP_PUSH_I;
+		case OP_SUB_F:result->f=x-y;return OP_PUSH_F;
+		case OP_MUL_I:result->i=wrapMul(a,b);return OP_PUSH_I;
+		case OP_MUL_F:result->f=x*y;return OP_PUSH_F;
+		case OP_DIV_I:
+			if(!b)return OP_NOP;		// it must give the runtime error
+			result->i=wrapDiv(a,b);return OP_PUSH_I;
+		case OP_DIV_F:result->f=x/y;return OP_PUSH_F;
+		case OP_LESS_I:result->i=a<b;return OP_PUSH_I;
+		case OP_LESS_F:result->i=x<y;return OP_PUSH_I;
+		case OP_LESSEQ_I:result->i=a<=b;return OP_PUSH_I;
+		case OP_LESSEQ_F:result->i=x<=y;return OP_PUSH_I;
+		case OP_GREATER_I:result->i=a>b;return OP_PUSH_I;
+		case OP_GREATER_F:result->i=x>y;return OP_PUSH_I;
+		case OP_GREATEREQ_I:result->i=a>=b;return OP_PUSH_I;
+		case OP_GREATEREQ_F:result->i=x>=y;return OP_PUSH_I;
+		case OP_EQUAL_I:result->i=a==b;return OP_PUSH_I;
+		case OP_EQUAL_F:result->i=x==y;return OP_PUSH_I;
+		case OP_NOTEQ_I:result->i=a!=b;return OP_PUSH_I;
+		case OP_NOTEQ_F:result->i=x!=y;return OP_PUSH_I;
+		case OP_NEG_I:result->i=wrapNeg(a);return OP_PUSH_I;
+		case OP_NEG_F:result->f=-x;return OP_PUSH_F;
+		case OP_NOT_I:result->i=!a;return OP_PUSH_I;
+		case OP_NOT_F:result->i=!x;return OP_PUSH_I;
+		default:return OP_NOP;
+		}
+	}
+
+static const char *opNames[OP_COUNT]={
+	"HALT","NOP","PUSH_I","PUSH_F","PUSH_A","DROP","FPADDR","FPLOAD","FPSTORE",
+	"LOAD_I","LOAD_F","LOAD_C","LOAD_A","STORE_I","STORE_F","STORE_C","COPY","PUSH_STRUCT","INDEX","OFFSET","CHECK","VSUM_I","VSUM_F","VCOPY",
+	"CONV_I_F","CONV_F_I","CONV_I_C",
+	"ADD_I","ADD_F","SUB_I","SUB_F","MUL_I","MUL_F","DIV_I","DIV_F",
+	"LESS_I","LESS_F","LESSEQ_I","LESSEQ_F","GREATER_I","GREATER_F","GREATEREQ_I","GREATEREQ_F",
+	"EQUAL_I","EQUAL_F","NOTEQ_I","NOTEQ_F",
+	"NEG_I","NEG_F","NOT_I","NOT_F",
+	"JMP","JF","JT","CALL","CALL_EXT","ENTER","RET","RET_VOID",
+	"RLOAD_I","RLOAD_F","RSTORE_I","RSTORE_F"
+	};
+
+const char *opName(Opcode op){
+	return opNames[op];
+	}
+
+// the position of instr in list
+static int instrPos(Instr *list,Instr *instr){
+	int n=0;
+	for(;list&&list!=instr;list=list->next)n++;
+	return n;
+	}
+
+void showInstrArg(Opcode op,InstrArg arg){
+	switch(op){
+		case OP_PUSH_I:case OP_FPADDR:case OP_FPLOAD:case OP_FPSTORE:case OP_COPY:case OP_PUSH_STRUCT:
+		case OP_INDEX:case OP_OFFSET:case OP_CHECK:case OP_VSUM_F:case OP_VCOPY:case OP_ENTER:case OP_RET:case OP_RET_VOID:
+		case OP_RLOAD_I:case OP_RLOAD_F:case OP_RSTORE_I:case OP_RSTORE_F:
+			printf("\t%d",arg.i);
+			break;
+		case OP_PUSH_F:printf("\t%g",arg.f);break;
+		case OP_PUSH_A:printf("\t%p",arg.p);break;
+		case OP_CALL:case OP_CALL_EXT:
+			printf("\t%s",((Symbol*)arg.p)->name);
+			break;
+		default:break;
+		}
+	}
+
+void showInstrs(Instr *list){
+	// the jump targets are shown by their position in list
+	int n=0;
+	for(Instr *i=list;i;i=i->next,n++){
+		printf("\t%d\t%s",n,opName(i->op));
+		if(i->op==OP_JMP||i->op==OP_JF||i->op==OP_JT)printf("\t%d",instrPos(list,i->arg.instr));
+		else showInstrArg(i->op,i->arg);
+		putchar('\n');
+		}
+	}
+
+#define STACK_SIZE (1<<16)
+
+Val stack[STACK_SIZE];
+Val *SP=stack;		// the first free slot on stack
+Val intRegs[VM_INT_REGS];
+double floatRegs[VM_FLOAT_REGS];
+Val *FP;		// the frame pointer: FP[0] is the caller's FP, FP[-1] is the return address
+				// the locals are at FP[1..], the parameters are below the return address
+
+void pushv(Val v){
+	if(SP==stack+STACK_SIZE)err("trying to push into a full stack");
+	*SP++=v;
+	}
+
+Val popv(){
+	if(SP==stack)err("trying to pop from empty stack");
+	return *--SP;
+	}
+
+void pushi(int i){pushv((Val){.i=i});}
+int popi(){return popv().i;}
+void pushd(double d){pushv((Val){.f=d});}
+double popd(){return popv().f;}
+void pusha(void *a){pushv((Val){.p=a});}
+void *popa(){return popv().p;}
+
+// the global data segment
+// the whole segment is reserved at the first allocation, but the operating system commits its pages only when they are used
+// and gives them zero-initialized, like the bss segment of a native program
+// if the address space is limited (ex: ulimit -v), a smaller segment is reserved
+static char *dataSeg;
+static size_t dataSize;
+static size_t dataUsed;
+#ifdef _WIN32
+// Windows commits the pages explicitly: the segment is committed in steps of VM_DATA_COMMIT bytes, as it is used
+#define VM_DATA_COMMIT (1024*1024)
+static size_t dataCommitted;
+#endif
+// serializes vmAllocGlobal, which is called by the threads that compile the units of a program in parallel
+static mtx_t dataLock;
+static once_flag dataLockOnce=ONCE_FLAG_INIT;
+
+static void initDataLock(){
+	if(mtx_init(&dataLock,mtx_plain)!=thrd_success)err("cannot create the data segment lock");
+	}
+
+static void reserveData(){
+	for(dataSize=VM_DATA_SIZE;dataSize>=VM_DATA_SIZE/1024;dataSize/=2){
+#ifdef _WIN32
+		dataSeg=(char*)VirtualAlloc(NULL,dataSize,MEM_RESERVE,PAGE_NOACCESS);
+		if(dataSeg)return;
+#else
+		void *p=mmap(NULL,dataSize,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_NORESERVE,-1,0);
+		if(p!=MAP_FAILED){
+			dataSeg=(char*)p;
+			return;
+			}
+#endif
+		}
+	err("cannot reserve the global data segment");
+	}
+
+static void *allocLocked(int size){
+	if(!dataSeg)reserveData();
+	size_t offset=(dataUsed+sizeof(Val)-1)/sizeof(Val)*sizeof(Val);
+	if((size_t)size>dataSize-offset)err("the global variables need more than %zu bytes",dataSize);
+	dataUsed=offset+size;
+#ifdef _WIN32
+	if(dataUsed>dataCommitted){
+		size_t end=(dataUsed+VM_DATA_COMMIT-1)/VM_DATA_COMMIT*VM_DATA_COMMIT;
+		if(end>dataSize)end=dataSize;
+		if(!VirtualAlloc(dataSeg+dataCommitted,end-dataCommitted,MEM_COMMIT,PAGE_READWRITE))err("cannot commit the global data segment");
+		dataCommitted=end;
+		}
+#endif
+	return dataSeg+offset;
+	}
+
+void *vmAllocGlobal(int size){
+	call_once(&dataLockOnce,initDataLock);
+	mtx_lock(&dataLock);
+	void *p=allocLocked(size);
+	mtx_unlock(&dataLock);
+	return p;
+	}
+
+size_t vmGlobalsSize(){
+	return dataUsed;
+	}
+
+void vmFreeGlobals(){
+	if(!dataSeg)return;
+#ifdef _WIN32
+	VirtualFree(dataSeg,0,MEM_RELEASE);
+	dataCommitted=0;
+#else
+	munmap(dataSeg,dataSize);
+#endif
+	dataSeg=NULL;
+	dataUsed=0;
+	}
+
+void vmInit(){
+	rtAddBuiltins();
+	}
+
+// copies the n bytes of a struct
+// memcpy with a variable size is a call, so the small structs are copied with fixed-size moves, which can overlap:
+// all the bytes are read before they are written
+// the structs are packed, so their members can be at any address: the memory is accessed with memcpy
+static inline int loadInt(const void *p){
+	int v;
+	memcpy(&v,p,sizeof(v));
+	return v;
+	}
+
+static inline double loadDouble(const void *p){
+	double v;
+	memcpy(&v,p,sizeof(v));
+	return v;
+	}
+
+static inline void *loadAddr(const void *p){
+	void *v;
+	memcpy(&v,p,sizeof(v));
+	return v;
+	}
+
+static inline void copyStruct(char *dst,const char *src,int n){
+	uint64_t a,b,c,d;
+	if(n>=8&&n<=16){
+		memcpy(&a,src,8);
+		memcpy(&b,src+n-8,8);
+		memcpy(dst,&a,8);
+		memcpy(dst+n-8,&b,8);
+		}else if(n>16&&n<=32){
+		memcpy(&a,src,8);
+		memcpy(&b,src+8,8);
+		memcpy(&c,src+n-16,8);
+		memcpy(&d,src+n-8,8);
+		memcpy(dst,&a,8);
+		memcpy(dst+8,&b,8);
+		memcpy(dst+n-16,&c,8);
+		memcpy(dst+n-8,&d,8);
+		}else if(n>=4&&n<8){
+		uint32_t x,y;
+		memcpy(&x,src,4);
+		memcpy(&y,src+n-4,4);
+		memcpy(dst,&x,4);
+		memcpy(dst+n-4,&y,4);
+		}else{
+		memmove(dst,src,n);
+		}
+	}
+
+#ifdef VM_COUNT_OPS
+// built with -DVM_COUNT_OPS, run counts the executed instructions by opcode and writes them to stderr when the program ends
+// it is used by the benchmarks (bench/run.sh), to compare the code generated by different revisions
+static long long opCounts[OP_COUNT];
+
+static void showOpCounts(){
+	long long total=0;
+	for(int op=0;op<OP_COUNT;op++){
+		if(opCounts[op])fprintf(stderr,"%s\t%lld\n",opNames[op],opCounts[op]);
+		total+=opCounts[op];
+		}
+	fprintf(stderr,"total\t%lld\n",total);
+	}
+#endif
+
+void run(Instr *IP){
+	Val v;
+	int iArg,iTop;
+	double fTop;
+	void *aTop;
+	char *a;
+	Instr *ret;
+	Val *oldFP;
+	Symbol *fn;
+	bool prof=profEnabled;
+	for(;;){
+		if(prof)profInstr(IP);
+#ifdef VM_COUNT_OPS
+		opCounts[IP->op]++;
+#endif
+		switch(IP->op){
+			case OP_HALT:
+				rtFlush();
+#ifdef VM_COUNT_OPS
+				showOpCounts();
+#endif
+				return;
+			case OP_NOP:IP=IP->next;break;
+			case OP_PUSH_I:pushi(IP->arg.i);IP=IP->next;break;
+			case OP_PUSH_F:pushd(IP->arg.f);IP=IP->next;break;
+			case OP_PUSH_A:pusha(IP->arg.p);IP=IP->next;break;
+			case OP_DROP:popv();IP=IP->next;break;
+			case OP_FPADDR:pusha(FP+IP->arg.i);IP=IP->next;break;
+			case OP_FPLOAD:pushv(FP[IP->arg.i]);IP=IP->next;break;
+			case OP_FPSTORE:
+				if(SP==stack)err("trying to pop from empty stack");
+				FP[IP->arg.i]=SP[-1];
+				IP=IP->next;break;
+			case OP_LOAD_I:pushi(loadInt(popa()));IP=IP->next;break;
+			case OP_LOAD_F:pushd(loadDouble(popa()));IP=IP->next;break;
+			case OP_LOAD_C:pushi(*(char*)popa());IP=IP->next;break;
+			case OP_LOAD_A:pusha(loadAddr(popa()));IP=IP->next;break;
+			case OP_STORE_I:
+				iTop=popi();
+				memcpy(popa(),&iTop,sizeof(iTop));
+				pushi(iTop);
+				IP=IP->next;break;
+			case OP_STORE_F:
+				fTop=popd();
+				memcpy(popa(),&fTop,sizeof(fTop));
+				pushd(fTop);
+				IP=IP->next;break;
+			case OP_STORE_C:
+				iTop=popi();
+				*(char*)popa()=(char)iTop;
+				pushi((char)iTop);
+				IP=IP->next;break;
+			case OP_COPY:
+				aTop=popa();
+				a=(char*)popa();
+				copyStruct(a,aTop,IP->arg.i);
+				pusha(a);
+				IP=IP->next;break;
+			case OP_PUSH_STRUCT:
+				iArg=(IP->arg.i+(int)sizeof(Val)-1)/(int)sizeof(Val);
+				aTop=popa();
+				if(SP+iArg>stack+STACK_SIZE)err("trying to push into a full stack");
+				copyStruct((char*)SP,aTop,IP->arg.i);
+				SP+=iArg;
+				IP=IP->next;break;
+			case OP_INDEX:
+				iTop=popi();
+				a=(char*)popa();
+				pusha(a+(size_t)iTop*IP->arg.i);
+				IP=IP->next;break;
+			case OP_OFFSET:
+				pusha((char*)popa()+IP->arg.i);
+				IP=IP->next;break;
+			case OP_CHECK:
+				if(SP==stack)err("trying to pop from empty stack");
+				if((unsigned)SP[-1].i>=(unsigned)IP->arg.i){
+					char where[256];
+					vmLineName(IP->line,where,sizeof(where));
+					err("the index %d is out of the bounds of an array with %d elements (%s)",SP[-1].i,IP->arg.i,where);
+					}
+				IP=IP->next;break;
+			// iTop is the first index and iArg is the end index
+			case OP_VSUM_I:
+				v.i=popi();
+				iArg=popi();
+				iTop=popi();
+				pushi(vecSumI((char*)popa()+(size_t)iTop*sizeof(int),iArg-iTop,v.i));
+				IP=IP->next;break;
+			case OP_VSUM_F:
+				fTop=popd();
+				iArg=popi();
+				iTop=popi();
+				pushd(vecSumF((char*)popa()+(size_t)iTop*sizeof(double),iArg-iTop,fTop,IP->arg.i));
+				IP=IP->next;break;
+			case OP_VCOPY:
+				iArg=popi();
+				iTop=popi();
+				aTop=popa();
+				a=(char*)popa();
+				vecCopy(a+(size_t)iTop*IP->arg.i,(char*)aTop+(size_t)iTop*IP->arg.i,iArg-iTop,IP->arg.i);
+				IP=IP->next;break;
+			case OP_CONV_I_F:pushd(popi());IP=IP->next;break;
+			case OP_CONV_F_I:pushi((int)popd());IP=IP->next;break;
+			case OP_CONV_I_C:pushi((char)popi());IP=IP->next;break;
+#define BINARY_I(opcode,expr) case opcode:iTop=popi();iArg=popi();pushi(expr);IP=IP->next;break;
+#define BINARY_F(opcode,expr,push) case opcode:fTop=popd();v.f=popd();push(expr);IP=IP->next;break;
+			BINARY_I(OP_ADD_I,wrapAdd(iArg,iTop))
+			BINARY_F(OP_ADD_F,v.f+fTop,pushd)
+			BINARY_I(OP_SUB_I,wrapSub(iArg,iTop))
+			BINARY_F(OP_SUB_F,v.f-fTop,pushd)
+			BINARY_I(OP_MUL_I,wrapMul(iArg,iTop))
+			BINARY_F(OP_MUL_F,v.f*fTop,pushd)
+			case OP_DIV_I:
+				iTop=popi();
+				iArg=popi();
+				if(!iTop)err("division by zero");
+				pushi(wrapDiv(iArg,iTop));
+				IP=IP->next;break;
+			BINARY_F(OP_DIV_F,v.f/fTop,pushd)
+			BINARY_I(OP_LESS_I,iArg<iTop)
+			BINARY_F(OP_LESS_F,v.f<fTop,pushi)
+			BINARY_I(OP_LESSEQ_I,iArg<=iTop)
+			BINARY_F(OP_LESSEQ_F,v.f<=fTop,pushi)
+			BINARY_I(OP_GREATER_I,iArg>iTop)
+			BINARY_F(OP_GREATER_F,v.f>fTop,pushi)
+			BINARY_I(OP_GREATEREQ_I,iArg>=iTop)
+			BINARY_F(OP_GREATEREQ_F,v.f>=fTop,pushi)
+			BINARY_I(OP_EQUAL_I,iArg==iTop)
+			BINARY_F(OP_EQUAL_F,v.f==fTop,pushi)
+			BINARY_I(OP_NOTEQ_I,iArg!=iTop)
+			BINARY_F(OP_NOTEQ_F,v.f!=fTop,pushi)
+#undef BINARY_I
+#undef BINARY_F
+			case OP_NEG_I:pushi(wrapNeg(popi()));IP=IP->next;break;
+			case OP_NEG_F:pushd(-popd());IP=IP->next;break;
+			case OP_NOT_I:pushi(!popi());IP=IP->next;break;
+			case OP_NOT_F:pushi(!popd());IP=IP->next;break;
+			case OP_JMP:
+				if(prof)profJump(IP);
+				IP=IP->arg.instr;break;
+			case OP_JF:
+				if(popi()){
+					IP=IP->next;
+					}else{
+					if(prof)profJump(IP);
+					IP=IP->arg.instr;
+					}
+				break;
+			case OP_JT:
+				if(popi()){
+					if(prof)profJump(IP);
+					IP=IP->arg.instr;
+					}else{
+					IP=IP->next;
+					}
+				break;
+			case OP_CALL:
+				fn=(Symbol*)IP->arg.p;
+				if(prof)profCall(fn);
+				pusha(IP->next);
+				IP=fn->fn.instr;
+				break;
+			case OP_CALL_EXT:
+				fn=(Symbol*)IP->arg.p;
+				if(prof){
+					// the time spent in fn is attributed to its own calls path
+					profCall(fn);
+					fn->fn.extFnPtr();
+					profReturn(IP);
+					}else{
+					fn->fn.extFnPtr();
+					}
+				IP=IP->next;break;
+			case OP_ENTER:
+				pusha(FP);
+				FP=SP-1;
+				if(SP+IP->arg.i>stack+STACK_SIZE)err("trying to push into a full stack");
+				SP+=IP->arg.i;
+				IP=IP->next;break;
+			case OP_RET:
+				v=popv();
+				ret=(Instr*)FP[-1].p;
+				oldFP=(Val*)FP[0].p;
+				SP=FP-1-IP->arg.i;
+				FP=oldFP;
+				if(prof)profReturn(IP);
+				IP=ret;
+				pushv(v);
+				break;
+			case OP_RET_VOID:
+				ret=(Instr*)FP[-1].p;
+				oldFP=(Val*)FP[0].p;
+				SP=FP-1-IP->arg.i;
+				FP=oldFP;
+				if(prof)profReturn(IP);
+				IP=ret;
+				break;
+			case OP_RLOAD_I:pushv(intRegs[IP->arg.i]);IP=IP->next;break;
+			case OP_RLOAD_F:pushd(floatRegs[IP->arg.i]);IP=IP->next;break;
+			case OP_RSTORE_I:
+				if(SP==stack)err("trying to pop from empty stack");
+				intRegs[IP->arg.i]=SP[-1];
+				IP=IP->next;break;
+			case OP_RSTORE_F:
+				if(SP==stack)err("trying to pop from empty stack");
+				floatRegs[IP->arg.i]=SP[-1].f;
+				IP=IP->next;break;
+			default:err("run: instruction not implemented: %d",IP->op);
+			}
+		}
+	}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <stddef.h>
+
+// the virtual machine
+// it is a stack machine: the instructions take their operands from the top of the stack and push back the results
+// the notation [a,b] -> [c] means that the instruction pops b, then a, and pushes c
+
+#define VM_INT_REGS 8		// the registers for int, char and addresses
+#define VM_FLOAT_REGS 8		// the registers for double
+
+typedef union{
+	int i;		// int and char values
+	double f;		// double values
+	void *p;		// addresses
+	}Val;
+
+typedef enum{
+	OP_HALT,		// stops the execution
+	OP_NOP,		// does nothing; it is used as jump target
+	OP_PUSH_I,OP_PUSH_F,OP_PUSH_A,		// [] -> [arg] pushes a constant
+	OP_DROP,		// [v] -> []
+	OP_FPADDR,		// [] -> [&FP[arg.i]] the address of a local variable or parameter
+	OP_FPLOAD,		// [] -> [FP[arg.i]] the value of a scalar local variable or parameter
+	OP_FPSTORE,		// [v] -> [v] FP[arg.i]=v
+	OP_LOAD_I,OP_LOAD_F,OP_LOAD_C,OP_LOAD_A,		// [a] -> [*a]
+	OP_STORE_I,OP_STORE_F,OP_STORE_C,		// [a,v] -> [v] *a=v
+	OP_COPY,		// [dst,src] -> [dst] copies arg.i bytes (struct assignment)
+	OP_PUSH_STRUCT,		// [a] -> [slots] pushes a copy of the arg.i bytes from a (struct arguments)
+	OP_INDEX,		// [a,i] -> [a+i*arg.i]
+	OP_OFFSET,		// [a] -> [a+arg.i]
+	OP_CHECK,		// [i] -> [i] stops the program if the index i is not in [0,arg.i) (the bounds check of an array with arg.i elements)
+	// the vector operations, generated only by the IR vectorizer from the loops over the indexes i<=k<n
+	OP_VSUM_I,		// [a,i,n,r] -> [r+a[i]+...+a[n-1]] for an int array
+	OP_VSUM_F,		// [a,i,n,r] -> [r+a[i]+...+a[n-1]] for a double array; the additions are reassociated if arg.i is 1
+	OP_VCOPY,		// [d,s,i,n] -> [] d[k]=s[k] for elements of arg.i bytes
+	OP_CONV_I_F,OP_CONV_F_I,OP_CONV_I_C,		// [v] -> [converted v]
+	// the arithmetic and comparison operators: [a,b] -> [a op b]
+	// each int operator is followed by its double version, so OP_X_F==OP_X_I+1
+	// the comparisons always return an int: 1 for true or 0 for false
+	OP_ADD_I,OP_ADD_F,OP_SUB_I,OP_SUB_F,OP_MUL_I,OP_MUL_F,OP_DIV_I,OP_DIV_F,
+	OP_LESS_I,OP_LESS_F,OP_LESSEQ_I,OP_LESSEQ_F,OP_GREATER_I,OP_GREATER_F,OP_GREATEREQ_I,OP_GREATEREQ_F,
+	OP_EQUAL_I,OP_EQUAL_F,OP_NOTEQ_I,OP_NOTEQ_F,
+	OP_NEG_I,OP_NEG_F,		// [a] -> [-a]
+	OP_NOT_I,OP_NOT_F,		// [a] -> [!a] (always an int)
+	OP_JMP,		// jumps to arg.instr
+	OP_JF,OP_JT,		// [c] -> [] jumps to arg.instr if the int c is false (0) / true (not 0)
+	OP_CALL,		// calls the function arg.p (a Symbol*)
+	OP_CALL_EXT,		// calls the extern function arg.p (a Symbol*)
+	OP_ENTER,		// creates the function frame, with arg.i slots for the local variables
+	OP_RET,		// [v] -> [] returns v from a function which has arg.i slots of parameters
+	OP_RET_VOID,		// returns from a void function which has arg.i slots of parameters
+	// the registers, allocated by irToVm
+	// they are callee-saved: a function which uses a register saves it in its frame and restores it before returning
+	OP_RLOAD_I,OP_RLOAD_F,		// [] -> [R[arg.i]] loads an int register (int, char or address) or a double register
+	OP_RSTORE_I,OP_RSTORE_F,		// [v] -> [v] R[arg.i]=v
+	OP_COUNT		// the number of opcodes
+	}Opcode;
+
+typedef union{
+	int i;
+	double f;
+	void *p;
+	struct Instr *instr;		// the jump target
+	}InstrArg;
+
+typedef struct Instr{
+	Opcode op;
+	int line;		// the source line from which the instruction was generated, or 0 if it is not known (used by the profiler)
+	InstrArg arg;
+	struct Instr *next;		// the next instruction in list
+	}Instr;
+
+// allocates a new instruction, which is not in any list
+Instr *newInstr(Opcode op);
+// adds an instruction at the end of the list and returns it
+Instr *addInstr(Instr **list,Opcode op);
+Instr *addInstrWithInt(Instr **list,Opcode op,int argVal);
+Instr *addInstrWithDouble(Instr **list,Opcode op,double argVal);
+Instr *addInstrWithPtr(Instr **list,Opcode op,void *argVal);
+// inserts an instruction after the given one and returns it
+// the new instruction gets the line of the given one
+Instr *insertInstr(Instr *after,Opcode op);
+// deletes all the instructions after the given one
+void delInstrAfter(Instr *instr);
+// frees all the instructions from list
+void freeInstrs(Instr *list);
+// the number of the instructions from list
+int instrsLen(Instr *list);
+
+// a map from the instructions of a list to their position in list
+typedef struct{
+	Instr **instrs;		// the instructions, in their list order
+	int n;		// the number of instructions
+	Instr **keys;		// hash table with linear probing from the instructions' addresses to their position
+	int *pos;
+	int cap;
+	}InstrIndex;
+
+void initInstrIndex(InstrIndex *index,Instr *list);
+// the position of instr, which must be in the indexed list
+int instrIndex(InstrIndex *index,Instr *instr);
+void freeInstrIndex(InstrIndex *index);
+
+// computes at compile time the result of a pure operation (conversion, arithmetic, comparison, negation)
+// args are the operands in the order in which they are pushed on stack
+// returns the PUSH opcode for the result (OP_PUSH_I or OP_PUSH_F) or OP_NOP if op cannot be computed (ex: division by 0)
+Opcode vmEval(Opcode op,const Val *args,Val *result);
+
+// the name of an opcode (ex: "PUSH_I")
+const char *opName(Opcode op);
+// shows the argument of an instruction with the opcode op, if it has one (ex: "\t5")
+// the jump targets are not shown, because they depend on the list
+void showInstrArg(Opcode op,InstrArg arg);
+// shows the instructions from list, one per line
+void showInstrs(Instr *list);
+
+// the operations on the VM stack, used by the extern functions to get their arguments and to return their results
+void pushi(int i);
+int popi();
+void pushd(double d);
+double popd();
+void pusha(void *a);
+void *popa();
+
+// the global variables are allocated in a single data segment, which is reserved with this size
+// it is only address space: the pages are committed as they are used (64 GB, or 512 MB for 32-bit addresses)
+#define VM_DATA_SIZE ((size_t)1<<(sizeof(void*)>4?36:29))
+
+// allocates size bytes for a global variable, aligned for any value
+// the memory is zero-initialized
+// it can be called concurrently
+void *vmAllocGlobal(int size);
+// the number of bytes used by the global variables
+size_t vmGlobalsSize();
+// releases the memory of all the global variables
+void vmFreeGlobals();
+
+// adds the builtin functions to the current domain
+void vmInit();
+// formats a line of the code for the errors of the running program (ex: "line 12")
+// the linker changes it for a program with several units, whose lines are numbered across the units (see Unit.firstLine)
+extern void (*vmLineName)(int line,char *buf,size_t size);
+
+// executes the code starting with IP, until OP_HALT
+// if the profiler is enabled (profStart), it also updates the profile
+void run(Instr *IP);